@@ -0,0 +1,34 @@
+#pragma once
+
+/// System includes
+# include <cstddef>
+# include <functional>
+# include <string>
+# include <vector>
+
+/// Declare a benchmark case, run by GameEngineBench in the order of declaration within a file
+# define GE_BENCH(name) \
+	static void	name(); \
+	static const ::GE::Bench::Registrar	name##Registrar(#name, name); \
+	static void	name()
+
+namespace GE::Bench {
+
+	/// @brief A benchmark case, see GE_BENCH()
+	struct Case {
+		const char *	name;
+		void			(*run)();
+	};
+
+	/// @brief Adds a case to cases() during static initialization
+	struct Registrar {
+		Registrar(const char *name, void (*run)());
+	};
+
+	std::vector<Case> &	cases();
+
+	double	time(const std::function<void()> &func, double minTime = 250.0);
+	void	report(const std::string &label, double milliseconds, const std::string &detail = "");
+	void	fail(const std::string &message);
+
+} // namespace GE::Bench
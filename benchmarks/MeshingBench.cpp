@@ -0,0 +1,113 @@
+#include "Bench.hpp"
+
+/// Includes
+# include "Objects/VoxelChunk.hpp"
+# include "Utils/FractalNoise.hpp"
+# include "Utils/NoiseGenerator.hpp"
+# include "Utils/ThreadPool.hpp"
+
+/// System includes
+# include <algorithm>
+# include <cstdio>
+# include <cstring>
+# include <string>
+# include <thread>
+# include <vector>
+
+using GE::Objects::VoxelChunk;
+using GE::Objects::VoxelMesh;
+using GE::Objects::VoxelType;
+using GE::Objects::VoxelVertex;
+using GE::Utils::FractalInfo;
+using GE::Utils::FractalNoise;
+using GE::Utils::NoiseGenerator;
+using GE::Utils::ThreadPool;
+
+// Terrain of VoxelWorld::_generate() with the VoxelWorldInfo defaults
+static void	fillChunk(VoxelChunk &chunk, const NoiseGenerator &noise, const FractalNoise &terrain) {
+	const float			baseHeight = 48.0f, terrainHeight = 40.0f, seaLevel = 44.0f;
+	const float			caveFrequency = 1.0f / 32.0f, caveThreshold = 0.45f;
+	const int			padded = VoxelChunk::PADDED_SIZE;
+	const glm::ivec3	origin = chunk.getPosition() * VoxelChunk::SIZE - 1;
+
+	std::vector<float>	heights((size_t)padded * padded);
+	terrain.sample2DGrid(heights.data(), {(float)origin.x, (float)origin.z}, {1, 1}, glm::uvec2(padded));
+
+	for (int z = 0; z < padded; z++) {
+		for (int x = 0; x < padded; x++) {
+			const float	height = baseHeight + heights[z * padded + x] * terrainHeight;
+			const bool	shore = height <= seaLevel + 1;
+
+			for (int y = 0; y < padded; y++) {
+				const glm::ivec3	voxel = origin + glm::ivec3{x, y, z};
+				const float			depth = height - (float)voxel.y;
+
+				if (depth <= 0)
+					break;
+				if (voxel.y > 0 && noise.perlin3D(glm::vec3(voxel) * caveFrequency) > caveThreshold)
+					continue;
+
+				VoxelType	type = VoxelType::STONE;
+				if (depth <= 1)
+					type = shore ? VoxelType::SAND : VoxelType::GRASS;
+				else if (depth <= 4)
+					type = shore ? VoxelType::SAND : VoxelType::DIRT;
+
+				chunk.setVoxel({x - 1, y - 1, z - 1}, type);
+			}
+		}
+	}
+}
+
+// Greedy meshing of a fixed set of terrain chunks, on one worker then on one per hardware thread
+GE_BENCH(voxelChunkMeshing) {
+	const NoiseGenerator	noise(42);
+	const FractalNoise		terrain(noise, FractalInfo{6, 1.0f / 256.0f});
+
+	std::vector<VoxelChunk>	chunks;
+	for (int z = 0; z < 6; z++)
+		for (int x = 0; x < 6; x++)
+			for (int y = 0; y < 4; y++) {
+				VoxelChunk	chunk({x, y, z});
+
+				fillChunk(chunk, noise, terrain);
+				if (!chunk.isEmpty())
+					chunks.push_back(std::move(chunk));
+			}
+
+	const size_t			hardware = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<size_t>		workerCounts = {1};
+	std::vector<VoxelMesh>	reference(chunks.size());
+	std::vector<VoxelMesh>	meshes(chunks.size());
+
+	if (hardware > 1)
+		workerCounts.push_back(hardware);
+
+	for (size_t workers : workerCounts) {
+		std::vector<VoxelMesh> &	out = (workers == 1) ? reference : meshes;
+		ThreadPool					pool(workers);
+
+		const double	elapsed = GE::Bench::time([&]() {
+			for (size_t i = 0; i < chunks.size(); i++)
+				pool.submit([&chunks, &out, i]() { chunks[i].buildMesh(out[i]); });
+			pool.wait();
+		});
+		const double	perSecond = chunks.size() * 1000.0 / elapsed;
+
+		char	detail[128];
+		std::snprintf(detail, sizeof(detail), "%.0f chunks/s, %.0f chunks/s/core", perSecond, perSecond / workers);
+		GE::Bench::report(std::to_string(chunks.size()) + " chunks on " + std::to_string(workers) + " workers", elapsed, detail);
+	}
+
+	size_t	quads = 0;
+	for (size_t i = 0; i < chunks.size(); i++) {
+		const VoxelMesh &	expected = reference[i];
+		const VoxelMesh &	mesh = (workerCounts.size() > 1) ? meshes[i] : reference[i];
+
+		if (mesh.indices != expected.indices || mesh.vertices.size() != expected.vertices.size()
+			|| (!mesh.vertices.empty() && std::memcmp(mesh.vertices.data(), expected.vertices.data(), mesh.vertices.size() * sizeof(VoxelVertex))))
+			GE::Bench::fail("chunk " + std::to_string(i) + " meshes differently on several workers");
+		quads += expected.indices.size() / 6;
+	}
+	std::printf("  %zu quads per pass\n", quads);
+}
@@ -0,0 +1,125 @@
+#include "Bench.hpp"
+
+/// Includes
+# include "OpenCL/NoiseGeneratorCL.hpp"
+# include "Utils/FractalNoise.hpp"
+# include "Utils/NoiseGenerator.hpp"
+
+/// System includes
+# include <algorithm>
+# include <cmath>
+# include <cstdio>
+# include <memory>
+# include <stdexcept>
+# include <string>
+# include <vector>
+
+using GE::OpenCL::ContextCL;
+using GE::OpenCL::ContextCLInfo;
+using GE::OpenCL::NoiseGeneratorCL;
+using GE::Utils::FractalInfo;
+using GE::Utils::FractalNoise;
+using GE::Utils::NoiseGenerator;
+
+// Error of the functions NoiseGeneratorCL documents as bit-exact : fast-math lets the host reorder its side
+# ifdef __FAST_MATH__
+static const float	exactTolerance = 1e-5f;
+# else
+static const float	exactTolerance = 0.0f;
+# endif
+
+// Time the CPU path and its OpenCL port on the same samples, and check the error against the documented tolerance
+static void	compare(
+	const std::string &label,
+	size_t samples,
+	float tolerance,
+	const std::function<void(float *)> &cpu,
+	const std::function<void(float *)> &cl
+) {
+	std::vector<float>	reference(samples);
+	std::vector<float>	result(samples);
+
+	const double	cpuTime = GE::Bench::time([&]() { cpu(reference.data()); });
+	const double	clTime = GE::Bench::time([&]() { cl(result.data()); });
+
+	float	error = 0;
+	for (size_t i = 0; i < samples; i++)
+		error = std::max(error, std::abs(result[i] - reference[i]));
+
+	char	detail[128];
+	std::snprintf(detail, sizeof(detail), "x%.2f, max error %g (tolerance %g)", cpuTime / clTime, error, tolerance);
+	GE::Bench::report(label + " CPU", cpuTime);
+	GE::Bench::report(label + " OpenCL", clTime, detail);
+
+	if (error > tolerance)
+		GE::Bench::fail(label + " differs from the CPU by " + std::to_string(error));
+}
+
+// NoiseGeneratorCL on the OpenCL CPU device (PoCL) against the CPU functions it ports
+GE_BENCH(noiseGeneratorCL) {
+	std::unique_ptr<ContextCL>	context;
+
+	try {
+		context = std::make_unique<ContextCL>(ContextCLInfo{CL_DEVICE_TYPE_CPU, false, false});
+	}
+	catch (const std::runtime_error &e) {
+		std::printf("  %-32s %s\n", "no OpenCL CPU device", e.what());
+		return;
+	}
+	std::printf("  device : %s\n", context->getDevice().getInfo<CL_DEVICE_NAME>().c_str());
+
+	NoiseGeneratorCL		noiseCL(*context);
+	const NoiseGenerator	noise(42);
+	const NoiseGenerator	legacy(42, NoiseGenerator::Perlin3DMode::LEGACY_COMPOSITE);
+
+	const glm::uvec2	grid(512, 512);
+	const glm::uvec3	volume(64, 64, 64);
+	const glm::vec3		origin(-37.25f, 12.5f, 3.75f);
+	const glm::vec3		step(1.0f / 8.0f);
+	const size_t		gridSamples = (size_t)grid.x * grid.y;
+	const size_t		volumeSamples = (size_t)volume.x * volume.y * volume.z;
+
+	// Samples of a CPU point function over the volume, in the order of NoiseGeneratorCL
+	const auto	fillVolume = [&](float *out, const std::function<float(const glm::vec3 &)> &sample) {
+		for (unsigned z = 0; z < volume.z; z++)
+			for (unsigned y = 0; y < volume.y; y++)
+				for (unsigned x = 0; x < volume.x; x++)
+					*out++ = sample(origin + glm::vec3{(float)x, (float)y, (float)z} * step);
+	};
+
+	compare("perlin2D", gridSamples, 1e-5f,
+		[&](float *out) { noise.perlin2DGrid(out, {origin.x, origin.y}, {step.x, step.y}, grid); },
+		[&](float *out) { noiseCL.fill(out, noise, NoiseGeneratorCL::Function::PERLIN2D, origin, step, {grid, 1}); });
+
+	compare("simplex2D", gridSamples, exactTolerance,
+		[&](float *out) {
+			for (unsigned y = 0; y < grid.y; y++)
+				for (unsigned x = 0; x < grid.x; x++)
+					*out++ = noise.simplex2D({origin.x + (float)x * step.x, origin.y + (float)y * step.y});
+		},
+		[&](float *out) { noiseCL.fill(out, noise, NoiseGeneratorCL::Function::SIMPLEX2D, origin, step, {grid, 1}); });
+
+	compare("perlin3D GRADIENT", volumeSamples, exactTolerance,
+		[&](float *out) { fillVolume(out, [&](const glm::vec3 &v) { return noise.perlin3D(v); }); },
+		[&](float *out) { noiseCL.fill(out, noise, NoiseGeneratorCL::Function::PERLIN3D, origin, step, volume); });
+
+	compare("perlin3D LEGACY_COMPOSITE", volumeSamples, 1e-5f,
+		[&](float *out) { fillVolume(out, [&](const glm::vec3 &v) { return legacy.perlin3D(v); }); },
+		[&](float *out) { noiseCL.fill(out, legacy, NoiseGeneratorCL::Function::PERLIN3D, origin, step, volume); });
+
+	compare("simplex3D", volumeSamples, exactTolerance,
+		[&](float *out) { fillVolume(out, [&](const glm::vec3 &v) { return noise.simplex3D(v); }); },
+		[&](float *out) { noiseCL.fill(out, noise, NoiseGeneratorCL::Function::SIMPLEX3D, origin, step, volume); });
+
+	const FractalNoise	terrain(noise, FractalInfo{6, 1.0f / 256.0f});
+	const FractalNoise	caves(noise, FractalInfo{4, 1.0f / 32.0f}, FractalNoise::Type::RIDGED, FractalNoise::Basis::SIMPLEX);
+	const glm::vec2		terrainOrigin(1024.0f, -512.0f);
+
+	compare("fractal2D FBM perlin", gridSamples, 1e-4f,
+		[&](float *out) { terrain.sample2DGrid(out, terrainOrigin, {1.0f, 1.0f}, grid); },
+		[&](float *out) { noiseCL.fillFractal2D(out, terrain, terrainOrigin, {1.0f, 1.0f}, grid); });
+
+	compare("fractal3D RIDGED simplex", volumeSamples, 1e-4f,
+		[&](float *out) { fillVolume(out, [&](const glm::vec3 &v) { return caves.sample3D(v); }); },
+		[&](float *out) { noiseCL.fillFractal3D(out, caves, origin, step, volume); });
+}
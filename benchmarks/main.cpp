@@ -0,0 +1,76 @@
+#include "Bench.hpp"
+
+/// System includes
+# include <algorithm>
+# include <chrono>
+# include <cstdio>
+# include <cstring>
+# include <stdexcept>
+
+namespace GE::Bench {
+
+	Registrar::Registrar(const char *name, void (*run)()) {
+		cases().push_back({name, run});
+	}
+
+	/// @brief Return the registered cases
+	std::vector<Case> &	cases() {
+		static std::vector<Case>	registered;
+		return registered;
+	}
+
+	/// @brief Run a function repeatedly, for at least minTime milliseconds and 5 runs
+	/// @return The fastest run in milliseconds, the least disturbed by the rest of the system
+	double	time(const std::function<void()> &func, double minTime) {
+		using Clock = std::chrono::steady_clock;
+
+		double	best = 0;
+		double	total = 0;
+
+		func();	// Warm up caches and lazy initializations
+		for (size_t runs = 0; runs < 5 || total < minTime; runs++) {
+			const Clock::time_point	start = Clock::now();
+			func();
+			const double	elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+			best = runs ? std::min(best, elapsed) : elapsed;
+			total += elapsed;
+		}
+		return best;
+	}
+
+	/// @brief Print a timing line
+	void	report(const std::string &label, double milliseconds, const std::string &detail) {
+		std::printf("  %-32s %10.3f ms  %s\n", label.c_str(), milliseconds, detail.c_str());
+	}
+
+	/// @brief Stop the case, a result is wrong
+	/// @throw std::runtime_error always
+	void	fail(const std::string &message) {
+		throw std::runtime_error(message);
+	}
+
+} // namespace GE::Bench
+
+/// Usage : GameEngineBench [case...], runs the cases whose name contains one of the arguments, all of them by default
+int	main(int argc, char **argv) {
+	int	failed = 0;
+
+	for (const GE::Bench::Case &bench : GE::Bench::cases()) {
+		bool	selected = argc < 2;
+		for (int i = 1; i < argc; i++)
+			selected |= std::strstr(bench.name, argv[i]) != nullptr;
+		if (!selected)
+			continue;
+
+		std::printf("%s\n", bench.name);
+		try {
+			bench.run();
+		}
+		catch (const std::exception &e) {
+			std::printf("  FAILED : %s\n", e.what());
+			failed++;
+		}
+	}
+	return failed ? 1 : 0;
+}
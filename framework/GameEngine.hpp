@@ -8,6 +8,7 @@
 /// These includes are always needed to correctly use the framework.
 /// They provide essential functionalities for other modules, such as logging and singleton pattern.
 # include "core/Logger.hpp"
+# include "core/Profiler.hpp"
 # include "core/Singleton.hpp"
 
 
@@ -16,17 +17,45 @@
 # include "classes/Objects/ParticleSystem.hpp"
 # include "classes/Objects/SkyBox.hpp"
 # include "classes/Objects/Camera.hpp"
+# include "classes/Objects/VoxelChunk.hpp"
+# include "classes/Objects/PackedVoxelChunk.hpp"
+# include "classes/Objects/VoxelRegionStore.hpp"
+# include "classes/Objects/VoxelWorld.hpp"
 
 
 /// OpenGL includes
 /// These includes provide access to OpenGL functionalities, such as shaders and window management.
+# include "classes/OpenGL/StateCacheGL.hpp"
 # include "classes/OpenGL/Shader.hpp"
 # include "classes/OpenGL/Window.hpp"
 # include "classes/OpenGL/BufferGL.hpp"
 # include "classes/OpenGL/PMapBufferGL.hpp"
+# include "classes/OpenGL/StreamBufferGL.hpp"
+# include "classes/OpenGL/MeshHeapGL.hpp"
+# include "classes/OpenGL/BufferBlockWriter.hpp"
+# include "classes/OpenGL/FrameConstantsGL.hpp"
+# include "classes/OpenGL/ProgramCacheGL.hpp"
+# include "classes/OpenGL/ShaderPreprocessor.hpp"
+# include "classes/OpenGL/ShaderCompiler.hpp"
+# include "classes/OpenGL/ShaderVariants.hpp"
+# include "classes/OpenGL/TimerQueryGL.hpp"
+
+
+/// OpenCL includes
+/// These includes provide access to OpenCL compute, such as the shared context and GPU noise generation.
+# include "classes/OpenCL/ContextCL.hpp"
+# include "classes/OpenCL/NoiseGeneratorCL.hpp"
+# include "classes/OpenCL/KernelTimerCL.hpp"
 
 
 /// Utils includes
 /// These includes provide access to various utility functions and classes.
 # include "Utils/PriorityMutex.hpp"
-# include "Utils/NoiseGenerator.hpp"
\ No newline at end of file
+# include "Utils/NoiseGenerator.hpp"
+# include "Utils/FractalNoise.hpp"
+# include "Utils/ThreadPool.hpp"
+# include "Utils/TerrainField.hpp"
+# include "Utils/IsoSurfaceExtractor.hpp"
+# include "Utils/TLSFAllocator.hpp"
+# include "Utils/FileWatcher.hpp"
+# include "Utils/FrameStats.hpp"
\ No newline at end of file
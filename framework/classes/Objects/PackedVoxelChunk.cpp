@@ -0,0 +1,267 @@
+#include "PackedVoxelChunk.hpp"
+
+/// System includes
+# include <cstring>
+# include <stdexcept>
+# include <string>
+# include <vector>
+
+namespace GE::Objects {
+
+	static constexpr size_t	headerSize = 24;
+
+	# pragma region Constructors & Destructors
+
+	/// @brief Compress a chunk
+	/// @param chunk The chunk to compress, its border included
+	PackedVoxelChunk::PackedVoxelChunk(const VoxelChunk &chunk) : _position(chunk.getPosition()) {
+		std::shared_ptr<std::vector<uint8_t>>	blob = std::make_shared<std::vector<uint8_t>>();
+		std::vector<uint8_t> &					bytes = *blob;
+
+		const auto	put = [&bytes](const void *value, size_t size) {
+			bytes.insert(bytes.end(), (const uint8_t *)value, (const uint8_t *)value + size);
+		};
+
+		const uint32_t	magic = MAGIC;
+		const uint16_t	version = VERSION, sectionCount = SECTION_COUNT;
+		const int32_t	position[3] = {_position.x, _position.y, _position.z};
+		const uint32_t	padding = 0;
+
+		put(&magic, sizeof(magic));
+		put(&version, sizeof(version));
+		put(&sectionCount, sizeof(sectionCount));
+		put(position, sizeof(position));
+		put(&padding, sizeof(padding));
+
+		std::vector<VoxelType>	voxels;
+		std::vector<uint64_t>	indices;
+
+		for (int section = 0; section < SECTION_COUNT; section++) {
+			const size_t	length = _sectionLength(section);
+
+			// Palette in order of first use
+			std::vector<VoxelType>	palette;
+			int						paletteIndex[256];
+			std::fill_n(paletteIndex, 256, -1);
+
+			voxels.resize(length);
+			for (size_t i = 0; i < length; i++) {
+				voxels[i] = chunk.getVoxel(_sectionVoxel(section, i));
+				if (paletteIndex[(uint8_t)voxels[i]] < 0) {
+					paletteIndex[(uint8_t)voxels[i]] = (int)palette.size();
+					palette.push_back(voxels[i]);
+				}
+			}
+
+			// Power of two widths, so an index never straddles two words
+			const uint8_t	bits = (palette.size() == 1) ? 0
+								 : (palette.size() <= 2) ? 1
+								 : (palette.size() <= 4) ? 2
+								 : (palette.size() <= 16) ? 4 : 8;
+			const uint8_t	paletteSize = (uint8_t)(palette.size() - 1);
+
+			put(&bits, 1);
+			put(&paletteSize, 1);
+			put(palette.data(), palette.size());
+			bytes.resize((bytes.size() + 7) & ~(size_t)7, 0);
+
+			if (!bits)
+				continue;
+
+			indices.assign((length * bits + 63) / 64, 0);
+			for (size_t i = 0; i < length; i++) {
+				const size_t	bit = i * bits;
+				indices[bit >> 6] |= (uint64_t)paletteIndex[(uint8_t)voxels[i]] << (bit & 63);
+			}
+			put(indices.data(), indices.size() * sizeof(uint64_t));
+		}
+
+		bytes.shrink_to_fit();
+		_owner = blob;
+		_data = bytes.data();
+		_size = bytes.size();
+		_parse();
+	}
+
+	/// @brief View a compressed chunk without copying it
+	/// @param owner Keeps the bytes alive as long as the chunk, e.g. a file mapping
+	/// @param data The compressed bytes, 8-byte aligned
+	/// @param size The number of bytes
+	/// @throw std::runtime_error if the bytes are not a valid chunk
+	PackedVoxelChunk::PackedVoxelChunk(std::shared_ptr<const void> owner, const uint8_t *data, size_t size)
+		: _owner(std::move(owner)), _data(data), _size(size) {
+		_parse();
+	}
+
+	# pragma endregion
+
+	# pragma region Public methods
+
+	/// @brief Decompress the chunk
+	/// @param chunk The destination, created at getPosition()
+	void	PackedVoxelChunk::unpack(VoxelChunk &chunk) const {
+		VoxelType	row[SECTION_SIZE];
+
+		// Cubes row by row, their x rows are contiguous in both layouts
+		for (int section = 0; section < 8; section++) {
+			for (size_t i = 0; i < _sectionLength(section); i += SECTION_SIZE) {
+				for (int x = 0; x < SECTION_SIZE; x++)
+					row[x] = _read(_sections[section], i + x);
+				chunk.setRow(_sectionVoxel(section, i), row, SECTION_SIZE);
+			}
+		}
+
+		for (int section = 8; section < SECTION_COUNT; section++) {
+			for (size_t i = 0; i < _sectionLength(section); i++)
+				chunk.setVoxel(_sectionVoxel(section, i), _read(_sections[section], i));
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Private methods
+
+	// Point the sections into the blob, checking every bound
+	void	PackedVoxelChunk::_parse() {
+		const auto	corrupted = [this](const std::string &reason) {
+			return std::runtime_error("PackedVoxelChunk: Corrupted chunk data (" + reason + ", " + std::to_string(_size) + " bytes)");
+		};
+
+		if (!_data || _size < headerSize)
+			throw corrupted("truncated header");
+		if ((uintptr_t)_data % 8)
+			throw corrupted("misaligned data");
+
+		uint32_t	magic;
+		uint16_t	version, sectionCount;
+		int32_t		position[3];
+
+		std::memcpy(&magic, _data, sizeof(magic));
+		std::memcpy(&version, _data + 4, sizeof(version));
+		std::memcpy(&sectionCount, _data + 6, sizeof(sectionCount));
+		std::memcpy(position, _data + 8, sizeof(position));
+
+		if (magic != MAGIC || version != VERSION || sectionCount != SECTION_COUNT)
+			throw corrupted("bad header");
+
+		_position = {position[0], position[1], position[2]};
+
+		size_t	offset = headerSize;
+		for (int section = 0; section < SECTION_COUNT; section++) {
+			if (offset + 2 > _size)
+				throw corrupted("truncated section");
+
+			const uint8_t	bits = _data[offset];
+			const size_t	paletteSize = (size_t)_data[offset + 1] + 1;
+
+			if (bits != 0 && bits != 1 && bits != 2 && bits != 4 && bits != 8)
+				throw corrupted("bad index width");
+			if (paletteSize > ((size_t)1 << bits))
+				throw corrupted("palette larger than its indices");
+
+			_sections[section].bits = bits;
+			_sections[section].paletteSize = (uint16_t)paletteSize;
+			_sections[section].palette = (const VoxelType *)(_data + offset + 2);
+
+			offset = (offset + 2 + paletteSize + 7) & ~(size_t)7;
+			_sections[section].indices = (const uint64_t *)(_data + offset);
+			offset += (_sectionLength(section) * bits + 63) / 64 * sizeof(uint64_t);
+
+			if (offset > _size)
+				throw corrupted("truncated section");
+		}
+	}
+
+	// Indices past the palette read as AIR
+	VoxelType	PackedVoxelChunk::_read(const Section &section, size_t index) const {
+		if (!section.bits)
+			return section.palette[0];
+
+		const size_t	bit = index * section.bits;
+		const size_t	value = (section.indices[bit >> 6] >> (bit & 63)) & (((uint64_t)1 << section.bits) - 1);
+
+		return (value < section.paletteSize) ? section.palette[value] : VoxelType::AIR;
+	}
+
+	size_t	PackedVoxelChunk::_sectionLength(int section) {
+		return (section < 8) ? SECTION_SIZE * SECTION_SIZE * SECTION_SIZE : VoxelChunk::SIZE * VoxelChunk::SIZE;
+	}
+
+	// Local coordinates of the index-th voxel of a section
+	glm::ivec3	PackedVoxelChunk::_sectionVoxel(int section, size_t index) {
+		if (section < 8) {
+			return {
+				(section & 1) * SECTION_SIZE + (int)(index % SECTION_SIZE),
+				((section >> 1) & 1) * SECTION_SIZE + (int)(index / SECTION_SIZE % SECTION_SIZE),
+				((section >> 2) & 1) * SECTION_SIZE + (int)(index / (SECTION_SIZE * SECTION_SIZE))
+			};
+		}
+
+		const int	axis = (section - 8) / 2, side = (section - 8) % 2;
+		glm::ivec3	local;
+
+		local[axis] = side ? VoxelChunk::SIZE : -1;
+		local[(axis + 1) % 3] = (int)(index % VoxelChunk::SIZE);
+		local[(axis + 2) % 3] = (int)(index / VoxelChunk::SIZE);
+		return local;
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the chunk coordinates
+	const glm::ivec3 &	PackedVoxelChunk::getPosition() const {
+		return _position;
+	}
+
+	/// @brief Return the voxel at local coordinates, without decompressing the chunk
+	/// @param local The local coordinates, from -1 to SIZE on each axis
+	/// @return The voxel, AIR on the border edges and corners
+	/// @throw std::out_of_range if the coordinates are outside the chunk and its border
+	VoxelType	PackedVoxelChunk::getVoxel(const glm::ivec3 &local) const {
+		const int	size = VoxelChunk::SIZE;
+		int			borderAxis = -1, borderCount = 0;
+
+		for (int axis = 0; axis < 3; axis++) {
+			if (local[axis] < -1 || local[axis] > size)
+				throw std::out_of_range("PackedVoxelChunk: Voxel out of chunk - (" + std::to_string(local.x) + ", " +
+										std::to_string(local.y) + ", " + std::to_string(local.z) + ")");
+
+			if (local[axis] == -1 || local[axis] == size) {
+				borderAxis = axis;
+				borderCount++;
+			}
+		}
+
+		if (!borderCount) {
+			const int		section = (local.x >= SECTION_SIZE) | (local.y >= SECTION_SIZE) << 1 | (local.z >= SECTION_SIZE) << 2;
+			const size_t	index = (size_t)(local.x % SECTION_SIZE)
+								  + (size_t)(local.y % SECTION_SIZE) * SECTION_SIZE
+								  + (size_t)(local.z % SECTION_SIZE) * SECTION_SIZE * SECTION_SIZE;
+
+			return _read(_sections[section], index);
+		}
+
+		if (borderCount > 1)
+			return VoxelType::AIR;
+
+		const int		section = 8 + borderAxis * 2 + (local[borderAxis] == size);
+		const size_t	index = (size_t)local[(borderAxis + 1) % 3] + (size_t)local[(borderAxis + 2) % 3] * size;
+
+		return _read(_sections[section], index);
+	}
+
+	/// @brief Return the compressed bytes, as stored on disk
+	const uint8_t *	PackedVoxelChunk::getData() const {
+		return _data;
+	}
+
+	/// @brief Return the number of compressed bytes
+	size_t	PackedVoxelChunk::getSize() const {
+		return _size;
+	}
+
+	# pragma endregion
+
+} // namespace GE::Objects
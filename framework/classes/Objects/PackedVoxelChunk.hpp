@@ -0,0 +1,78 @@
+#pragma once
+
+/// Includes
+# include "VoxelChunk.hpp"
+
+/// System includes
+# include <array>
+# include <cstdint>
+# include <memory>
+
+/// Dependencies
+# include <glm/glm.hpp>
+
+namespace GE::Objects {
+	/**
+	 * @brief A read-only VoxelChunk compressed with a palette and bit-packed indices.
+	 *
+	 * The chunk is cut in 14 sections : eight 16^3 cubes for the voxels, and the six 32^2 faces of the border.
+	 * Each section stores the voxel types it uses (its palette) and one 0, 1, 2, 4 or 8 bit index per voxel.
+	 * Uniform sections, like sky or deep stone, are a single run : one palette entry and no index at all.
+	 *
+	 * The compressed bytes are the on-disk format, so a chunk can be a view over a memory-mapped file,
+	 * kept alive by the owner given to the constructor. The bytes must be 8-byte aligned, little-endian.
+	 *
+	 * Blob layout :
+	 *  - header : "GEVC", version (uint16), section count (uint16), position (3 x int32), padding (uint32)
+	 *  - per section : bits (uint8), palette size - 1 (uint8), palette, padding to 8 bytes, indices (uint64 words)
+	 *
+	 * @note The border edges and corners are not stored, the mesher never reads them.
+	 * @note Immutable, thus thread-safe.
+	 */
+	class PackedVoxelChunk {
+		public:
+			static constexpr uint32_t	MAGIC = 0x43564547;	// "GEVC"
+			static constexpr uint16_t	VERSION = 1;
+
+			explicit PackedVoxelChunk(const VoxelChunk &chunk);
+			PackedVoxelChunk(std::shared_ptr<const void> owner, const uint8_t *data, size_t size);
+			~PackedVoxelChunk() = default;
+
+			/// Public methods
+
+			void	unpack(VoxelChunk &chunk) const;
+
+			/// Getters
+
+			const glm::ivec3 &	getPosition() const;
+			VoxelType			getVoxel(const glm::ivec3 &local) const;
+			const uint8_t *		getData() const;
+			size_t				getSize() const;
+
+		private:
+			static constexpr int	SECTION_SIZE = 16;
+			static constexpr int	SECTION_COUNT = 8 + 6;	// Voxel cubes, then border faces
+
+			// Parsed section, pointing into the blob
+			struct	Section {
+				uint8_t				bits;
+				uint16_t			paletteSize;
+				const VoxelType *	palette;
+				const uint64_t *	indices;
+			};
+
+			glm::ivec3							_position;
+			std::shared_ptr<const void>			_owner;	// Keeps the blob alive
+			const uint8_t *						_data;
+			size_t								_size;
+			std::array<Section, SECTION_COUNT>	_sections;
+
+			/// Private methods
+
+			void		_parse();
+			VoxelType	_read(const Section &section, size_t index) const;
+
+			static size_t		_sectionLength(int section);
+			static glm::ivec3	_sectionVoxel(int section, size_t index);
+	};
+} // namespace GE::Objects
@@ -1,24 +1,28 @@
 #pragma once
 
 /// Defines
-# define CL_HPP_TARGET_OPENCL_VERSION 300 // OpenCL 3.0
-# define CL_HPP_ENABLE_EXCEPTIONS
 # define CL_ERROR_MSG "\033]8;;https://registry.khronos.org/OpenCL/specs/opencl-cplusplus-1.2.pdf\033\\[Click Here]\033]8;;\033\\"
 # define NO_LIMIT std::numeric_limits<long>::max() // No limit for the number of particles
 
 /// Includes
 # include "core/Logger.hpp"
+# include "core/Profiler.hpp"
+# include "OpenCL/ContextCL.hpp"
+# include "OpenCL/KernelTimerCL.hpp"
+# include "OpenGL/TimerQueryGL.hpp"
+# include "OpenGL/StateCacheGL.hpp"
+# include "Utils/FileWatcher.hpp"
 
 /// System includes
 # include <vector>
 # include <array>
+# include <memory>
+# include <functional>
+# include <future>
 
 /// Dependencies
 # include <json/json_config.hpp>
-# include <OpenCL/opencl.hpp>
-# include <OpenCL/cl_gl.h>
 # include <glad/glad.h>
-# include <GL/glx.h>
 
 namespace GE::Objects {
 	// Data structure for a particle
@@ -31,7 +35,9 @@ namespace GE::Objects {
 
 	// This class is an interface to store particles datas.
 	// The behavior of the particles will be defined in OpenCL kernel functions.
-	// This class set a OpenCL context and a OpenCL queue.
+	// This class set a OpenCL context and a OpenCL queue (through OpenCL::ContextCL).
+	// With hot reload enabled, the kernel is rebuilt on a background thread when a kernel file changes,
+	// and swapped by draw() once built. The kernel arguments are set again, a failed build keeps the old kernel.
 	class ParticleSystem {
 		public:
 			ParticleSystem(size_t ParticleCount, const std::vector<std::string> &VkernelProgramPaths, Core::Logger* logger = nullptr);
@@ -40,29 +46,39 @@ namespace GE::Objects {
 			/// Public functions
 
 			void	draw();
+			void	enableHotReload(Utils::FileWatcher &watcher);
 
 			// Set the kernel arguments
 			// kernel format : void update(__global Particle *particles, int particleCount, ...)
 			//  - Particle = struct { cl_float position[3], cl_float velocity[3], cl_float life }
 			// Use OpenCL types
+			// The arguments are kept, to be set again on a reloaded kernel
 			template <typename... arguments>
 			void	setKernelArgs(arguments... args) {
-				try {
+				kernelArgs = [this, args...](cl::Kernel &target) {
 					/// Set the kernel arguments
 					int index = 0;
 
 					// Mandatory arguments
-					kernel.setArg(index++, particles);
-					kernel.setArg(index++, (cl_int)particleCount);
+					target.setArg(index++, particles);
+					target.setArg(index++, (cl_int)particleCount);
 
 					// User arguments
-					(void)(int[]){0, (kernel.setArg(index++, args), 0)...};
+					(void)(int[]){0, (target.setArg(index++, args), 0)...};
+				};
+
+				try {
+					kernelArgs(kernel);
 				}
 				catch (const cl::Error &e) {
-					throw std::runtime_error("OpenCL error : " + (std::string)e.what() + " (" + CLstrerrno(e.err()) + ")");
+					throw std::runtime_error("OpenCL error : " + (std::string)e.what() + " (" + OpenCL::ContextCL::CLstrerrno(e.err()) + ")");
 				}
 			}
 
+			/// Getters
+
+			const OpenCL::KernelTimerCL &	getKernelTimer() const;
+
 		private:
 			// OpenGL variables
 
@@ -71,14 +87,21 @@ namespace GE::Objects {
 
 			// OpenCL variables
 
-			cl::Platform		platform;
-			cl::Device			device;
-			cl::Context			context;
+			std::unique_ptr<OpenCL::ContextCL>	compute;
 			cl::Program			program;
 			cl::Kernel			kernel;
 			cl::BufferGL		particles; // VRAM buffer
-			cl::CommandQueue	queue;
 			std::vector<cl::Memory>	memObjects;
+			std::vector<std::string>	kernelPaths;
+			std::function<void(cl::Kernel &)>	kernelArgs;
+			OpenCL::KernelTimerCL	kernelTimer;	// Kernel device times, with GE_ENABLE_PROFILING
+
+			// Hot reload variables
+
+			Utils::FileWatcher*			watcher = nullptr;
+			std::vector<size_t>			watchIds;
+			std::future<cl::Program>	pendingProgram;	// Building on a background thread
+			bool						reloadRequested = false;
 
 			// Other variables
 
@@ -87,12 +110,8 @@ namespace GE::Objects {
 
 			/// Private functions
 
-			const std::string	CLstrerrno(cl_int error);
-			cl::Platform	getPlatform();
-			cl::Device		getDevice(const cl::Platform &platform);
-			cl::Context		createContext(const cl::Device &device, const cl::Platform &platform);
-			cl::Program		buildProgram(const std::vector<std::string> &VkernelProgramPaths);
 			void			createOpenGLBuffers(size_t bufferSize);
 			void			createOpenCLContext(const std::vector<std::string> &VkernelProgramPaths);
+			void			updateReload();
 	};
 } // namespace GE::Objects
\ No newline at end of file
@@ -7,16 +7,18 @@ namespace GE::Objects {
 	SkyBox::SkyBox(const std::vector<std::string> &path, Core::Logger *logger) : logger(logger) {
 		if (logger) logger->info("Creating SkyBox");
 
+		OpenGL::StateCacheGL &	state = OpenGL::StateCacheGL::getInstance();
+
 		glGenVertexArrays(1, &VAO);
-		glBindVertexArray(VAO);
+		state.bindVertexArray(VAO);
 
 		glGenBuffers(1, &VBO);
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		state.bindBuffer(GL_ARRAY_BUFFER, VBO);
 
 		// Load the skybox textures
 		if (path.size() == 6) {
 			glGenTextures(1, &textureID);
-			glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+			state.bindTexture(0, GL_TEXTURE_CUBE_MAP, textureID);
 
 			// Load the textures
 			int width, height, nrChannels;
@@ -94,17 +96,19 @@ namespace GE::Objects {
 		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
 		glEnableVertexAttribArray(0);
 
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindVertexArray(0);
+		state.bindBuffer(GL_ARRAY_BUFFER, 0);
+		state.bindVertexArray(0);
 
 		if (logger) logger->info("SkyBox created");
 	}
 
 	SkyBox::~SkyBox() {
+		OpenGL::StateCacheGL &	state = OpenGL::StateCacheGL::getInstance();
+
 		if (textureID)
-			glDeleteTextures(1, &textureID);
-		glDeleteBuffers(1, &VBO);
-		glDeleteVertexArrays(1, &VAO);
+			state.deleteTextures(1, &textureID);
+		state.deleteBuffers(1, &VBO);
+		state.deleteVertexArrays(1, &VAO);
 
 		if (logger) logger->info("SkyBox deleted");
 	}
@@ -114,22 +118,19 @@ namespace GE::Objects {
 	# pragma region Public functions
 
 	/// @brief Draw the skybox
-	/// @note Temporarily disable depth writing and change depth function to GL_LEQUAL
+	/// @note Disable depth writing and change depth function to GL_LEQUAL, through the state cache :
+	/// the framework draws set their own depth state, nothing is restored afterwards
 	void SkyBox::draw() {
-		glDepthMask(GL_FALSE);
-		glDepthFunc(GL_LEQUAL);
+		OpenGL::StateCacheGL &	state = OpenGL::StateCacheGL::getInstance();
 
-		if (textureID) {
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
-		}
+		state.setDepthMask(false);
+		state.setDepthFunc(GL_LEQUAL);
 
-		glBindVertexArray(VAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
-		glBindVertexArray(0);
+		if (textureID)
+			state.bindTexture(0, GL_TEXTURE_CUBE_MAP, textureID);
 
-		glDepthMask(GL_TRUE);
-		glDepthFunc(GL_LESS);
+		state.bindVertexArray(VAO);
+		glDrawArrays(GL_TRIANGLES, 0, 36);
 	}
 	
 	# pragma endregion
@@ -2,6 +2,7 @@
 
 /// Includes
 # include "core/Logger.hpp"
+# include "OpenGL/StateCacheGL.hpp"
 
 /// System includes
 # include <iostream>
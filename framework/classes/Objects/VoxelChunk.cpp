@@ -0,0 +1,182 @@
+#include "VoxelChunk.hpp"
+
+/// System includes
+# include <algorithm>
+# include <array>
+# include <stdexcept>
+# include <string>
+
+namespace GE::Objects {
+
+	// Index offsets of a step along x, y and z in the padded storage
+	static constexpr int	axisStrides[3] = {1, VoxelChunk::PADDED_SIZE, VoxelChunk::PADDED_SIZE * VoxelChunk::PADDED_SIZE};
+
+	# pragma region Constructors & Destructors
+
+	/// @param position The chunk coordinates, the first voxel is at position * SIZE in world space
+	VoxelChunk::VoxelChunk(const glm::ivec3 &position)
+		: _position(position), _voxels((size_t)PADDED_SIZE * PADDED_SIZE * PADDED_SIZE, VoxelType::AIR) {}
+
+	# pragma endregion
+
+	# pragma region Public methods
+
+	/// @brief Build the mesh of the chunk with greedy meshing
+	/// @param mesh The destination, cleared first
+	/// @note Faces between two solid voxels are culled, the border included. Coplanar neighbor faces of the same
+	/// type are merged into rectangles, so flat terrain costs a few quads per chunk instead of one per voxel.
+	void	VoxelChunk::buildMesh(VoxelMesh &mesh) const {
+		std::array<VoxelType, SIZE * SIZE>	mask;
+
+		mesh.vertices.clear();
+		mesh.indices.clear();
+
+		for (int axis = 0; axis < 3; axis++) {
+			const int	u = (axis + 1) % 3, v = (axis + 2) % 3;
+			const int	strideAxis = axisStrides[axis], strideU = axisStrides[u], strideV = axisStrides[v];
+			const int	first = (int)_index({0, 0, 0});
+
+			// side 0 looks toward +axis, side 1 toward -axis
+			for (int side = 0; side < 2; side++) {
+				const int	neighbor = side ? -strideAxis : strideAxis;
+
+				for (int slice = 0; slice < SIZE; slice++) {
+					// Visible faces of the slice : solid voxels facing an empty one
+					for (int j = 0; j < SIZE; j++) {
+						const int	row = first + slice * strideAxis + j * strideV;
+
+						for (int i = 0; i < SIZE; i++) {
+							const int		index = row + i * strideU;
+							const VoxelType	type = _voxels[index];
+
+							mask[j * SIZE + i] = (type != VoxelType::AIR && _voxels[index + neighbor] == VoxelType::AIR) ? type : VoxelType::AIR;
+						}
+					}
+
+					// Grow each face along u, then along v while the whole row matches
+					for (int j = 0; j < SIZE; j++) {
+						for (int i = 0; i < SIZE;) {
+							const VoxelType	type = mask[j * SIZE + i];
+							if (type == VoxelType::AIR) {
+								i++;
+								continue;
+							}
+
+							int	width = 1;
+							while (i + width < SIZE && mask[j * SIZE + i + width] == type)
+								width++;
+
+							int	height = 1;
+							for (; j + height < SIZE; height++) {
+								const VoxelType *	next = &mask[(j + height) * SIZE + i];
+								if (std::any_of(next, next + width, [type](VoxelType other) { return other != type; }))
+									break;
+							}
+
+							for (int h = 0; h < height; h++)
+								std::fill_n(&mask[(j + h) * SIZE + i], width, VoxelType::AIR);
+
+							_emitQuad(mesh, axis, side, slice, i, j, width, height, type);
+							i += width;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Private methods
+
+	size_t	VoxelChunk::_index(const glm::ivec3 &local) {
+		return ((size_t)(local.z + 1) * PADDED_SIZE + (local.y + 1)) * PADDED_SIZE + (local.x + 1);
+	}
+
+	// Append a width x height face lying on the slice, counter-clockwise seen from outside
+	void	VoxelChunk::_emitQuad(VoxelMesh &mesh, int axis, int side, int slice, int i, int j, int width, int height, VoxelType type) const {
+		const int	u = (axis + 1) % 3, v = (axis + 2) % 3;
+
+		glm::vec3	corner = glm::vec3(_position * SIZE);
+		glm::vec3	du = {0, 0, 0}, dv = {0, 0, 0};
+
+		corner[axis] += (float)(side ? slice : slice + 1);
+		corner[u] += (float)i;
+		corner[v] += (float)j;
+		du[u] = (float)width;
+		dv[v] = (float)height;
+
+		// u x v points toward +axis, swap the edges to face -axis
+		if (side)
+			std::swap(du, dv);
+
+		const uint32_t	base = (uint32_t)mesh.vertices.size();
+		const uint8_t	normal = (uint8_t)(axis * 2 + side);
+
+		for (const glm::vec3 &position : {corner, corner + du, corner + du + dv, corner + dv})
+			mesh.vertices.push_back({position, normal, (uint8_t)type, {0, 0}});
+
+		for (uint32_t index : {0u, 1u, 2u, 0u, 2u, 3u})
+			mesh.indices.push_back(base + index);
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the chunk coordinates
+	const glm::ivec3 &	VoxelChunk::getPosition() const {
+		return _position;
+	}
+
+	/// @brief Return the voxel at local coordinates
+	/// @param local The local coordinates, from -1 to SIZE on each axis
+	/// @throw std::out_of_range if the coordinates are outside the chunk and its border
+	VoxelType	VoxelChunk::getVoxel(const glm::ivec3 &local) const {
+		if (glm::any(glm::lessThan(local, glm::ivec3(-1))) || glm::any(glm::greaterThan(local, glm::ivec3(SIZE))))
+			throw std::out_of_range("VoxelChunk: Voxel out of chunk - (" + std::to_string(local.x) + ", " +
+									std::to_string(local.y) + ", " + std::to_string(local.z) + ")");
+
+		return _voxels[_index(local)];
+	}
+
+	/// @brief Return true if the chunk and its border hold no solid voxel
+	bool	VoxelChunk::isEmpty() const {
+		return std::all_of(_voxels.begin(), _voxels.end(), [](VoxelType type) { return type == VoxelType::AIR; });
+	}
+
+	# pragma endregion
+
+	# pragma region Setters
+
+	/// @brief Set the voxel at local coordinates
+	/// @param local The local coordinates, from -1 to SIZE on each axis
+	/// @param type The new voxel
+	/// @throw std::out_of_range if the coordinates are outside the chunk and its border
+	void	VoxelChunk::setVoxel(const glm::ivec3 &local, VoxelType type) {
+		if (glm::any(glm::lessThan(local, glm::ivec3(-1))) || glm::any(glm::greaterThan(local, glm::ivec3(SIZE))))
+			throw std::out_of_range("VoxelChunk: Voxel out of chunk - (" + std::to_string(local.x) + ", " +
+									std::to_string(local.y) + ", " + std::to_string(local.z) + ")");
+
+		_voxels[_index(local)] = type;
+	}
+
+	/// @brief Change consecutive voxels along the x axis
+	/// @param local The local coordinates of the first voxel
+	/// @param types The new voxels, count of them
+	/// @param count The number of voxels, the row must end within the chunk border
+	/// @throw std::out_of_range if the row leaves the chunk and its border
+	void	VoxelChunk::setRow(const glm::ivec3 &local, const VoxelType *types, int count) {
+		if (count <= 0)
+			return;
+		if (glm::any(glm::lessThan(local, glm::ivec3(-1))) || glm::any(glm::greaterThan(local, glm::ivec3(SIZE)))
+			|| local.x + count - 1 > SIZE)
+			throw std::out_of_range("VoxelChunk: Row out of chunk - (" + std::to_string(local.x) + ", " +
+									std::to_string(local.y) + ", " + std::to_string(local.z) + ") + " + std::to_string(count));
+
+		std::copy_n(types, count, _voxels.begin() + _index(local));
+	}
+
+	# pragma endregion
+
+} // namespace GE::Objects
@@ -0,0 +1,78 @@
+#pragma once
+
+/// System includes
+# include <cstdint>
+# include <vector>
+
+/// Dependencies
+# include <glm/glm.hpp>
+
+namespace GE::Objects {
+
+	// Block types, AIR is the only transparent one
+	enum class VoxelType : uint8_t {
+		AIR,
+		STONE,
+		DIRT,
+		GRASS,
+		SAND
+	};
+
+	// Vertex of a voxel mesh, stored in 16 bytes
+	//  - normal : 0 = +X, 1 = -X, 2 = +Y, 3 = -Y, 4 = +Z, 5 = -Z
+	struct VoxelVertex {
+		glm::vec3	position;	// World position
+		uint8_t		normal;
+		uint8_t		type;		// VoxelType of the face
+		uint8_t		padding[2];
+	};
+
+	// Indexed triangles of a chunk, one quad per merged face
+	struct VoxelMesh {
+		std::vector<VoxelVertex>	vertices;
+		std::vector<uint32_t>		indices;
+	};
+
+	/**
+	 * @brief A cubic block of SIZE^3 voxels, with a one voxel border copied from its neighbors.
+	 *
+	 * The border lets a chunk cull the faces it shares with its neighbors without reading them,
+	 * so chunks can be meshed independently on any thread.
+	 *
+	 * Local coordinates go from -1 to SIZE on each axis, -1 and SIZE being the border.
+	 *
+	 * @note A chunk is a plain value, const methods are thread-safe.
+	 */
+	class VoxelChunk {
+		public:
+			static constexpr int	SIZE = 32;
+			static constexpr int	PADDED_SIZE = SIZE + 2;
+
+			explicit VoxelChunk(const glm::ivec3 &position);
+			~VoxelChunk() = default;
+
+			/// Public methods
+
+			void	buildMesh(VoxelMesh &mesh) const;
+
+			/// Getters
+
+			const glm::ivec3 &	getPosition() const;
+			VoxelType			getVoxel(const glm::ivec3 &local) const;
+			bool				isEmpty() const;
+
+			/// Setters
+
+			void	setVoxel(const glm::ivec3 &local, VoxelType type);
+			void	setRow(const glm::ivec3 &local, const VoxelType *types, int count);
+
+		private:
+			glm::ivec3				_position;	// In chunks
+			std::vector<VoxelType>	_voxels;	// PADDED_SIZE^3, x first, then y, then z
+
+			/// Private methods
+
+			static size_t	_index(const glm::ivec3 &local);
+			void			_emitQuad(VoxelMesh &mesh, int axis, int side, int slice, int i, int j, int width, int height, VoxelType type) const;
+	};
+} // namespace GE::Objects
@@ -0,0 +1,272 @@
+#include "VoxelRegionStore.hpp"
+
+/// System includes
+# include <cerrno>
+# include <cstring>
+# include <filesystem>
+# include <stdexcept>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+
+namespace GE::Objects {
+
+	// Magic (uint32), version (uint32), reserved (uint64), then the table
+	static constexpr size_t	headerSize = 16;
+
+	static std::runtime_error	ioError(const std::string &what, const std::string &path) {
+		return std::runtime_error("VoxelRegionStore: " + what + " " + path + " : " + (std::string)std::strerror(errno));
+	}
+
+	// Write the whole buffer, pwrite may stop early
+	static bool	writeAll(int fd, const void *data, size_t size, off_t offset) {
+		const uint8_t	*bytes = (const uint8_t *)data;
+
+		while (size) {
+			const ssize_t	written = pwrite(fd, bytes, size, offset);
+
+			if (written < 0 && errno == EINTR)
+				continue;
+			if (written <= 0)
+				return false;
+			bytes += written;
+			size -= written;
+			offset += written;
+		}
+		return true;
+	}
+
+	VoxelRegionStore::Mapping::~Mapping() {
+		if (address)
+			munmap(address, size);
+	}
+
+	# pragma region Constructors & Destructors
+
+	/// @brief Open a region directory, created if missing
+	/// @param directory The directory holding the region files
+	/// @param maxOpenRegions The number of region files kept open, the least recently used are closed first
+	/// @throw std::filesystem::filesystem_error if the directory cannot be created
+	VoxelRegionStore::VoxelRegionStore(const std::string &directory, size_t maxOpenRegions)
+		: _directory(directory), _maxOpenRegions(maxOpenRegions ? maxOpenRegions : 1) {
+		std::filesystem::create_directories(_directory);
+	}
+
+	/// @note Flushes the pending chunks, errors are ignored : call flush() first to handle them
+	VoxelRegionStore::~VoxelRegionStore() {
+		try {
+			flush();
+		}
+		catch (const std::exception &) {}
+
+		while (!_lru.empty())
+			_close(_lru.back());
+	}
+
+	# pragma endregion
+
+	# pragma region Public methods
+
+	/// @brief Load a chunk
+	/// @param position The chunk coordinates
+	/// @return The chunk, viewing the region file mapping, or nullptr if it was never saved
+	/// @throw std::runtime_error if the region file cannot be read, or the chunk is corrupted
+	std::shared_ptr<const PackedVoxelChunk>	VoxelRegionStore::load(const glm::ivec3 &position) {
+		std::lock_guard<std::mutex>	lock(_mutex);
+
+		const auto	pending = _pending.find(position);
+		if (pending != _pending.end()) {
+			_loadedChunks++;
+			return pending->second;
+		}
+
+		Region &			region = _open(_regionOf(position));
+		const TableEntry &	entry = region.table[_slotOf(position)];
+
+		if (!entry.size)
+			return nullptr;
+
+		if (entry.offset + entry.size > region.fileSize)
+			throw std::runtime_error("VoxelRegionStore: Chunk past the end of " + _path(_regionOf(position)));
+
+		// Appends are not visible through the current mapping, remap the whole file
+		if (!region.mapping || region.mapping->size < entry.offset + entry.size) {
+			void	*address = mmap(nullptr, region.fileSize, PROT_READ, MAP_SHARED, region.fd, 0);
+
+			if (address == MAP_FAILED)
+				throw ioError("Failed to map", _path(_regionOf(position)));
+			region.mapping = std::shared_ptr<Mapping>(new Mapping{address, region.fileSize});
+		}
+
+		std::shared_ptr<const PackedVoxelChunk>	chunk = std::make_shared<const PackedVoxelChunk>(
+			region.mapping, (const uint8_t *)region.mapping->address + entry.offset, (size_t)entry.size
+		);
+
+		if (chunk->getPosition() != position)
+			throw std::runtime_error("VoxelRegionStore: Chunk stored at the wrong position in " + _path(_regionOf(position)));
+
+		_loadedChunks++;
+		return chunk;
+	}
+
+	/// @brief Queue a chunk for the next flush(), replacing the previous save
+	/// @param chunk The chunk, stored at its own position
+	void	VoxelRegionStore::save(std::shared_ptr<const PackedVoxelChunk> chunk) {
+		if (!chunk)
+			return;
+
+		std::lock_guard<std::mutex>	lock(_mutex);
+		const glm::ivec3			position = chunk->getPosition();
+
+		_pending[position] = std::move(chunk);
+	}
+
+	/// @brief Write the queued chunks to their region files
+	/// @throw std::runtime_error if a region file cannot be written, the chunks not written stay queued
+	/// @note Blocks load() until done, call it from a worker
+	void	VoxelRegionStore::flush() {
+		std::lock_guard<std::mutex>	lock(_mutex);
+
+		for (auto it = _pending.begin(); it != _pending.end(); ) {
+			Region &	region = _open(_regionOf(it->first));
+
+			_write(region, _slotOf(it->first), *it->second);
+			_savedChunks++;
+			it = _pending.erase(it);
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Private methods
+
+	// Open a region file, creating it if missing, and mark it as the most recently used
+	VoxelRegionStore::Region &	VoxelRegionStore::_open(const glm::ivec3 &position) {
+		const auto	found = _regions.find(position);
+
+		if (found != _regions.end()) {
+			_lru.splice(_lru.begin(), _lru, found->second->lruPosition);
+			return *found->second;
+		}
+
+		while (_regions.size() >= _maxOpenRegions)
+			_close(_lru.back());
+
+		const std::string		path = _path(position);
+		std::unique_ptr<Region>	region = std::make_unique<Region>();
+		struct stat				status;
+
+		region->fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+		if (region->fd < 0)
+			throw ioError("Failed to open", path);
+
+		try {
+			if (fstat(region->fd, &status) < 0)
+				throw ioError("Failed to stat", path);
+
+			uint32_t	header[4] = {MAGIC, VERSION, 0, 0};
+
+			if (!status.st_size) {
+				std::memset(region->table, 0, sizeof(region->table));
+				if (!writeAll(region->fd, header, headerSize, 0)
+					|| !writeAll(region->fd, region->table, sizeof(region->table), headerSize))
+					throw ioError("Failed to write", path);
+				region->fileSize = headerSize + sizeof(region->table);
+			}
+			else {
+				if ((size_t)status.st_size < headerSize + sizeof(region->table)
+					|| pread(region->fd, header, headerSize, 0) != (ssize_t)headerSize
+					|| pread(region->fd, region->table, sizeof(region->table), headerSize) != (ssize_t)sizeof(region->table))
+					throw std::runtime_error("VoxelRegionStore: Truncated region file " + path);
+				if (header[0] != MAGIC || header[1] != VERSION)
+					throw std::runtime_error("VoxelRegionStore: Invalid region file " + path);
+				region->fileSize = status.st_size;
+			}
+		}
+		catch (...) {
+			close(region->fd);
+			throw;
+		}
+
+		_lru.push_front(position);
+		region->lruPosition = _lru.begin();
+		return *(_regions[position] = std::move(region));
+	}
+
+	// Close a region file, its mapping lives on in the loaded chunks
+	void	VoxelRegionStore::_close(const glm::ivec3 &position) {
+		const auto	found = _regions.find(position);
+
+		if (found == _regions.end())
+			return;
+
+		close(found->second->fd);
+		_lru.erase(found->second->lruPosition);
+		_regions.erase(found);
+	}
+
+	// Append a chunk, 8-byte aligned for PackedVoxelChunk, then point the table to it
+	void	VoxelRegionStore::_write(Region &region, int slot, const PackedVoxelChunk &chunk) {
+		const TableEntry	entry = {((uint64_t)region.fileSize + 7) & ~(uint64_t)7, chunk.getSize()};
+		const std::string	path = _path(_regionOf(chunk.getPosition()));
+
+		if (!writeAll(region.fd, chunk.getData(), chunk.getSize(), entry.offset))
+			throw ioError("Failed to write", path);
+		region.fileSize = entry.offset + entry.size;
+
+		// The table is updated last, a crash before leaves the previous chunk in place
+		if (!writeAll(region.fd, &entry, sizeof(entry), headerSize + slot * sizeof(TableEntry)))
+			throw ioError("Failed to write", path);
+		region.table[slot] = entry;
+	}
+
+	std::string	VoxelRegionStore::_path(const glm::ivec3 &region) const {
+		return _directory + "/r." + std::to_string(region.x) + "." + std::to_string(region.y) + "." + std::to_string(region.z);
+	}
+
+	glm::ivec3	VoxelRegionStore::_regionOf(const glm::ivec3 &position) {
+		// Floor division, so negative chunks do not share region 0
+		return {
+			(position.x >= 0 ? position.x : position.x - REGION_SIZE + 1) / REGION_SIZE,
+			(position.y >= 0 ? position.y : position.y - REGION_SIZE + 1) / REGION_SIZE,
+			(position.z >= 0 ? position.z : position.z - REGION_SIZE + 1) / REGION_SIZE
+		};
+	}
+
+	int	VoxelRegionStore::_slotOf(const glm::ivec3 &position) {
+		const glm::ivec3	local = position - _regionOf(position) * REGION_SIZE;
+
+		return local.x + (local.y + local.z * REGION_SIZE) * REGION_SIZE;
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the region directory
+	const std::string &	VoxelRegionStore::getDirectory() const {
+		return _directory;
+	}
+
+	/// @brief Return the disk counters
+	VoxelRegionStats	VoxelRegionStore::getStats() {
+		std::lock_guard<std::mutex>	lock(_mutex);
+		VoxelRegionStats			stats = {};
+
+		stats.openRegions = _regions.size();
+		stats.loadedChunks = _loadedChunks;
+		stats.savedChunks = _savedChunks;
+		stats.pendingChunks = _pending.size();
+		for (const auto &[position, region] : _regions) {
+			stats.fileBytes += region->fileSize;
+			stats.liveBytes += headerSize + sizeof(region->table);
+			for (const TableEntry &entry : region->table)
+				stats.liveBytes += entry.size;
+		}
+		return stats;
+	}
+
+	# pragma endregion
+
+} // namespace GE::Objects
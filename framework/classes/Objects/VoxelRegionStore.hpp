@@ -0,0 +1,123 @@
+#pragma once
+
+/// Includes
+# include "PackedVoxelChunk.hpp"
+
+/// System includes
+# include <cstdint>
+# include <list>
+# include <memory>
+# include <mutex>
+# include <string>
+# include <unordered_map>
+
+/// Dependencies
+# include <glm/glm.hpp>
+
+namespace GE::Objects {
+
+	/// @brief Disk counters of a VoxelRegionStore
+	struct VoxelRegionStats {
+		size_t	openRegions;
+		size_t	loadedChunks;		// Chunks read from disk (or from the pending writes)
+		size_t	savedChunks;		// Chunks written to disk
+		size_t	pendingChunks;		// Chunks saved but not flushed yet
+		size_t	fileBytes;			// Size of the open region files
+		size_t	liveBytes;			// Bytes of the open region files still referenced, the rest was overwritten
+	};
+
+	/**
+	 * @brief Stores PackedVoxelChunk in region files of REGION_SIZE^3 chunks, read through memory mapping.
+	 *
+	 * A region file is a header, a table of (offset, size) per chunk, then the compressed chunks.
+	 * Chunks are appended, a rewritten chunk leaves its previous bytes unused until the file is deleted.
+	 *
+	 * Loaded chunks are views over the mapping, nothing is copied. A mapping stays alive as long as
+	 * a chunk uses it, even after its file grew or was closed.
+	 *
+	 * save() only queues the chunk, flush() writes the queue, so the caller decides which thread pays
+	 * for the I/O. Queued chunks are returned by load() until written.
+	 *
+	 * @note All public methods are thread-safe.
+	 * @note Files are written in the host byte order (little-endian on every supported platform).
+	 * @note Use one directory per world seed, the store does not know how chunks were generated.
+	 */
+	class VoxelRegionStore {
+		public:
+			static constexpr int		REGION_SIZE = 8;	// Chunks per axis
+			static constexpr uint32_t	MAGIC = 0x52564547;	// "GEVR"
+			static constexpr uint32_t	VERSION = 1;
+
+			explicit VoxelRegionStore(const std::string &directory, size_t maxOpenRegions = 32);
+			~VoxelRegionStore();
+
+			VoxelRegionStore(const VoxelRegionStore &) = delete;
+			VoxelRegionStore &operator=(const VoxelRegionStore &) = delete;
+
+			/// Public methods
+
+			std::shared_ptr<const PackedVoxelChunk>	load(const glm::ivec3 &position);
+			void									save(std::shared_ptr<const PackedVoxelChunk> chunk);
+			void									flush();
+
+			/// Getters
+
+			const std::string &	getDirectory() const;
+			VoxelRegionStats	getStats();
+
+		private:
+			static constexpr int	CHUNKS_PER_REGION = REGION_SIZE * REGION_SIZE * REGION_SIZE;
+
+			struct	PositionHash {
+				size_t	operator()(const glm::ivec3 &position) const {
+					size_t	hash = (size_t)(uint32_t)position.x * 0x85EBCA77u;
+					hash ^= (size_t)(uint32_t)position.y * 0xC2B2AE3Du + (hash << 6) + (hash >> 2);
+					hash ^= (size_t)(uint32_t)position.z * 0x27D4EB2Fu + (hash << 6) + (hash >> 2);
+					return hash;
+				}
+			};
+
+			// Offset and size of a chunk in its region file, size 0 if absent
+			struct	TableEntry {
+				uint64_t	offset;
+				uint64_t	size;
+			};
+
+			// A read-only mapping of a whole file, unmapped with its last user
+			struct	Mapping {
+				void *	address;
+				size_t	size;
+
+				~Mapping();
+			};
+
+			struct	Region {
+				int							fd = -1;
+				TableEntry					table[CHUNKS_PER_REGION];
+				size_t						fileSize = 0;
+				std::shared_ptr<Mapping>	mapping;		// Covers the file as of its last load()
+				std::list<glm::ivec3>::iterator	lruPosition;
+			};
+
+			std::string		_directory;
+			size_t			_maxOpenRegions;
+
+			std::mutex		_mutex;
+			std::unordered_map<glm::ivec3, std::unique_ptr<Region>, PositionHash>						_regions;
+			std::list<glm::ivec3>																		_lru;	// Most recently used first
+			std::unordered_map<glm::ivec3, std::shared_ptr<const PackedVoxelChunk>, PositionHash>	_pending;
+
+			size_t			_loadedChunks = 0;
+			size_t			_savedChunks = 0;
+
+			/// Private methods
+
+			Region &		_open(const glm::ivec3 &region);
+			void			_close(const glm::ivec3 &region);
+			void			_write(Region &region, int slot, const PackedVoxelChunk &chunk);
+			std::string		_path(const glm::ivec3 &region) const;
+
+			static glm::ivec3	_regionOf(const glm::ivec3 &position);
+			static int			_slotOf(const glm::ivec3 &position);
+	};
+} // namespace GE::Objects
@@ -0,0 +1,439 @@
+#include "VoxelWorld.hpp"
+
+/// System includes
+# include <algorithm>
+# include <chrono>
+# include <cmath>
+# include <stdexcept>
+
+namespace GE::Objects {
+
+	# pragma region Constructors & Destructors
+
+	VoxelWorld::VoxelWorld(const VoxelWorldInfo &info, Core::Logger *logger)
+		: _info(info), _noise(info.seed), _terrain(_noise, info.terrain), logger(logger), _pool(info.threadCount) {
+		if (info.viewDistance < 0 || info.verticalChunks < 1)
+			throw std::invalid_argument("VoxelWorld: Invalid view distance or vertical chunk count");
+
+		if (logger) logger->info("Creating VoxelWorld with " + std::to_string(_pool.getThreadCount()) + " workers");
+
+		if (!info.regionDirectory.empty()) {
+			_store = std::make_unique<VoxelRegionStore>(info.regionDirectory);
+			if (logger) logger->info("VoxelWorld region files in " + info.regionDirectory);
+		}
+
+		// Load the nearest columns first
+		for (int z = -info.viewDistance; z <= info.viewDistance; z++)
+			for (int x = -info.viewDistance; x <= info.viewDistance; x++)
+				if (x * x + z * z <= info.viewDistance * info.viewDistance)
+					_loadOrder.push_back({x, z});
+
+		std::stable_sort(_loadOrder.begin(), _loadOrder.end(), [](const glm::ivec2 &a, const glm::ivec2 &b) {
+			return a.x * a.x + a.y * a.y < b.x * b.x + b.y * b.y;
+		});
+
+		if (logger) logger->info("VoxelWorld created");
+	}
+
+	// _pool is destroyed first : queued chunks are dropped, running ones are waited for
+	VoxelWorld::~VoxelWorld() {
+		for (auto &[position, entry] : _chunks) {
+			entry.cancelled->store(true);
+			_save(entry);
+			_release(entry);
+		}
+
+		if (_store) {
+			try {
+				_store->flush();
+			}
+			catch (const std::exception &e) {
+				if (logger) logger->error("Failed to save VoxelWorld chunks: " + std::string(e.what()));
+			}
+		}
+
+		if (logger) logger->info("VoxelWorld destroyed");
+	}
+
+	# pragma endregion
+
+	# pragma region Public functions
+
+	/// @brief Stream the chunks around the camera and upload the finished meshes
+	/// @param cameraPosition The world position the view distance is measured from
+	/// @note Uploads at most VoxelWorldInfo::uploadsPerFrame meshes, call it once per frame
+	void	VoxelWorld::update(const glm::vec3 &cameraPosition) {
+		const glm::ivec3	cameraChunk = _chunkOf({(int)std::floor(cameraPosition.x), 0, (int)std::floor(cameraPosition.z)});
+		const glm::ivec2	column = {cameraChunk.x, cameraChunk.z};
+
+		if (!_centered || column != _centerColumn) {
+			_centerColumn = column;
+			_centered = true;
+			_unloadFar(column);
+			_loadAround(column);
+		}
+
+		size_t	uploaded = 0;
+		while (uploaded < _info.uploadsPerFrame) {
+			MeshResult	result;
+			{
+				std::lock_guard<std::mutex>	lock(_resultsMutex);
+				if (_results.empty())
+					break;
+
+				result = std::move(_results.front());
+				_results.pop_front();
+			}
+
+			// Unloaded or edited since the job was submitted
+			auto	it = _chunks.find(result.position);
+			if (it == _chunks.end() || it->second.version != result.version)
+				continue;
+
+			it->second.chunk = result.chunk;
+			it->second.dirty |= result.generated;
+			_upload(it->second, result.mesh);
+			uploaded++;
+		}
+	}
+
+	/// @brief Draw every chunk with a mesh
+	/// @note Bind the shader before calling this function
+	void	VoxelWorld::draw() {
+		OpenGL::StateCacheGL &	state = OpenGL::StateCacheGL::getInstance();
+
+		state.setDepthMask(true);
+		state.setDepthFunc(GL_LESS);
+
+		for (const auto &[position, entry] : _chunks) {
+			if (!entry.indexCount)
+				continue;
+
+			state.bindVertexArray(entry.VAO);
+			glDrawElements(GL_TRIANGLES, entry.indexCount, GL_UNSIGNED_INT, nullptr);
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Private functions
+
+	void	VoxelWorld::_loadAround(const glm::ivec2 &column) {
+		for (const glm::ivec2 &offset : _loadOrder) {
+			for (int y = 0; y < _info.verticalChunks; y++) {
+				const glm::ivec3	position = {column.x + offset.x, y, column.y + offset.y};
+				if (_chunks.count(position))
+					continue;
+
+				ChunkEntry &	entry = _chunks[position];
+				entry.cancelled = std::make_shared<std::atomic<bool>>(false);
+				_submit(position, entry, nullptr);
+			}
+		}
+	}
+
+	// One chunk of hysteresis, so crossing a chunk border back and forth does not reload anything
+	void	VoxelWorld::_unloadFar(const glm::ivec2 &column) {
+		const int	limit = _info.viewDistance + 1;
+		bool		saved = false;
+
+		for (auto it = _chunks.begin(); it != _chunks.end();) {
+			const int	dx = it->first.x - column.x;
+			const int	dz = it->first.z - column.y;
+
+			if (dx * dx + dz * dz > limit * limit) {
+				it->second.cancelled->store(true);
+				saved |= _save(it->second);
+				_release(it->second);
+				it = _chunks.erase(it);
+			}
+			else
+				++it;
+		}
+
+		// Written by a worker, the chunks stay readable from the store meanwhile
+		if (saved) {
+			_pool.submit([this]() {
+				try {
+					_store->flush();
+				}
+				catch (const std::exception &e) {
+					if (logger) logger->error("Failed to save VoxelWorld chunks: " + std::string(e.what()));
+				}
+			});
+		}
+	}
+
+	// Queue the loading or generation (packed is null) or the remesh of a chunk
+	void	VoxelWorld::_submit(const glm::ivec3 &position, ChunkEntry &entry, std::shared_ptr<const PackedVoxelChunk> packed) {
+		const uint64_t						version = ++entry.version;
+		std::shared_ptr<std::atomic<bool>>	cancelled = entry.cancelled;
+
+		_pool.submit([this, position, version, cancelled, packed]() mutable {
+			if (cancelled->load())
+				return;
+
+			VoxelChunk	chunk(position);
+			bool		generated = false;
+
+			if (packed)
+				packed->unpack(chunk);
+			else if (!(packed = _load(chunk))) {
+				packed = _generate(chunk);
+				generated = true;
+			}
+
+			const auto	start = std::chrono::steady_clock::now();
+			MeshResult	result = {position, version, packed, generated, {}};
+
+			chunk.buildMesh(result.mesh);
+			_meshingTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			_meshedChunks++;
+
+			std::lock_guard<std::mutex>	lock(_resultsMutex);
+			_results.push_back(std::move(result));
+		});
+	}
+
+	// Queue a generated or edited chunk for the next flush, returns false if there is nothing to save
+	bool	VoxelWorld::_save(ChunkEntry &entry) {
+		if (!_store || !entry.dirty || !entry.chunk)
+			return false;
+
+		_store->save(entry.chunk);
+		entry.dirty = false;
+		return true;
+	}
+
+	void	VoxelWorld::_upload(ChunkEntry &entry, const VoxelMesh &mesh) {
+		entry.indexCount = (GLsizei)mesh.indices.size();
+		if (!entry.indexCount)
+			return;
+
+		const size_t	vertexBytes = mesh.vertices.size() * sizeof(VoxelVertex);
+		const size_t	indexBytes = mesh.indices.size() * sizeof(uint32_t);
+
+		OpenGL::StateCacheGL &	state = OpenGL::StateCacheGL::getInstance();
+
+		if (!entry.VAO) {
+			glGenVertexArrays(1, &entry.VAO);
+			state.bindVertexArray(entry.VAO);
+
+			entry.vertices = std::make_unique<OpenGL::BufferGL>(GL_ARRAY_BUFFER, GL_STATIC_DRAW, vertexBytes, mesh.vertices.data());
+			entry.indices = std::make_unique<OpenGL::BufferGL>(GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW, indexBytes, mesh.indices.data());
+
+			glEnableVertexAttribArray(0); // Position
+			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(VoxelVertex), (void*)offsetof(VoxelVertex, position));
+
+			glEnableVertexAttribArray(1); // Normal
+			glVertexAttribIPointer(1, 1, GL_UNSIGNED_BYTE, sizeof(VoxelVertex), (void*)offsetof(VoxelVertex, normal));
+
+			glEnableVertexAttribArray(2); // Type
+			glVertexAttribIPointer(2, 1, GL_UNSIGNED_BYTE, sizeof(VoxelVertex), (void*)offsetof(VoxelVertex, type));
+		}
+		else {
+			state.bindVertexArray(entry.VAO);
+			entry.vertices->resize(vertexBytes, mesh.vertices.data());
+			entry.indices->resize(indexBytes, mesh.indices.data());
+		}
+
+		state.bindVertexArray(0);
+		state.bindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void	VoxelWorld::_release(ChunkEntry &entry) {
+		if (entry.VAO)
+			OpenGL::StateCacheGL::getInstance().deleteVertexArrays(1, &entry.VAO);
+
+		entry.VAO = 0;
+		entry.vertices.reset();
+		entry.indices.reset();
+		entry.indexCount = 0;
+	}
+
+	// Runs on a worker thread : read the chunk from the region files, null if it was never saved or cannot be read
+	std::shared_ptr<const PackedVoxelChunk>	VoxelWorld::_load(VoxelChunk &chunk) {
+		if (!_store)
+			return nullptr;
+
+		const auto								start = std::chrono::steady_clock::now();
+		std::shared_ptr<const PackedVoxelChunk>	packed;
+
+		try {
+			packed = _store->load(chunk.getPosition());
+		}
+		catch (const std::exception &e) {
+			if (logger) logger->error("Failed to load voxel chunk, generating it again: " + std::string(e.what()));
+			return nullptr;
+		}
+
+		if (!packed)
+			return nullptr;
+
+		packed->unpack(chunk);
+
+		_loadTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		_loadedChunks++;
+
+		return packed;
+	}
+
+	// Runs on a worker thread : fractal heightmap, layered top to bottom, carved by 3D noise
+	std::shared_ptr<const PackedVoxelChunk>	VoxelWorld::_generate(VoxelChunk &chunk) {
+		const auto			start = std::chrono::steady_clock::now();
+		const int			padded = VoxelChunk::PADDED_SIZE;
+		const glm::ivec3	origin = chunk.getPosition() * VoxelChunk::SIZE - 1;	// World position of the first border voxel
+
+		std::vector<float>	heights((size_t)padded * padded);
+
+		_terrain.sample2DGrid(heights.data(), {(float)origin.x, (float)origin.z}, {1, 1}, glm::uvec2(padded));
+
+		for (int z = 0; z < padded; z++) {
+			for (int x = 0; x < padded; x++) {
+				const float	height = _info.baseHeight + heights[z * padded + x] * _info.terrainHeight;
+				const bool	shore = height <= _info.seaLevel + 1;
+
+				for (int y = 0; y < padded; y++) {
+					const glm::ivec3	voxel = origin + glm::ivec3{x, y, z};
+					const float			depth = height - (float)voxel.y;
+
+					if (depth <= 0)
+						break;
+
+					// The lowest layer is never carved, so the world has a floor
+					if (_info.caveFrequency > 0 && voxel.y > 0
+						&& _noise.perlin3D(glm::vec3(voxel) * _info.caveFrequency) > _info.caveThreshold)
+						continue;
+
+					VoxelType	type = VoxelType::STONE;
+					if (depth <= 1)
+						type = shore ? VoxelType::SAND : VoxelType::GRASS;
+					else if (depth <= 4)
+						type = shore ? VoxelType::SAND : VoxelType::DIRT;
+
+					chunk.setVoxel({x - 1, y - 1, z - 1}, type);
+				}
+			}
+		}
+
+		std::shared_ptr<const PackedVoxelChunk>	packed = std::make_shared<const PackedVoxelChunk>(chunk);
+
+		_generationTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		_generatedChunks++;
+
+		return packed;
+	}
+
+	// Chunk holding a voxel, rounding toward negative infinity
+	glm::ivec3	VoxelWorld::_chunkOf(const glm::ivec3 &position) {
+		const auto	floorDiv = [](int v) { return (v >= 0 ? v : v - VoxelChunk::SIZE + 1) / VoxelChunk::SIZE; };
+
+		return {floorDiv(position.x), floorDiv(position.y), floorDiv(position.z)};
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the settings of the world
+	const VoxelWorldInfo &	VoxelWorld::getInfo() const {
+		return _info;
+	}
+
+	/// @brief Return the streaming and meshing counters
+	VoxelWorldStats	VoxelWorld::getStats() {
+		VoxelWorldStats	stats = {};
+
+		stats.loadedChunks = _chunks.size();
+		for (const auto &[position, entry] : _chunks) {
+			if (entry.chunk)
+				stats.chunkMemory += entry.chunk->getSize();
+			if (entry.indexCount) {
+				stats.drawnChunks++;
+				stats.triangles += entry.indexCount / 3;
+			}
+		}
+
+		stats.pendingJobs = _pool.getPendingCount();
+		{
+			std::lock_guard<std::mutex>	lock(_resultsMutex);
+			stats.pendingUploads = _results.size();
+		}
+
+		stats.generatedChunks = _generatedChunks.load();
+		stats.loadedFromDisk = _loadedChunks.load();
+		stats.meshedChunks = _meshedChunks.load();
+		stats.generationTime = (double)_generationTime.load() / 1e6;
+		stats.loadTime = (double)_loadTime.load() / 1e6;
+		stats.meshingTime = (double)_meshingTime.load() / 1e6;
+
+		return stats;
+	}
+
+	/// @brief Return the voxel at a world position
+	/// @return The voxel, AIR if its chunk is not generated
+	VoxelType	VoxelWorld::getVoxel(const glm::ivec3 &position) const {
+		const glm::ivec3	chunkPosition = _chunkOf(position);
+
+		auto	it = _chunks.find(chunkPosition);
+		if (it == _chunks.end() || !it->second.chunk)
+			return VoxelType::AIR;
+
+		return it->second.chunk->getVoxel(position - chunkPosition * VoxelChunk::SIZE);
+	}
+
+	# pragma endregion
+
+	# pragma region Setters
+
+	/// @brief Change the voxel at a world position and remesh the chunks showing it
+	/// @param position The world position
+	/// @param type The new voxel
+	/// @return false if the chunk is not generated, nothing is changed then
+	/// @note Neighbor chunks still being generated will not see the change on their border
+	bool	VoxelWorld::setVoxel(const glm::ivec3 &position, VoxelType type) {
+		const glm::ivec3	chunkPosition = _chunkOf(position);
+		const glm::ivec3	local = position - chunkPosition * VoxelChunk::SIZE;
+
+		auto	it = _chunks.find(chunkPosition);
+		if (it == _chunks.end() || !it->second.chunk)
+			return false;
+
+		if (it->second.chunk->getVoxel(local) == type)
+			return true;
+
+		// Repacked rather than modified, workers may still be meshing the previous chunk
+		const auto	edit = [this, type](const glm::ivec3 &chunkPosition, ChunkEntry &entry, const glm::ivec3 &local) {
+			VoxelChunk	chunk(chunkPosition);
+
+			entry.chunk->unpack(chunk);
+			chunk.setVoxel(local, type);
+			entry.chunk = std::make_shared<const PackedVoxelChunk>(chunk);
+			entry.dirty = true;
+			_submit(chunkPosition, entry, entry.chunk);
+		};
+
+		edit(chunkPosition, it->second, local);
+
+		// Voxels on a face are also in the border of the chunk behind that face
+		for (int axis = 0; axis < 3; axis++) {
+			if (local[axis] != 0 && local[axis] != VoxelChunk::SIZE - 1)
+				continue;
+
+			glm::ivec3	neighborPosition = chunkPosition;
+			glm::ivec3	neighborLocal = local;
+
+			neighborPosition[axis] += local[axis] ? 1 : -1;
+			neighborLocal[axis] = local[axis] ? -1 : VoxelChunk::SIZE;
+
+			auto	neighbor = _chunks.find(neighborPosition);
+			if (neighbor != _chunks.end() && neighbor->second.chunk)
+				edit(neighborPosition, neighbor->second, neighborLocal);
+		}
+
+		return true;
+	}
+
+	# pragma endregion
+
+} // namespace GE::Objects
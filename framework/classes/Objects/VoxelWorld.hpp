@@ -0,0 +1,178 @@
+#pragma once
+
+/// Includes
+# include "core/Logger.hpp"
+# include "VoxelChunk.hpp"
+# include "PackedVoxelChunk.hpp"
+# include "VoxelRegionStore.hpp"
+# include "Utils/NoiseGenerator.hpp"
+# include "Utils/FractalNoise.hpp"
+# include "Utils/ThreadPool.hpp"
+# include "OpenGL/BufferGL.hpp"
+
+/// System includes
+# include <atomic>
+# include <deque>
+# include <memory>
+# include <mutex>
+# include <string>
+# include <unordered_map>
+# include <vector>
+
+/// Dependencies
+# include <glad/glad.h>
+# include <glm/glm.hpp>
+
+namespace GE::Objects {
+
+	/// @brief Stores the settings of a VoxelWorld
+	struct VoxelWorldInfo {
+		uint64_t	seed            = 0;
+		int			viewDistance    = 8;	// Chunks loaded around the camera on the x and z axes
+		int			verticalChunks  = 4;	// Chunks stacked from y = 0, the world is verticalChunks * SIZE voxels high
+		size_t		uploadsPerFrame = 4;	// Meshes uploaded to the GPU by each update()
+		size_t		threadCount     = 0;	// Worker threads, 0 means one per hardware thread minus one
+		std::string	regionDirectory;		// Where chunks are saved when unloaded, empty keeps nothing on disk
+
+		Utils::FractalInfo	terrain       = {6, 1.0f / 256.0f};	// Heightmap, frequency in cycles per voxel
+		float				baseHeight    = 48.0f;				// Height of a 0 heightmap sample
+		float				terrainHeight = 40.0f;				// Height added by a 1 heightmap sample
+		float				seaLevel      = 44.0f;				// Shores below this height are sand
+		float				caveFrequency = 1.0f / 32.0f;		// 0 disables caves
+		float				caveThreshold = 0.45f;				// Solid voxels where perlin3D() is above are carved
+	};
+
+	/// @brief Streaming and meshing counters of a VoxelWorld
+	/// @note Meshing throughput per core is meshedChunks * 1000 / meshingTime chunks per second
+	/// @note Compare loadedFromDisk / loadTime with generatedChunks / generationTime to see what the region files save
+	struct VoxelWorldStats {
+		size_t	loadedChunks;		// Chunks kept around the camera, generated or not
+		size_t	drawnChunks;		// Chunks with a non-empty mesh on the GPU
+		size_t	pendingJobs;		// Chunks waiting for a worker
+		size_t	pendingUploads;		// Meshes waiting for the render thread
+		size_t	chunkMemory;		// Bytes of the compressed loaded chunks, VoxelChunk::PADDED_SIZE^3 each unpacked
+		size_t	generatedChunks;
+		size_t	loadedFromDisk;		// Chunks read from the region files instead of generated
+		size_t	meshedChunks;
+		double	generationTime;		// Milliseconds spent generating and packing, summed over all workers
+		double	loadTime;			// Milliseconds spent loading and unpacking, summed over all workers
+		double	meshingTime;		// Milliseconds spent meshing, summed over all workers
+		size_t	triangles;			// Triangles drawn by draw()
+	};
+
+	/**
+	 * @brief A chunked voxel terrain streamed around the camera.
+	 *
+	 * Chunks are filled from a NoiseGenerator (fractal heightmap, carved by 3D Perlin caves) and meshed with
+	 * greedy meshing on a ThreadPool. Finished meshes wait in a queue until update() uploads a few of them,
+	 * so loading never blocks the frame.
+	 *
+	 * Loaded chunks are kept as PackedVoxelChunk. With a region directory, generated and edited chunks are
+	 * saved when unloaded and read back from the region files next time instead of being generated again.
+	 *
+	 * Edits repack the chunk, apply the change and remesh the copy in the background, the previous mesh
+	 * is drawn until the new one is uploaded.
+	 *
+	 * Vertices are VoxelVertex in world space, bound as :
+	 *  - location 0 : vec3 position
+	 *  - location 1 : uint normal (see VoxelVertex)
+	 *  - location 2 : uint type (VoxelType)
+	 *
+	 * @note update(), draw() and the voxel accessors must be called from the thread owning the OpenGL context.
+	 * @note The VoxelWorld does not include shader management, bind your own shader before draw().
+	 */
+	class VoxelWorld {
+		public:
+			VoxelWorld(const VoxelWorldInfo &info = {}, Core::Logger *logger = nullptr);
+			~VoxelWorld();
+
+			VoxelWorld(const VoxelWorld &) = delete;
+			VoxelWorld &operator=(const VoxelWorld &) = delete;
+
+			/// Public functions
+
+			void	update(const glm::vec3 &cameraPosition);
+			void	draw();
+
+			/// Getters
+
+			const VoxelWorldInfo &	getInfo() const;
+			VoxelWorldStats			getStats();
+			VoxelType				getVoxel(const glm::ivec3 &position) const;
+
+			/// Setters
+
+			bool	setVoxel(const glm::ivec3 &position, VoxelType type);
+
+		private:
+			struct	ChunkPositionHash {
+				size_t	operator()(const glm::ivec3 &position) const {
+					size_t	hash = (size_t)(uint32_t)position.x * 0x85EBCA77u;
+					hash ^= (size_t)(uint32_t)position.y * 0xC2B2AE3Du + (hash << 6) + (hash >> 2);
+					hash ^= (size_t)(uint32_t)position.z * 0x27D4EB2Fu + (hash << 6) + (hash >> 2);
+					return hash;
+				}
+			};
+
+			// A loaded chunk, owned by the render thread
+			struct	ChunkEntry {
+				std::shared_ptr<const PackedVoxelChunk>	chunk;		// Null until generated, replaced on edit
+				uint64_t								version = 0;	// Tells the latest job from the stale ones
+				bool									dirty = false;	// Generated or edited, not in the region files yet
+				std::shared_ptr<std::atomic<bool>>		cancelled;		// Set on unload, queued jobs skip the chunk
+
+				GLuint									VAO = 0;
+				std::unique_ptr<OpenGL::BufferGL>		vertices;
+				std::unique_ptr<OpenGL::BufferGL>		indices;
+				GLsizei									indexCount = 0;
+			};
+
+			// A finished job, waiting for the render thread
+			struct	MeshResult {
+				glm::ivec3							position;
+				uint64_t							version;
+				std::shared_ptr<const PackedVoxelChunk>	chunk;
+				bool									generated;	// Not read from the region files
+				VoxelMesh								mesh;
+			};
+
+			VoxelWorldInfo			_info;
+			Utils::NoiseGenerator	_noise;
+			Utils::FractalNoise		_terrain;
+
+			std::unordered_map<glm::ivec3, ChunkEntry, ChunkPositionHash>	_chunks;
+			std::vector<glm::ivec2>	_loadOrder;		// Column offsets within the view distance, nearest first
+			glm::ivec2				_centerColumn = {0, 0};
+			bool					_centered = false;
+
+			std::mutex				_resultsMutex;
+			std::deque<MeshResult>	_results;
+
+			std::atomic<size_t>		_generatedChunks{0};
+			std::atomic<size_t>		_loadedChunks{0};
+			std::atomic<size_t>		_meshedChunks{0};
+			std::atomic<uint64_t>	_generationTime{0};	// Nanoseconds
+			std::atomic<uint64_t>	_loadTime{0};		// Nanoseconds
+			std::atomic<uint64_t>	_meshingTime{0};	// Nanoseconds
+
+			Core::Logger			*logger = nullptr;
+
+			std::unique_ptr<VoxelRegionStore>	_store;	// Null without a region directory, outlives the workers using it
+
+			Utils::ThreadPool		_pool;	// Last member, joined first on destruction
+
+			/// Private functions
+
+			void	_loadAround(const glm::ivec2 &column);
+			void	_unloadFar(const glm::ivec2 &column);
+			void	_submit(const glm::ivec3 &position, ChunkEntry &entry, std::shared_ptr<const PackedVoxelChunk> chunk);
+			bool	_save(ChunkEntry &entry);
+			void	_upload(ChunkEntry &entry, const VoxelMesh &mesh);
+			void	_release(ChunkEntry &entry);
+
+			std::shared_ptr<const PackedVoxelChunk>	_load(VoxelChunk &chunk);
+			std::shared_ptr<const PackedVoxelChunk>	_generate(VoxelChunk &chunk);
+
+			static glm::ivec3	_chunkOf(const glm::ivec3 &position);
+	};
+} // namespace GE::Objects
@@ -0,0 +1,273 @@
+#include "ContextCL.hpp"
+
+/// System includes
+# include <cerrno>
+# include <cstring>
+# include <fstream>
+# include <sstream>
+# include <stdexcept>
+
+/// Dependencies
+# include <glad/glad.h>
+# include <GL/glx.h>
+
+namespace GE::OpenCL {
+
+	# pragma region Constructors & Destructors
+
+	/// @param info The device type and the context options
+	/// @param logger The logger used to report the selected device
+	/// @throw std::runtime_error if no device of the requested type exists, or on any OpenCL error
+	ContextCL::ContextCL(const ContextCLInfo &info, Core::Logger *logger) : _info(info), _logger(logger) {
+		if (_logger) _logger->trace("Creating OpenCL context");
+
+		try {
+			_selectDevice();
+			_context = _createContext();
+			_queue = cl::CommandQueue(_context, _device, _info.profiling ? CL_QUEUE_PROFILING_ENABLE : 0);
+		}
+		catch (const cl::Error &e) {
+			throw std::runtime_error("OpenCL error : " + (std::string)e.what() + " (" + CLstrerrno(e.err()) + ")");
+		}
+
+		if (_logger) {
+			_logger->trace("OpenCL context created");
+			_logger->info("Using OpenCL device: " + _device.getInfo<CL_DEVICE_NAME>() + " (" + _platform.getInfo<CL_PLATFORM_NAME>() + ")");
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Public methods
+
+	/// @brief Build a program from source files
+	/// @param paths The files to load, concatenated in order
+	/// @param options The OpenCL compiler options
+	/// @return The built program
+	/// @throw std::runtime_error if a file can't be read, or with the build log if the build fails
+	cl::Program	ContextCL::buildProgram(const std::vector<std::string> &paths, const std::string &options) const {
+		cl::Program::Sources	sources;
+
+		for (const std::string &path : paths) {
+			std::ifstream		file(path);
+			std::stringstream	source;
+
+			if (!file.is_open())
+				throw std::runtime_error("Failed to open file " + path + " : " + (std::string)std::strerror(errno));
+
+			source << file.rdbuf();
+			sources.push_back(source.str());
+		}
+
+		return _build(sources, options);
+	}
+
+	/// @brief Build a program from a source string
+	/// @param source The OpenCL C source
+	/// @param options The OpenCL compiler options
+	/// @return The built program
+	/// @throw std::runtime_error with the build log if the build fails
+	cl::Program	ContextCL::buildProgramFromSource(const std::string &source, const std::string &options) const {
+		return _build({source}, options);
+	}
+
+	/// @brief Get the string representation of an OpenCL error
+	/// @param error The error code, e.g. cl::Error::err()
+	std::string	ContextCL::CLstrerrno(cl_int error) {
+		switch(error) {
+			// run-time and JIT compiler errors
+			case 0: return "CL_SUCCESS";
+			case -1: return "CL_DEVICE_NOT_FOUND";
+			case -2: return "CL_DEVICE_NOT_AVAILABLE";
+			case -3: return "CL_COMPILER_NOT_AVAILABLE";
+			case -4: return "CL_MEM_OBJECT_ALLOCATION_FAILURE";
+			case -5: return "CL_OUT_OF_RESOURCES";
+			case -6: return "CL_OUT_OF_HOST_MEMORY";
+			case -7: return "CL_PROFILING_INFO_NOT_AVAILABLE";
+			case -8: return "CL_MEM_COPY_OVERLAP";
+			case -9: return "CL_IMAGE_FORMAT_MISMATCH";
+			case -10: return "CL_IMAGE_FORMAT_NOT_SUPPORTED";
+			case -11: return "CL_BUILD_PROGRAM_FAILURE";
+			case -12: return "CL_MAP_FAILURE";
+			case -13: return "CL_MISALIGNED_SUB_BUFFER_OFFSET";
+			case -14: return "CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST";
+			case -15: return "CL_COMPILE_PROGRAM_FAILURE";
+			case -16: return "CL_LINKER_NOT_AVAILABLE";
+			case -17: return "CL_LINK_PROGRAM_FAILURE";
+			case -18: return "CL_DEVICE_PARTITION_FAILED";
+			case -19: return "CL_KERNEL_ARG_INFO_NOT_AVAILABLE";
+
+			// compile-time errors
+			case -30: return "CL_INVALID_VALUE";
+			case -31: return "CL_INVALID_DEVICE_TYPE";
+			case -32: return "CL_INVALID_PLATFORM";
+			case -33: return "CL_INVALID_DEVICE";
+			case -34: return "CL_INVALID_CONTEXT";
+			case -35: return "CL_INVALID_QUEUE_PROPERTIES";
+			case -36: return "CL_INVALID_COMMAND_QUEUE";
+			case -37: return "CL_INVALID_HOST_PTR";
+			case -38: return "CL_INVALID_MEM_OBJECT";
+			case -39: return "CL_INVALID_IMAGE_FORMAT_DESCRIPTOR";
+			case -40: return "CL_INVALID_IMAGE_SIZE";
+			case -41: return "CL_INVALID_SAMPLER";
+			case -42: return "CL_INVALID_BINARY";
+			case -43: return "CL_INVALID_BUILD_OPTIONS";
+			case -44: return "CL_INVALID_PROGRAM";
+			case -45: return "CL_INVALID_PROGRAM_EXECUTABLE";
+			case -46: return "CL_INVALID_KERNEL_NAME";
+			case -47: return "CL_INVALID_KERNEL_DEFINITION";
+			case -48: return "CL_INVALID_KERNEL";
+			case -49: return "CL_INVALID_ARG_INDEX";
+			case -50: return "CL_INVALID_ARG_VALUE";
+			case -51: return "CL_INVALID_ARG_SIZE";
+			case -52: return "CL_INVALID_KERNEL_ARGS";
+			case -53: return "CL_INVALID_WORK_DIMENSION";
+			case -54: return "CL_INVALID_WORK_GROUP_SIZE";
+			case -55: return "CL_INVALID_WORK_ITEM_SIZE";
+			case -56: return "CL_INVALID_GLOBAL_OFFSET";
+			case -57: return "CL_INVALID_EVENT_WAIT_LIST";
+			case -58: return "CL_INVALID_EVENT";
+			case -59: return "CL_INVALID_OPERATION";
+			case -60: return "CL_INVALID_GL_OBJECT";
+			case -61: return "CL_INVALID_BUFFER_SIZE";
+			case -62: return "CL_INVALID_MIP_LEVEL";
+			case -63: return "CL_INVALID_GLOBAL_WORK_SIZE";
+			case -64: return "CL_INVALID_PROPERTY";
+			case -65: return "CL_INVALID_IMAGE_DESCRIPTOR";
+			case -66: return "CL_INVALID_COMPILER_OPTIONS";
+			case -67: return "CL_INVALID_LINKER_OPTIONS";
+			case -68: return "CL_INVALID_DEVICE_PARTITION_COUNT";
+
+			// extension errors
+			case -1000: return "CL_INVALID_GL_SHAREGROUP_REFERENCE_KHR";
+			case -1001: return "CL_PLATFORM_NOT_FOUND_KHR";
+			case -1002: return "CL_INVALID_D3D10_DEVICE_KHR";
+			case -1003: return "CL_INVALID_D3D10_RESOURCE_KHR";
+			case -1004: return "CL_D3D10_RESOURCE_ALREADY_ACQUIRED_KHR";
+			case -1005: return "CL_D3D10_RESOURCE_NOT_ACQUIRED_KHR";
+			default: return "Unknown OpenCL error";
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Private methods
+
+	// Take the first device of the requested type, platforms without one are skipped
+	void	ContextCL::_selectDevice() {
+		std::vector<cl::Platform>	platforms;
+
+		cl::Platform::get(&platforms);
+		if (platforms.empty())
+			throw std::runtime_error("No OpenCL platforms found");
+
+		for (const cl::Platform &platform : platforms) {
+			std::vector<cl::Device>	devices;
+
+			// Platforms without a matching device report CL_DEVICE_NOT_FOUND
+			try {
+				platform.getDevices(_info.deviceType, &devices);
+			}
+			catch (const cl::Error &) {
+				continue;
+			}
+
+			if (!devices.empty()) {
+				_platform = platform;
+				_device = devices.front();
+				return;
+			}
+		}
+
+		throw std::runtime_error("No OpenCL devices found");
+	}
+
+	// Create an OpenCL context, with OpenGL interoperability based on the operating system if requested
+	cl::Context	ContextCL::_createContext() const {
+		if (!_info.shareWithOpenGL) {
+			cl_context_properties properties[] = {
+				CL_CONTEXT_PLATFORM, (cl_context_properties)(_platform)(),
+				0
+			};
+
+			return cl::Context(_device, properties);
+		}
+
+		#if defined(__linux__) || defined(__unix__)
+			cl_context_properties properties[] = { // Interoperability with OpenGL (Linux)
+				CL_GL_CONTEXT_KHR, (cl_context_properties)glXGetCurrentContext(),
+				CL_GLX_DISPLAY_KHR, (cl_context_properties)glXGetCurrentDisplay(),
+				CL_CONTEXT_PLATFORM, (cl_context_properties)(_platform)(),
+				0
+			};
+		#elif __APPLE__
+			cl_context_properties properties[] = { // Interoperability with OpenGL (MacOS)
+				CL_CONTEXT_PROPERTY_USE_CGL_SHAREGROUP_APPLE, (cl_context_properties)CGLGetShareGroup(CGLGetCurrentContext()),
+				0
+			};
+		#elif _WIN32
+			cl_context_properties properties[] = { // Interoperability with OpenGL (Windows)
+				CL_GL_CONTEXT_KHR, (cl_context_properties)wglGetCurrentContext(),
+				CL_WGL_HDC_KHR, (cl_context_properties)wglGetCurrentDC(),
+				CL_CONTEXT_PLATFORM, (cl_context_properties)(_platform)(),
+				0
+			};
+		#endif
+
+		return cl::Context(_device, properties);
+	}
+
+	cl::Program	ContextCL::_build(const cl::Program::Sources &sources, const std::string &options) const {
+		try {
+			cl::Program	program(_context, sources);
+
+			try {
+				program.build({_device}, options.c_str());
+			}
+			catch (const cl::Error &e) {
+				if (e.err() == CL_BUILD_PROGRAM_FAILURE) {
+					std::string log = program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(_device);
+					throw std::runtime_error("clBuildProgram (CL_BUILD_PROGRAM_FAILURE) :\n" + log);
+				}
+				throw;
+			}
+
+			return program;
+		}
+		catch (const cl::Error &e) {
+			throw std::runtime_error("OpenCL error : " + (std::string)e.what() + " (" + CLstrerrno(e.err()) + ")");
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the settings the context was created with
+	const ContextCLInfo &	ContextCL::getInfo() const {
+		return _info;
+	}
+
+	/// @brief Return the platform of the selected device
+	const cl::Platform &	ContextCL::getPlatform() const {
+		return _platform;
+	}
+
+	/// @brief Return the selected device
+	const cl::Device &	ContextCL::getDevice() const {
+		return _device;
+	}
+
+	/// @brief Return the OpenCL context
+	const cl::Context &	ContextCL::getContext() const {
+		return _context;
+	}
+
+	/// @brief Return the in-order command queue of the device
+	cl::CommandQueue &	ContextCL::getQueue() {
+		return _queue;
+	}
+
+	# pragma endregion
+
+} // namespace GE::OpenCL
@@ -0,0 +1,72 @@
+#pragma once
+
+/// Defines
+# define CL_HPP_TARGET_OPENCL_VERSION 300 // OpenCL 3.0
+# define CL_HPP_ENABLE_EXCEPTIONS
+
+/// Includes
+# include "core/Logger.hpp"
+
+/// System includes
+# include <string>
+# include <vector>
+
+/// Dependencies
+# include <OpenCL/opencl.hpp>
+# include <OpenCL/cl_gl.h>
+
+namespace GE::OpenCL {
+
+	/// @brief Stores the settings of a ContextCL
+	struct ContextCLInfo {
+		cl_device_type	deviceType      = CL_DEVICE_TYPE_GPU;	// CL_DEVICE_TYPE_CPU runs on a CPU runtime such as PoCL
+		bool			shareWithOpenGL = false;				// Needed by cl::BufferGL, requires a current OpenGL context
+		bool			profiling       = false;				// Create the queue with CL_QUEUE_PROFILING_ENABLE
+	};
+
+	/**
+	 * @brief Owns an OpenCL device, its context and an in-order command queue, and builds programs for them.
+	 *
+	 * The device is the first one of the requested type, searching every platform in order.
+	 *
+	 * @note Errors are reported as std::runtime_error, OpenCL ones prefixed with "OpenCL error :".
+	 * @note The queue is not thread-safe, enqueue from one thread at a time.
+	 */
+	class ContextCL {
+		public:
+			ContextCL(const ContextCLInfo &info = {}, Core::Logger *logger = nullptr);
+			~ContextCL() = default;
+
+			ContextCL(const ContextCL &) = delete;
+			ContextCL &operator=(const ContextCL &) = delete;
+
+			/// Public methods
+
+			cl::Program	buildProgram(const std::vector<std::string> &paths, const std::string &options = "") const;
+			cl::Program	buildProgramFromSource(const std::string &source, const std::string &options = "") const;
+
+			static std::string	CLstrerrno(cl_int error);
+
+			/// Getters
+
+			const ContextCLInfo &	getInfo() const;
+			const cl::Platform &	getPlatform() const;
+			const cl::Device &		getDevice() const;
+			const cl::Context &		getContext() const;
+			cl::CommandQueue &		getQueue();
+
+		private:
+			ContextCLInfo		_info;
+			cl::Platform		_platform;
+			cl::Device			_device;
+			cl::Context			_context;
+			cl::CommandQueue	_queue;
+			Core::Logger *		_logger;
+
+			/// Private methods
+
+			void		_selectDevice();
+			cl::Context	_createContext() const;
+			cl::Program	_build(const cl::Program::Sources &sources, const std::string &options) const;
+	};
+} // namespace GE::OpenCL
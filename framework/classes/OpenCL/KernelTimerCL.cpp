@@ -0,0 +1,120 @@
+#include "KernelTimerCL.hpp"
+
+/// System includes
+# include <algorithm>
+# include <cstring>
+
+namespace GE::OpenCL {
+
+	# pragma region Constructors & Destructors
+
+	/// @param enabled Whether to track the enqueues, ContextCLInfo::profiling of the queue they go to
+	KernelTimerCL::KernelTimerCL(bool enabled) : _enabled(enabled) {}
+
+	# pragma endregion
+
+	# pragma region Public methods
+
+	/// @brief Track an enqueue : pass the returned event as its last argument
+	/// @param name The kernel name in the timings, a string literal or __func__
+	/// @return The event to fill, nullptr if disabled
+	cl::Event *	KernelTimerCL::track(const char *name) {
+		if (!_enabled)
+			return nullptr;
+
+		_pending.push_back({name, cl::Event(), Core::Profiler::now()});
+		return &_pending.back().event;
+	}
+
+	/// @brief Read the tracked enqueues the device completed, without waiting
+	/// @return The number of enqueues read
+	size_t	KernelTimerCL::poll() {
+		size_t	read = 0;
+
+		// The queue is in order, the first enqueue not completed holds back the next ones
+		while (!_pending.empty()) {
+			const Pending &	pending = _pending.front();
+
+			// A failed enqueue left its event empty
+			if (pending.event()) {
+				const cl_int	status = pending.event.getInfo<CL_EVENT_COMMAND_EXECUTION_STATUS>();
+
+				if (status > CL_COMPLETE)
+					break;
+				if (status == CL_COMPLETE) {
+					_record(pending);
+					read++;
+				}
+			}
+			_pending.pop_front();
+		}
+		return read;
+	}
+
+	/// @brief Wait for every tracked enqueue and read them
+	void	KernelTimerCL::finish() {
+		for (const Pending &pending : _pending)
+			if (pending.event())
+				pending.event.wait();
+		poll();
+	}
+
+	/// @brief Forget the timings, the tracked enqueues are still read
+	void	KernelTimerCL::clear() {
+		_timings.clear();
+	}
+
+	# pragma endregion
+
+	# pragma region Private methods
+
+	// Add a completed enqueue to the timings
+	void	KernelTimerCL::_record(const Pending &pending) {
+		cl_ulong	queued, start, end;
+
+		try {
+			queued = pending.event.getProfilingInfo<CL_PROFILING_COMMAND_QUEUED>();
+			start = pending.event.getProfilingInfo<CL_PROFILING_COMMAND_START>();
+			end = pending.event.getProfilingInfo<CL_PROFILING_COMMAND_END>();
+		}
+		catch (const cl::Error &) {
+			return;	// The queue was created without profiling
+		}
+
+		const double	time = (end - start) / 1e6;
+		const double	delay = (start - queued) / 1e6;
+
+		auto timing = std::find_if(_timings.begin(), _timings.end(), [&](const KernelTiming &timing) {
+			return !std::strcmp(timing.name, pending.name);
+		});
+		if (timing == _timings.end())
+			timing = _timings.insert(_timings.end(), {pending.name, 0, 0, 0, 0, 0});
+
+		timing->calls++;
+		timing->total += time;
+		timing->last = time;
+		timing->max = std::max(timing->max, time);
+		timing->queued += delay;
+
+		#ifdef GE_ENABLE_PROFILING
+			Core::Profiler::getInstance().recordGPU("OpenCL", pending.name, pending.issued, time, 0, delay);
+		#endif
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the timings per kernel name, in the order they were first read
+	const std::vector<KernelTiming> &	KernelTimerCL::getTimings() const {
+		return _timings;
+	}
+
+	/// @brief Return the number of tracked enqueues not read yet
+	size_t	KernelTimerCL::getPendingCount() const {
+		return _pending.size();
+	}
+
+	# pragma endregion
+
+} // namespace GE::OpenCL
@@ -0,0 +1,78 @@
+#pragma once
+
+/// Includes
+# include "ContextCL.hpp"
+# include "core/Profiler.hpp"
+
+/// System includes
+# include <cstdint>
+# include <deque>
+# include <vector>
+
+// Event of a timed enqueue, nullptr unless GE_ENABLE_PROFILING is defined, see core/Profiler.hpp
+# ifdef GE_ENABLE_PROFILING
+#  define GE_PROFILE_KERNEL(timer, name)	(timer).track(name)
+# else
+#  define GE_PROFILE_KERNEL(timer, name)	nullptr
+# endif
+
+namespace GE::OpenCL {
+
+	/// @brief The device times of a kernel, since the KernelTimerCL creation or its last clear()
+	struct KernelTiming {
+		const char *	name;
+		uint32_t		calls;
+		double			total;	// Milliseconds from start to end of the executions
+		double			last;
+		double			max;
+		double			queued;	// Milliseconds waited in the queue, summed
+	};
+
+	/**
+	 * @brief Collects the profiling timestamps of the kernels enqueued on a ContextCL created with profiling enabled.
+	 *
+	 * track() returns the event to give to the enqueue, and poll() reads the events the device completed, without
+	 * waiting for the others.
+	 *
+	 * With GE_ENABLE_PROFILING, the results are also sent to the Core::Profiler, in the "OpenCL" track of the frame breakdown.
+	 *
+	 * @note Without ContextCLInfo::profiling, the events carry no timestamps : track() returns nullptr when disabled.
+	 * @note Not thread-safe, like the queue of the ContextCL.
+	 */
+	class KernelTimerCL {
+		public:
+			explicit KernelTimerCL(bool enabled = true);
+			~KernelTimerCL() = default;
+
+			KernelTimerCL(const KernelTimerCL &) = delete;
+			KernelTimerCL &operator=(const KernelTimerCL &) = delete;
+
+			/// Public methods
+
+			cl::Event *	track(const char *name);
+			size_t		poll();
+			void		finish();
+			void		clear();
+
+			/// Getters
+
+			const std::vector<KernelTiming> &	getTimings() const;
+			size_t								getPendingCount() const;
+
+		private:
+			// An enqueue whose event is not read yet
+			struct Pending {
+				const char *	name;
+				cl::Event		event;
+				uint64_t		issued;	// Core::Profiler::now() at track()
+			};
+
+			bool						_enabled;
+			std::deque<Pending>			_pending;	// Enqueue order, stable addresses for the events
+			std::vector<KernelTiming>	_timings;
+
+			/// Private methods
+
+			void	_record(const Pending &pending);
+	};
+} // namespace GE::OpenCL
@@ -0,0 +1,461 @@
+#include "NoiseGeneratorCL.hpp"
+
+/// Includes
+# include "core/Profiler.hpp"
+
+/// System includes
+# include <stdexcept>
+# include <string>
+
+namespace GE::OpenCL {
+
+	// Kernel functions, must match the defines of the kernel
+	enum	KernelFunction {
+		KERNEL_PERLIN2D,
+		KERNEL_PERLIN3D_GRADIENT,
+		KERNEL_PERLIN3D_COMPOSITE,
+		KERNEL_SIMPLEX2D,
+		KERNEL_SIMPLEX3D
+	};
+
+	// Port of Utils::NoiseGenerator and of the octave loop of Utils::FractalNoise, keep them in sync
+	// Expressions are written in the same order as the CPU code so both round the same way
+	static const char *	noiseKernelSource = R"CL(
+		#pragma OPENCL FP_CONTRACT OFF
+
+		#ifdef cl_khr_fp64
+			#pragma OPENCL EXTENSION cl_khr_fp64 : enable
+		#endif
+
+		#define PERLIN2D			0
+		#define PERLIN3D_GRADIENT	1
+		#define PERLIN3D_COMPOSITE	2
+		#define SIMPLEX2D			3
+		#define SIMPLEX3D			4
+
+		#define FBM		0
+		#define RIDGED	1
+		#define BILLOW	2
+
+		constant float	gradients3D[16][3] = {
+			{ 1, 1, 0}, {-1, 1, 0}, { 1,-1, 0}, {-1,-1, 0},
+			{ 1, 0, 1}, {-1, 0, 1}, { 1, 0,-1}, {-1, 0,-1},
+			{ 0, 1, 1}, { 0,-1, 1}, { 0, 1,-1}, { 0,-1,-1},
+			{ 1, 1, 0}, {-1, 1, 0}, { 0,-1, 1}, { 0,-1,-1}
+		};
+
+		int	fastFloor(float v) {
+			const int	i = (int)v;
+			return (v < (float)i) ? i - 1 : i;
+		}
+
+		float	dot3(constant const float *g, float x, float y, float z) {
+			return g[0] * x + g[1] * y + g[2] * z;
+		}
+
+		// 2D Perlin noise
+
+		void	perlin2DGradient(int x, int y, uint seed, float *gx, float *gy) {
+			uint	a = (uint)x + seed, b = (uint)y + seed;
+
+			a *= 3284157443u;
+			b ^= a << 16 | a >> 16;
+			b *= 1911520717u;
+			a ^= b << 16 | b >> 16;
+			a *= 2048419325u;
+
+			#ifdef cl_khr_fp64
+				const float	random = (float)(a * (M_PI / 2147483648.0));
+				*gx = (float)sin((double)random);
+				*gy = (float)cos((double)random);
+			#else
+				const float	random = (float)a * (M_PI_F / 2147483648.0f);
+				*gx = sin(random);
+				*gy = cos(random);
+			#endif
+		}
+
+		float	perlin2DDot(int cx, int cy, float x, float y, uint seed) {
+			float	gx, gy;
+
+			perlin2DGradient(cx, cy, seed, &gx, &gy);
+			return (x - (float)cx) * gx + (y - (float)cy) * gy;
+		}
+
+		float	perlin2DInterpolate(float a, float b, float weight) {
+			return (b - a) * (3.0f - weight * 2.0f) * weight * weight + a;
+		}
+
+		float	perlin2D(float x, float y, uint seed) {
+			const int	left = (int)x, right = (int)(x + 1);
+			const int	top = (int)y, bottom = (int)(y + 1);
+			const float	wx = x - (float)left, wy = y - (float)top;
+
+			return perlin2DInterpolate(
+				perlin2DInterpolate(perlin2DDot(left, top, x, y, seed), perlin2DDot(right, top, x, y, seed), wx),
+				perlin2DInterpolate(perlin2DDot(left, bottom, x, y, seed), perlin2DDot(right, bottom, x, y, seed), wx),
+				wy
+			);
+		}
+
+		// 3D Perlin noise
+
+		float	fade(float t) {
+			return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+		}
+
+		float	interpolate(float a, float b, float t) {
+			return a + t * (b - a);
+		}
+
+		float	perlin3DGradient(float vx, float vy, float vz, global const uchar *p) {
+			const int	fx = fastFloor(vx), fy = fastFloor(vy), fz = fastFloor(vz);
+			const int	X = fx & 255, Y = fy & 255, Z = fz & 255;
+			const float	x = vx - (float)fx, y = vy - (float)fy, z = vz - (float)fz;
+			const float	u = fade(x), w = fade(y), s = fade(z);
+
+			const int	A  = p[X] + Y,     B  = p[X + 1] + Y;
+			const int	AA = p[A] + Z,     AB = p[A + 1] + Z;
+			const int	BA = p[B] + Z,     BB = p[B + 1] + Z;
+
+			return interpolate(
+				interpolate(
+					interpolate(dot3(gradients3D[p[AA] & 15], x, y, z),        dot3(gradients3D[p[BA] & 15], x - 1, y, z), u),
+					interpolate(dot3(gradients3D[p[AB] & 15], x, y - 1, z),    dot3(gradients3D[p[BB] & 15], x - 1, y - 1, z), u),
+				w),
+				interpolate(
+					interpolate(dot3(gradients3D[p[AA + 1] & 15], x, y, z - 1),     dot3(gradients3D[p[BA + 1] & 15], x - 1, y, z - 1), u),
+					interpolate(dot3(gradients3D[p[AB + 1] & 15], x, y - 1, z - 1), dot3(gradients3D[p[BB + 1] & 15], x - 1, y - 1, z - 1), u),
+				w),
+			s);
+		}
+
+		float	perlin3DComposite(float x, float y, float z, uint seed) {
+			const float	ab = perlin2D(x, y, seed);
+			const float	bc = perlin2D(y, z, seed);
+			const float	ac = perlin2D(x, z, seed);
+
+			const float	ba = perlin2D(y, x, seed);
+			const float	cb = perlin2D(z, y, seed);
+			const float	ca = perlin2D(z, x, seed);
+
+			const float	abc = ab + bc + ac + ba + cb + ca;
+			return (abc / 6.0f);
+		}
+
+		// Simplex noise
+
+		float	simplex2DCorner(constant const float *g, float x, float y) {
+			float	t = 0.5f - x * x - y * y;
+			if (t < 0)
+				return 0.0f;
+			t *= t;
+			return t * t * (g[0] * x + g[1] * y);
+		}
+
+		float	simplex2D(float vx, float vy, global const uchar *p) {
+			const float	F2 = 0.36602540378f;
+			const float	G2 = 0.21132486540f;
+
+			const float	s = (vx + vy) * F2;
+			const int	i = fastFloor(vx + s);
+			const int	j = fastFloor(vy + s);
+			const float	t = (float)(i + j) * G2;
+			const float	x0 = vx - ((float)i - t);
+			const float	y0 = vy - ((float)j - t);
+
+			const int	i1 = x0 > y0 ? 1 : 0;
+			const int	j1 = 1 - i1;
+
+			const float	x1 = x0 - (float)i1 + G2,		y1 = y0 - (float)j1 + G2;
+			const float	x2 = x0 - 1.0f + 2.0f * G2,		y2 = y0 - 1.0f + 2.0f * G2;
+
+			const int	ii = i & 255, jj = j & 255;
+			constant const float	*g0 = gradients3D[p[ii + p[jj]] & 15];
+			constant const float	*g1 = gradients3D[p[ii + i1 + p[jj + j1]] & 15];
+			constant const float	*g2 = gradients3D[p[ii + 1 + p[jj + 1]] & 15];
+
+			return 70.0f * (simplex2DCorner(g0, x0, y0) + simplex2DCorner(g1, x1, y1) + simplex2DCorner(g2, x2, y2));
+		}
+
+		float	simplex3DCorner(constant const float *g, float x, float y, float z) {
+			float	t = 0.5f - x * x - y * y - z * z;
+			if (t < 0)
+				return 0.0f;
+			t *= t;
+			return t * t * dot3(g, x, y, z);
+		}
+
+		float	simplex3D(float vx, float vy, float vz, global const uchar *p) {
+			const float	F3 = 1.0f / 3.0f;
+			const float	G3 = 1.0f / 6.0f;
+
+			const float	s = (vx + vy + vz) * F3;
+			const int	i = fastFloor(vx + s);
+			const int	j = fastFloor(vy + s);
+			const int	k = fastFloor(vz + s);
+			const float	t = (float)(i + j + k) * G3;
+			const float	x0 = vx - ((float)i - t);
+			const float	y0 = vy - ((float)j - t);
+			const float	z0 = vz - ((float)k - t);
+
+			int	i1, j1, k1, i2, j2, k2;
+			if (x0 >= y0) {
+				if (y0 >= z0)		{ i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+				else if (x0 >= z0)	{ i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 0; k2 = 1; }
+				else				{ i1 = 0; j1 = 0; k1 = 1; i2 = 1; j2 = 0; k2 = 1; }
+			}
+			else {
+				if (y0 < z0)		{ i1 = 0; j1 = 0; k1 = 1; i2 = 0; j2 = 1; k2 = 1; }
+				else if (x0 < z0)	{ i1 = 0; j1 = 1; k1 = 0; i2 = 0; j2 = 1; k2 = 1; }
+				else				{ i1 = 0; j1 = 1; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+			}
+
+			const float	x1 = x0 - (float)i1 + G3,			y1 = y0 - (float)j1 + G3,			z1 = z0 - (float)k1 + G3;
+			const float	x2 = x0 - (float)i2 + 2.0f * G3,	y2 = y0 - (float)j2 + 2.0f * G3,	z2 = z0 - (float)k2 + 2.0f * G3;
+			const float	x3 = x0 - 1.0f + 3.0f * G3,			y3 = y0 - 1.0f + 3.0f * G3,			z3 = z0 - 1.0f + 3.0f * G3;
+
+			const int	ii = i & 255, jj = j & 255, kk = k & 255;
+			constant const float	*g0 = gradients3D[p[ii + p[jj + p[kk]]] & 15];
+			constant const float	*g1 = gradients3D[p[ii + i1 + p[jj + j1 + p[kk + k1]]] & 15];
+			constant const float	*g2 = gradients3D[p[ii + i2 + p[jj + j2 + p[kk + k2]]] & 15];
+			constant const float	*g3 = gradients3D[p[ii + 1 + p[jj + 1 + p[kk + 1]]] & 15];
+
+			return 76.0f * (simplex3DCorner(g0, x0, y0, z0) + simplex3DCorner(g1, x1, y1, z1) + simplex3DCorner(g2, x2, y2, z2) + simplex3DCorner(g3, x3, y3, z3));
+		}
+
+		float	basis(int function, float x, float y, float z, global const uchar *permutation, uint latticeSeed) {
+			switch (function) {
+				case PERLIN2D:				return perlin2D(x, y, latticeSeed);
+				case PERLIN3D_GRADIENT:		return perlin3DGradient(x, y, z, permutation);
+				case PERLIN3D_COMPOSITE:	return perlin3DComposite(x, y, z, latticeSeed);
+				case SIMPLEX2D:				return simplex2D(x, y, permutation);
+				default:					return simplex3D(x, y, z, permutation);
+			}
+		}
+
+		// One work-item per sample, plain noise is a single FBM octave of frequency 1
+		kernel void	fill(
+			global float *out,
+			global const uchar *permutation,
+			uint latticeSeed,
+			int function,
+			float originX, float originY, float originZ,
+			float stepX, float stepY, float stepZ,
+			int octaves,
+			float frequency,
+			float lacunarity,
+			float gain,
+			int type,
+			float ridgeOffset,
+			float ridgeWeight,
+			float normalization
+		) {
+			const size_t	x = get_global_id(0), y = get_global_id(1), z = get_global_id(2);
+			const float		px = originX + (float)x * stepX;
+			const float		py = originY + (float)y * stepY;
+			const float		pz = originZ + (float)z * stepZ;
+
+			float	sum = 0, amplitude = 1, weight = 1;
+
+			for (int octave = 0; octave < octaves; octave++) {
+				const float	n = basis(
+					function,
+					px * frequency + 31.416f * (float)octave,
+					py * frequency + 17.728f * (float)octave,
+					pz * frequency + 23.173f * (float)octave,
+					permutation,
+					latticeSeed
+				);
+
+				if (type == BILLOW)
+					sum += (2.0f * fabs(n) - 1.0f) * amplitude;
+				else if (type == RIDGED) {
+					float	signal = ridgeOffset - fabs(n);
+
+					signal *= signal * weight;
+					weight = clamp(signal * ridgeWeight, 0.0f, 1.0f);
+					sum += signal * amplitude;
+				}
+				else
+					sum += n * amplitude;
+
+				if (weight <= 0)
+					break;
+
+				amplitude *= gain;
+				frequency *= lacunarity;
+			}
+
+			out[(z * get_global_size(1) + y) * get_global_size(0) + x] = (type == RIDGED)
+				? sum * normalization * 2.0f - 1.0f
+				: sum * normalization;
+		}
+	)CL";
+
+	# pragma region Constructors & Destructors
+
+	/// @param context The context to build the kernel for and to dispatch on, it must outlive the generator
+	/// @throw std::runtime_error if the kernel fails to build
+	NoiseGeneratorCL::NoiseGeneratorCL(ContextCL &context) : _context(context), _timer(context.getInfo().profiling) {
+		_program = _context.buildProgramFromSource(noiseKernelSource);
+
+		try {
+			_kernel = cl::Kernel(_program, "fill");
+			_permutation = cl::Buffer(_context.getContext(), CL_MEM_READ_ONLY, 512 * sizeof(uint8_t));
+		}
+		catch (const cl::Error &e) {
+			throw std::runtime_error("OpenCL error : " + (std::string)e.what() + " (" + ContextCL::CLstrerrno(e.err()) + ")");
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Public methods
+
+	/// @brief Fill a grid or a volume with a noise of the generator, in one dispatch
+	/// @param out The destination, count.x * count.y * count.z floats
+	/// @param noise The generator to reproduce
+	/// @param function The noise to evaluate, 2D functions ignore z
+	/// @param origin The noise coordinates of the first sample
+	/// @param step The distance between two samples on each axis
+	/// @param count The number of samples on each axis
+	/// @throw std::runtime_error on any OpenCL error
+	void	NoiseGeneratorCL::fill(float *out, const Utils::NoiseGenerator &noise, Function function, const glm::vec3 &origin, const glm::vec3 &step, const glm::uvec3 &count) {
+		int	kernelFunction;
+
+		switch (function) {
+			case Function::PERLIN2D:	kernelFunction = KERNEL_PERLIN2D;	break;
+			case Function::SIMPLEX2D:	kernelFunction = KERNEL_SIMPLEX2D;	break;
+			case Function::SIMPLEX3D:	kernelFunction = KERNEL_SIMPLEX3D;	break;
+			default:
+				kernelFunction = (noise.getPerlin3DMode() == Utils::NoiseGenerator::Perlin3DMode::GRADIENT)
+					? KERNEL_PERLIN3D_GRADIENT
+					: KERNEL_PERLIN3D_COMPOSITE;
+				break;
+		}
+
+		_dispatch(out, noise, kernelFunction, origin, step, count, {1, 1, 1, 1, (int)Utils::FractalNoise::Type::FBM, 0, 0, 1});
+	}
+
+	/// @brief Fill a grid with FractalNoise::sample2D(), in one dispatch
+	/// @param out The destination, count.x * count.y floats
+	/// @param fractal The fractal to reproduce, with its generator
+	/// @param origin The position of the first sample
+	/// @param step The distance between two samples on each axis
+	/// @param count The number of samples on each axis
+	/// @throw std::runtime_error on any OpenCL error
+	void	NoiseGeneratorCL::fillFractal2D(float *out, const Utils::FractalNoise &fractal, const glm::vec2 &origin, const glm::vec2 &step, const glm::uvec2 &count) {
+		const int	kernelFunction = (fractal.getBasis() == Utils::FractalNoise::Basis::PERLIN) ? KERNEL_PERLIN2D : KERNEL_SIMPLEX2D;
+		const Utils::FractalInfo &	info = fractal.getInfo();
+
+		_dispatch(out, fractal.getNoise(), kernelFunction, {origin, 0}, {step, 0}, {count, 1}, {
+			fractal.getActiveOctaves(), info.frequency, info.lacunarity, info.gain,
+			(int)fractal.getType(), info.ridgeOffset, info.ridgeWeight, fractal.getNormalization()
+		});
+	}
+
+	/// @brief Fill a volume with FractalNoise::sample3D(), in one dispatch
+	/// @param out The destination, count.x * count.y * count.z floats
+	/// @param fractal The fractal to reproduce, with its generator
+	/// @param origin The position of the first sample
+	/// @param step The distance between two samples on each axis
+	/// @param count The number of samples on each axis
+	/// @throw std::runtime_error on any OpenCL error
+	void	NoiseGeneratorCL::fillFractal3D(float *out, const Utils::FractalNoise &fractal, const glm::vec3 &origin, const glm::vec3 &step, const glm::uvec3 &count) {
+		const Utils::NoiseGenerator &	noise = fractal.getNoise();
+		const Utils::FractalInfo &		info = fractal.getInfo();
+		int								kernelFunction = KERNEL_SIMPLEX3D;
+
+		if (fractal.getBasis() == Utils::FractalNoise::Basis::PERLIN)
+			kernelFunction = (noise.getPerlin3DMode() == Utils::NoiseGenerator::Perlin3DMode::GRADIENT)
+				? KERNEL_PERLIN3D_GRADIENT
+				: KERNEL_PERLIN3D_COMPOSITE;
+
+		_dispatch(out, noise, kernelFunction, origin, step, count, {
+			fractal.getActiveOctaves(), info.frequency, info.lacunarity, info.gain,
+			(int)fractal.getType(), info.ridgeOffset, info.ridgeWeight, fractal.getNormalization()
+		});
+	}
+
+	# pragma endregion
+
+	# pragma region Private methods
+
+	// The permutation table only depends on the seed, skip the upload when it did not change
+	void	NoiseGeneratorCL::_upload(const Utils::NoiseGenerator &noise) {
+		if (_uploaded && _uploadedSeed == noise.getSeed())
+			return;
+
+		_context.getQueue().enqueueWriteBuffer(_permutation, CL_TRUE, 0, 512 * sizeof(uint8_t), noise.getPermutation().data());
+		_uploadedSeed = noise.getSeed();
+		_uploaded = true;
+	}
+
+	void	NoiseGeneratorCL::_dispatch(
+		float *out,
+		const Utils::NoiseGenerator &noise,
+		int function,
+		const glm::vec3 &origin,
+		const glm::vec3 &step,
+		const glm::uvec3 &count,
+		const Octaves &octaves
+	) {
+		GE_PROFILE_SCOPE("NoiseGeneratorCL::dispatch");
+
+		const size_t	samples = (size_t)count.x * count.y * count.z;
+		if (!out || !samples)
+			return;
+
+		try {
+			cl::CommandQueue &	queue = _context.getQueue();
+
+			_upload(noise);
+
+			// The output buffer only grows, chunks usually share one size
+			if (samples > _outputCapacity) {
+				_output = cl::Buffer(_context.getContext(), CL_MEM_WRITE_ONLY, samples * sizeof(float));
+				_outputCapacity = samples;
+			}
+
+			cl_uint	index = 0;
+			_kernel.setArg(index++, _output);
+			_kernel.setArg(index++, _permutation);
+			_kernel.setArg(index++, (cl_uint)noise.getLatticeSeed());
+			_kernel.setArg(index++, (cl_int)function);
+			_kernel.setArg(index++, origin.x);
+			_kernel.setArg(index++, origin.y);
+			_kernel.setArg(index++, origin.z);
+			_kernel.setArg(index++, step.x);
+			_kernel.setArg(index++, step.y);
+			_kernel.setArg(index++, step.z);
+			_kernel.setArg(index++, (cl_int)octaves.count);
+			_kernel.setArg(index++, octaves.frequency);
+			_kernel.setArg(index++, octaves.lacunarity);
+			_kernel.setArg(index++, octaves.gain);
+			_kernel.setArg(index++, (cl_int)octaves.type);
+			_kernel.setArg(index++, octaves.ridgeOffset);
+			_kernel.setArg(index++, octaves.ridgeWeight);
+			_kernel.setArg(index++, octaves.normalization);
+
+			queue.enqueueNDRangeKernel(_kernel, cl::NullRange, cl::NDRange(count.x, count.y, count.z), cl::NullRange, nullptr, GE_PROFILE_KERNEL(_timer, "NoiseGeneratorCL::fill"));
+			queue.enqueueReadBuffer(_output, CL_TRUE, 0, samples * sizeof(float), out);
+			_timer.poll();
+		}
+		catch (const cl::Error &e) {
+			throw std::runtime_error("OpenCL error : " + (std::string)e.what() + " (" + ContextCL::CLstrerrno(e.err()) + ")");
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the device times of the dispatches, filled with GE_ENABLE_PROFILING on a context created with profiling
+	const KernelTimerCL &	NoiseGeneratorCL::getKernelTimer() const {
+		return _timer;
+	}
+
+	# pragma endregion
+
+} // namespace GE::OpenCL
@@ -0,0 +1,113 @@
+#pragma once
+
+/// Includes
+# include "ContextCL.hpp"
+# include "KernelTimerCL.hpp"
+# include "Utils/NoiseGenerator.hpp"
+# include "Utils/FractalNoise.hpp"
+
+/// System includes
+# include <cstdint>
+
+/// Dependencies
+# include <glm/glm.hpp>
+
+namespace GE::OpenCL {
+	/**
+	 * @brief Runs the Utils::NoiseGenerator algorithms as an OpenCL kernel, filling a whole grid or volume in one dispatch.
+	 *
+	 * Samples are stored x first, then y, then z, at origin + (x, y, z) * step.
+	 *
+	 * The kernel mirrors the CPU code operation by operation, with the permutation table and lattice seed
+	 * of the generator uploaded, and floating-point contraction disabled. Compared to the CPU functions :
+	 * - 3D Perlin (GRADIENT) and Simplex are bit-exact, unless the host is built with fast-math (error < 1e-5)
+	 * - 2D Perlin and the LEGACY_COMPOSITE 3D Perlin go through sin() / cos(), in double when the device has cl_khr_fp64, error < 1e-5
+	 * - Fractals sum these errors over the octaves, error < 1e-4
+	 *
+	 * @note Runs on any device of the ContextCL, including CPU runtimes such as PoCL.
+	 * @note Dispatches are blocking and go through the context queue, use one instance per thread.
+	 */
+	class NoiseGeneratorCL {
+		public:
+			// Noise evaluated at each sample
+			enum class Function {
+				PERLIN2D,
+				PERLIN3D,	// Follows the Perlin3DMode of the generator
+				SIMPLEX2D,
+				SIMPLEX3D
+			};
+
+			NoiseGeneratorCL(ContextCL &context);
+			~NoiseGeneratorCL() = default;
+
+			NoiseGeneratorCL(const NoiseGeneratorCL &) = delete;
+			NoiseGeneratorCL &operator=(const NoiseGeneratorCL &) = delete;
+
+			/// Public methods
+
+			void	fill(
+				float *out,
+				const Utils::NoiseGenerator &noise,
+				Function function,
+				const glm::vec3 &origin,
+				const glm::vec3 &step,
+				const glm::uvec3 &count
+			);
+
+			void	fillFractal2D(
+				float *out,
+				const Utils::FractalNoise &fractal,
+				const glm::vec2 &origin,
+				const glm::vec2 &step,
+				const glm::uvec2 &count
+			);
+
+			void	fillFractal3D(
+				float *out,
+				const Utils::FractalNoise &fractal,
+				const glm::vec3 &origin,
+				const glm::vec3 &step,
+				const glm::uvec3 &count
+			);
+
+			/// Getters
+
+			const KernelTimerCL &	getKernelTimer() const;
+
+		private:
+			// Octave settings of a dispatch, a single FBM octave for plain noise
+			struct	Octaves {
+				int		count;
+				float	frequency;
+				float	lacunarity;
+				float	gain;
+				int		type;
+				float	ridgeOffset;
+				float	ridgeWeight;
+				float	normalization;
+			};
+
+			ContextCL &		_context;
+			cl::Program		_program;
+			cl::Kernel		_kernel;
+			cl::Buffer		_permutation;
+			cl::Buffer		_output;
+			size_t			_outputCapacity = 0;	// Floats
+			uint64_t		_uploadedSeed = 0;
+			bool			_uploaded = false;
+			KernelTimerCL	_timer;		// Dispatch device times, with GE_ENABLE_PROFILING on a profiling context
+
+			/// Private methods
+
+			void	_upload(const Utils::NoiseGenerator &noise);
+			void	_dispatch(
+				float *out,
+				const Utils::NoiseGenerator &noise,
+				int function,
+				const glm::vec3 &origin,
+				const glm::vec3 &step,
+				const glm::uvec3 &count,
+				const Octaves &octaves
+			);
+	};
+} // namespace GE::OpenCL
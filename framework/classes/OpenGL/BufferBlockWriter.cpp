@@ -0,0 +1,164 @@
+#include "BufferBlockWriter.hpp"
+
+/// System includes
+# include <algorithm>
+# include <cstring>
+
+namespace GE::OpenGL {
+
+	static size_t	alignUp(size_t value, size_t alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	# pragma region Constructors & Destructors
+
+	BufferBlockWriter::BufferBlockWriter(BlockLayout layout) : _layout(layout) {}
+
+	# pragma endregion
+
+	# pragma region Public functions
+
+	/// @brief Append a float member
+	/// @return The offset of the member in the block
+	size_t	BufferBlockWriter::write(float value) {
+		return _append(&value, sizeof(float), 4);
+	}
+
+	/// @brief Append an int (or bool) member
+	/// @return The offset of the member in the block
+	size_t	BufferBlockWriter::write(int32_t value) {
+		return _append(&value, sizeof(int32_t), 4);
+	}
+
+	/// @brief Append a uint member
+	/// @return The offset of the member in the block
+	size_t	BufferBlockWriter::write(uint32_t value) {
+		return _append(&value, sizeof(uint32_t), 4);
+	}
+
+	/// @brief Append a vec2 member
+	/// @return The offset of the member in the block
+	size_t	BufferBlockWriter::write(const glm::vec2 &value) {
+		return _append(&value, sizeof(glm::vec2), 8);
+	}
+
+	/// @brief Append a vec3 member, aligned as a vec4 but 12 bytes long : a scalar can follow in the last 4 bytes
+	/// @return The offset of the member in the block
+	size_t	BufferBlockWriter::write(const glm::vec3 &value) {
+		return _append(&value, sizeof(glm::vec3), 16);
+	}
+
+	/// @brief Append a vec4 member
+	/// @return The offset of the member in the block
+	size_t	BufferBlockWriter::write(const glm::vec4 &value) {
+		return _append(&value, sizeof(glm::vec4), 16);
+	}
+
+	/// @brief Append a mat4 member, stored as 4 vec4 columns
+	/// @return The offset of the member in the block
+	size_t	BufferBlockWriter::write(const glm::mat4 &value) {
+		return _append(&value, sizeof(glm::mat4), 16);
+	}
+
+	/// @brief Append a float array member
+	/// @param values The first element
+	/// @param count The number of elements
+	/// @return The offset of the member in the block
+	size_t	BufferBlockWriter::writeArray(const float *values, size_t count) {
+		return _appendArray(values, count, sizeof(float), 4);
+	}
+
+	/// @brief Append an int array member
+	/// @param values The first element
+	/// @param count The number of elements
+	/// @return The offset of the member in the block
+	size_t	BufferBlockWriter::writeArray(const int32_t *values, size_t count) {
+		return _appendArray(values, count, sizeof(int32_t), 4);
+	}
+
+	/// @brief Append a vec2 array member
+	/// @param values The first element
+	/// @param count The number of elements
+	/// @return The offset of the member in the block
+	size_t	BufferBlockWriter::writeArray(const glm::vec2 *values, size_t count) {
+		return _appendArray(values, count, sizeof(glm::vec2), 8);
+	}
+
+	/// @brief Append a vec3 array member, each element takes 16 bytes in both layouts
+	/// @param values The first element
+	/// @param count The number of elements
+	/// @return The offset of the member in the block
+	size_t	BufferBlockWriter::writeArray(const glm::vec3 *values, size_t count) {
+		return _appendArray(values, count, sizeof(glm::vec3), 16);
+	}
+
+	/// @brief Append a vec4 array member
+	/// @param values The first element
+	/// @param count The number of elements
+	/// @return The offset of the member in the block
+	size_t	BufferBlockWriter::writeArray(const glm::vec4 *values, size_t count) {
+		return _appendArray(values, count, sizeof(glm::vec4), 16);
+	}
+
+	/// @brief Append a mat4 array member
+	/// @param values The first element
+	/// @param count The number of elements
+	/// @return The offset of the member in the block
+	size_t	BufferBlockWriter::writeArray(const glm::mat4 *values, size_t count) {
+		return _appendArray(values, count, sizeof(glm::mat4), 16);
+	}
+
+	/// @brief Remove every member, keeping the allocation
+	void	BufferBlockWriter::clear() {
+		_data.clear();
+	}
+
+	# pragma endregion
+
+	# pragma region Private functions
+
+	size_t	BufferBlockWriter::_append(const void *value, size_t size, size_t alignment) {
+		const size_t	offset = alignUp(_data.size(), alignment);
+
+		_data.resize(offset + size, 0);
+		std::memcpy(_data.data() + offset, value, size);
+		return offset;
+	}
+
+	// Arrays are aligned and strided on their element alignment, rounded up to a vec4 in std140
+	size_t	BufferBlockWriter::_appendArray(const void *values, size_t count, size_t size, size_t alignment) {
+		if (_layout == BlockLayout::STD140)
+			alignment = std::max<size_t>(alignment, 16);
+
+		const size_t	stride = alignUp(size, alignment);
+		const size_t	offset = alignUp(_data.size(), alignment);
+
+		_data.resize(offset + stride * count, 0);
+		for (size_t i = 0; i < count; i++)
+			std::memcpy(_data.data() + offset + i * stride, static_cast<const uint8_t *>(values) + i * size, size);
+
+		return offset;
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the packed block
+	const void *	BufferBlockWriter::getData() const {
+		return _data.data();
+	}
+
+	/// @brief Return the size of the packed block in bytes
+	size_t	BufferBlockWriter::getSize() const {
+		return _data.size();
+	}
+
+	/// @brief Return the layout the block is packed with
+	BlockLayout	BufferBlockWriter::getLayout() const {
+		return _layout;
+	}
+
+	# pragma endregion
+
+} // namespace GE::OpenGL
@@ -0,0 +1,72 @@
+#pragma once
+
+/// System includes
+# include <cstddef>
+# include <cstdint>
+# include <vector>
+
+/// Dependencies
+# include <glm/glm.hpp>
+
+namespace GE::OpenGL {
+
+	/// @brief Memory layout of a GLSL interface block
+	enum class BlockLayout : uint8_t {
+		STD140,		// Uniform blocks : array elements are padded to 16 bytes
+		STD430		// Shader storage blocks : array elements are only padded to their own alignment
+	};
+
+	/// @brief Packs values with the offsets and padding a GLSL block expects, ready for a BufferGL upload.
+	///
+	/// Values are appended in the declaration order of the block members :
+	///
+	///     layout(std140) uniform Lights { vec3 ambient; int count; vec4 colors[8]; };
+	///
+	///     writer.write(ambient);
+	///     writer.write(count);
+	///     writer.writeArray(colors, 8);
+	///
+	/// Every write returns the offset of the member, e.g. for a later partial update.
+	///
+	/// @note Structures are not supported, write their members one by one.
+	/// @note As this class may be frequently used, it is designed to be as lightweight as possible and have no logging integrated.
+	class BufferBlockWriter {
+		public:
+			explicit BufferBlockWriter(BlockLayout layout = BlockLayout::STD140);
+			~BufferBlockWriter() = default;
+
+			/// Public functions
+
+			size_t	write(float value);
+			size_t	write(int32_t value);
+			size_t	write(uint32_t value);
+			size_t	write(const glm::vec2 &value);
+			size_t	write(const glm::vec3 &value);
+			size_t	write(const glm::vec4 &value);
+			size_t	write(const glm::mat4 &value);
+
+			size_t	writeArray(const float *values, size_t count);
+			size_t	writeArray(const int32_t *values, size_t count);
+			size_t	writeArray(const glm::vec2 *values, size_t count);
+			size_t	writeArray(const glm::vec3 *values, size_t count);
+			size_t	writeArray(const glm::vec4 *values, size_t count);
+			size_t	writeArray(const glm::mat4 *values, size_t count);
+
+			void	clear();
+
+			/// Getters
+
+			const void *	getData() const;
+			size_t			getSize() const;
+			BlockLayout		getLayout() const;
+
+		private:
+			std::vector<uint8_t>	_data;
+			BlockLayout				_layout;
+
+			/// Private functions
+
+			size_t	_append(const void *value, size_t size, size_t alignment);
+			size_t	_appendArray(const void *values, size_t count, size_t size, size_t alignment);
+	};
+} // namespace GE::OpenGL
@@ -1,5 +1,14 @@
 #include "BufferGL.hpp"
 
+/// Includes
+# include "core/Profiler.hpp"
+
+/// System includes
+# include <algorithm>
+# include <cstring>
+# include <stdexcept>
+# include <string>
+
 namespace GE::OpenGL {
 
 	# pragma region Constructors & Destructors
@@ -7,13 +16,15 @@ namespace GE::OpenGL {
 	BufferGL::BufferGL(GLenum type, GLenum usage, size_t size, const void *data)
 		: _type(type), _usage(usage), _capacity(size) {
 		glGenBuffers(1, &_id);
-		glBindBuffer(_type, _id);
+		bind();
 		glBufferData(_type, size, data, _usage);
 	}
 
 	BufferGL::~BufferGL() {
+		if (_combining && _combining->staging)
+			StateCacheGL::getInstance().deleteBuffers(1, &_combining->staging);
 		if (_id)
-			glDeleteBuffers(1, &_id);
+			StateCacheGL::getInstance().deleteBuffers(1, &_id);
 	}
 	
 	# pragma endregion
@@ -22,12 +33,32 @@ namespace GE::OpenGL {
 
 	/// @brief Bind the buffer
 	void	BufferGL::bind() {
-		glBindBuffer(_type, _id);
+		StateCacheGL::getInstance().bindBuffer(_type, _id);
 	}
 
 	/// @brief Unbind the buffer
 	void	BufferGL::unbind() {
-		glBindBuffer(_type, 0);
+		StateCacheGL::getInstance().bindBuffer(_type, 0);
+	}
+
+	/// @brief Bind the whole buffer to a binding point of an indexed target (uniform, shader storage...)
+	/// @param index The binding point, as layout(binding = index) in GLSL
+	void	BufferGL::bindBase(GLuint index) {
+		StateCacheGL::getInstance().bindBufferBase(_type, index, _id);
+	}
+
+	/// @brief Bind a range of the buffer to a binding point of an indexed target (uniform, shader storage...)
+	/// @param index The binding point, as layout(binding = index) in GLSL
+	/// @param offset The start of the range, a multiple of GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT for uniform buffers
+	/// @param size The size of the range in bytes
+	/// @throw std::out_of_range if the range is outside of the buffer
+	void	BufferGL::bindRange(GLuint index, size_t offset, size_t size) {
+		if (offset + size > _capacity)
+			throw std::out_of_range("BufferGL: Range overflow - Offset: " + std::to_string(offset) +
+									", Size: " + std::to_string(size) +
+									", Capacity: " + std::to_string(_capacity));
+
+		StateCacheGL::getInstance().bindBufferRange(_type, index, _id, offset, size);
 	}
 
 	/// @brief Update the buffer data at the given offset
@@ -35,12 +66,28 @@ namespace GE::OpenGL {
 	/// @param size The size of the data to update
 	/// @param offset The offset in the buffer to update
 	/// @throw std::out_of_range if the size + offset is greater than the buffer capacity
+	/// @note In write-combining mode, the data only reaches the GPU on the next flush()
 	void	BufferGL::updateData(const void *data, size_t size, size_t offset) {
+		GE_PROFILE_SCOPE("BufferGL::updateData");
+
 		if (size + offset > _capacity)
 			throw std::out_of_range("BufferGL: Data overflow - Offset: " + std::to_string(offset) + 
 									", Size: " + std::to_string(size) + 
 									", Capacity: " + std::to_string(_capacity));
-			
+
+		_frameStats.writes++;
+
+		if (_combining) {
+			if (size) {
+				std::memcpy(_combining->shadow.data() + offset, data, size);
+				_combining->dirty.push_back({offset, offset + size});
+			}
+			return;
+		}
+
+		_frameStats.uploadCalls++;
+		_frameStats.uploadBytes += size;
+
 		bind();
 		glBufferSubData(_type, offset, size, data);
 	}
@@ -53,6 +100,13 @@ namespace GE::OpenGL {
 	void BufferGL::resize(size_t newSize, const void *data) {
 		_capacity = newSize;
 
+		if (_combining) {
+			_combining->dirty.clear();
+			_combining->shadow.assign(newSize, 0);
+			if (data)
+				std::memcpy(_combining->shadow.data(), data, newSize);
+		}
+
 		bind();
 		glBufferData(_type, newSize, data, _usage);
 	}
@@ -63,12 +117,107 @@ namespace GE::OpenGL {
 		if (!_capacity)
 			return;
 
+		if (_combining) {
+			_combining->dirty.clear();
+			std::fill(_combining->shadow.begin(), _combining->shadow.end(), 0);
+		}
+
 		bind();
 		glBufferData(_type, _capacity, nullptr, _usage);
 	}
+
+	/// @brief Upload the ranges written since the last flush, and start a new frame of upload counters
+	/// @note Call it once per frame, before the draws reading the buffer. Only resets the counters if
+	/// write-combining is disabled.
+	void	BufferGL::flush() {
+		_uploadDirty();
+
+		_lastStats = _frameStats;
+		_frameStats = {};
+	}
 	
 	# pragma endregion
 
+	# pragma region Private functions
+
+	// Merge the dirty ranges and upload them from the shadow copy
+	void	BufferGL::_uploadDirty() {
+		GE_PROFILE_SCOPE("BufferGL::flush");
+
+		if (!_combining || _combining->dirty.empty())
+			return;
+
+		std::vector<std::pair<size_t, size_t>> &	dirty = _combining->dirty;
+
+		// Merge overlapping and close ranges, a small gap costs less than another call
+		std::sort(dirty.begin(), dirty.end());
+
+		size_t	count = 0;
+		for (size_t i = 1; i < dirty.size(); i++) {
+			if (dirty[i].first <= dirty[count].second + MERGE_GAP)
+				dirty[count].second = std::max(dirty[count].second, dirty[i].second);
+			else
+				dirty[++count] = dirty[i];
+		}
+		dirty.resize(count + 1);
+
+		// Pack the large ranges into one staging upload, then copy them on the GPU
+		size_t	stagingSize = 0;
+		for (const auto &[begin, end] : dirty)
+			if (end - begin >= STAGING_THRESHOLD)
+				stagingSize += end - begin;
+
+		if (stagingSize) {
+			if (!_combining->staging)
+				glGenBuffers(1, &_combining->staging);
+
+			StateCacheGL::getInstance().bindBuffer(GL_COPY_READ_BUFFER, _combining->staging);
+			glBufferData(GL_COPY_READ_BUFFER, stagingSize, nullptr, GL_STREAM_DRAW);
+
+			uint8_t *	staging = static_cast<uint8_t *>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, stagingSize,
+				GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+
+			if (!staging)
+				stagingSize = 0;	// Fall back to direct uploads
+			else {
+				size_t	offset = 0;
+
+				for (const auto &[begin, end] : dirty) {
+					if (end - begin >= STAGING_THRESHOLD) {
+						std::memcpy(staging + offset, _combining->shadow.data() + begin, end - begin);
+						offset += end - begin;
+					}
+				}
+				glUnmapBuffer(GL_COPY_READ_BUFFER);
+
+				StateCacheGL::getInstance().bindBuffer(GL_COPY_WRITE_BUFFER, _id);
+				offset = 0;
+				for (const auto &[begin, end] : dirty) {
+					if (end - begin >= STAGING_THRESHOLD) {
+						glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset, begin, end - begin);
+						offset += end - begin;
+						_frameStats.uploadCalls++;
+					}
+				}
+				_frameStats.uploadBytes += stagingSize;
+			}
+		}
+
+		for (const auto &[begin, end] : dirty) {
+			if (stagingSize && end - begin >= STAGING_THRESHOLD)
+				continue;
+
+			bind();
+			glBufferSubData(_type, begin, end - begin, _combining->shadow.data() + begin);
+			_frameStats.uploadCalls++;
+			_frameStats.uploadBytes += end - begin;
+		}
+
+		dirty.clear();
+	}
+
+	# pragma endregion
+
 	# pragma region Getters
 
 	/// @brief Return the buffer ID
@@ -89,6 +238,51 @@ namespace GE::OpenGL {
 		return _capacity;
 	}
 
+	/// @brief Return whether updateData() is batched until flush()
+	bool	BufferGL::isWriteCombining() const {
+		return _combining != nullptr;
+	}
+
+	/// @brief Return the CPU copy of the buffer content
+	/// @return The shadow copy, or nullptr if write-combining is disabled
+	const void *	BufferGL::getShadow() const {
+		return _combining ? _combining->shadow.data() : nullptr;
+	}
+
+	/// @brief Return the upload counters of the last flushed frame
+	BufferUploadStats	BufferGL::getUploadStats() const {
+		return _lastStats;
+	}
+
+	# pragma endregion
+
+	# pragma region Setters
+
+	/// @brief Enable or disable the write-combining mode
+	/// @param enabled Whether updateData() should be batched until flush()
+	/// @note Enabling reads the buffer back once to fill the shadow copy, disabling flushes the pending ranges
+	void	BufferGL::setWriteCombining(bool enabled) {
+		if (enabled == (_combining != nullptr))
+			return;
+
+		if (!enabled) {
+			_uploadDirty();
+			if (_combining->staging)
+				StateCacheGL::getInstance().deleteBuffers(1, &_combining->staging);
+			_combining.reset();
+			return;
+		}
+
+		_combining = std::make_unique<WriteCombining>();
+		_combining->shadow.resize(_capacity);
+
+		// Merged gaps upload the shadow, it must match the buffer
+		if (_capacity) {
+			bind();
+			glGetBufferSubData(_type, 0, _capacity, _combining->shadow.data());
+		}
+	}
+
 	# pragma endregion
 
 } // namespace GE::OpenGL
\ No newline at end of file
@@ -1,17 +1,35 @@
 #pragma once
 
+/// Includes
+# include "StateCacheGL.hpp"
+
 /// System includes
 # include <iostream>
+# include <memory>
 # include <vector>
 
 /// Dependencies
 # include <glad/glad.h>
 
 namespace GE::OpenGL {
+	/// @brief Upload counters of a BufferGL over the last flushed frame
+	struct BufferUploadStats {
+		size_t	writes;			// updateData() calls
+		size_t	uploadCalls;	// glBufferSubData and glCopyBufferSubData calls issued
+		size_t	uploadBytes;	// Bytes sent from the CPU, merged gaps included
+	};
+
 	/// @brief This class is a simple wrapper around OpenGL buffers.
 	///
 	/// It allows to create, bind, unbind, update and delete buffers.
 	///
+	/// Uniform and shader storage buffers are bound to their binding points with bindBase() or bindRange(),
+	/// see BufferBlockWriter to pack their content.
+	///
+	/// In write-combining mode, updateData() only writes a CPU shadow copy and records the range. flush()
+	/// then merges the dirty ranges and uploads them with as few calls as possible, large ranges being
+	/// packed into a single staging upload and copied on the GPU.
+	///
 	/// @note As this class may be frequently used, it is designed to be as lightweight as possible and have no logging integrated.
 	class BufferGL {
 		public:
@@ -22,20 +40,48 @@ namespace GE::OpenGL {
 
 			void	bind();
 			void	unbind();
+			void	bindBase(GLuint index);
+			void	bindRange(GLuint index, size_t offset, size_t size);
 			void	updateData(const void *data, size_t size, size_t offset);
 			void	resize(size_t newSize, const void *data = nullptr);
 			void	clear();
+			void	flush();
 
 			/// Getters
 
-			const GLuint &	getID() const;
-			const GLenum &	getType() const;
-			const size_t &	getCapacity() const;
+			const GLuint &		getID() const;
+			const GLenum &		getType() const;
+			const size_t &		getCapacity() const;
+			bool				isWriteCombining() const;
+			const void *		getShadow() const;
+			BufferUploadStats	getUploadStats() const;
+
+			/// Setters
+
+			void	setWriteCombining(bool enabled);
 
 		private:
+			static constexpr size_t	MERGE_GAP = 256;				// Dirty ranges closer than this are uploaded as one
+			static constexpr size_t	STAGING_THRESHOLD = 64 * 1024;	// Ranges from this size go through the staging buffer
+
+			// State of the write-combining mode, only allocated when enabled
+			struct	WriteCombining {
+				std::vector<uint8_t>					shadow;
+				std::vector<std::pair<size_t, size_t>>	dirty;		// [begin, end) byte ranges, unsorted
+				GLuint									staging = 0;
+			};
+
 			GLuint	_id;
 			GLenum	_type;
 			GLenum	_usage;
 			size_t	_capacity;
+
+			std::unique_ptr<WriteCombining>	_combining;
+			BufferUploadStats				_frameStats = {};	// Current frame
+			BufferUploadStats				_lastStats = {};	// Last flushed frame
+
+			/// Private functions
+
+			void	_uploadDirty();
 	};
 } // namespace GE::OpenGL
\ No newline at end of file
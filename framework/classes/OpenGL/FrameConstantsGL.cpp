@@ -0,0 +1,74 @@
+#include "FrameConstantsGL.hpp"
+
+/// System includes
+# include <cstddef>
+
+namespace GE::OpenGL {
+
+	// The structure is uploaded as is, its offsets must be the std140 ones
+	static_assert(offsetof(FrameConstants, projection) == 64);
+	static_assert(offsetof(FrameConstants, viewProjection) == 128);
+	static_assert(offsetof(FrameConstants, cameraPosition) == 192);
+	static_assert(offsetof(FrameConstants, resolution) == 208);
+	static_assert(offsetof(FrameConstants, time) == 216);
+	static_assert(offsetof(FrameConstants, deltaTime) == 220);
+	static_assert(sizeof(FrameConstants) == 224);
+
+	# pragma region Constructors & Destructors
+
+	FrameConstantsGL::FrameConstantsGL() : _buffer(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW, sizeof(FrameConstants)) {
+		bind();
+	}
+
+	# pragma endregion
+
+	# pragma region Public functions
+
+	/// @brief Fill the constants from a camera, in a single buffer write
+	/// @param camera The camera rendering the frame
+	/// @param time The time since the start, in seconds
+	/// @param deltaTime The duration of the last frame, in seconds
+	void	FrameConstantsGL::update(Objects::Camera &camera, float time, float deltaTime) {
+		const Objects::ProjectionInfo &	projection = camera.getProjectionInfo();
+
+		update({
+			camera.getViewMatrix(),
+			camera.getProjectionMatrix(),
+			static_cast<glm::mat4>(camera),
+			glm::vec4(camera.getCameraInfo().position, 1.0f),
+			projection.resolution,
+			time,
+			deltaTime
+		});
+	}
+
+	/// @brief Replace the constants, in a single buffer write
+	/// @param constants The new constants
+	void	FrameConstantsGL::update(const FrameConstants &constants) {
+		_constants = constants;
+		_buffer.updateData(&_constants, sizeof(FrameConstants), 0);
+	}
+
+	/// @brief Bind the buffer to FRAME_CONSTANTS_BINDING
+	/// @note Done on construction, only needed again if another buffer was bound to the same binding point
+	void	FrameConstantsGL::bind() {
+		_buffer.bindBase(FRAME_CONSTANTS_BINDING);
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the last uploaded constants
+	const FrameConstants &	FrameConstantsGL::getConstants() const {
+		return _constants;
+	}
+
+	/// @brief Return the underlying uniform buffer
+	BufferGL &	FrameConstantsGL::getBuffer() {
+		return _buffer;
+	}
+
+	# pragma endregion
+
+} // namespace GE::OpenGL
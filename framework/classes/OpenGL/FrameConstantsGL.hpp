@@ -0,0 +1,67 @@
+#pragma once
+
+/// Includes
+# include "BufferGL.hpp"
+# include "Objects/Camera.hpp"
+
+/// Dependencies
+# include <glad/glad.h>
+# include <glm/glm.hpp>
+
+namespace GE::OpenGL {
+
+	/// Uniform block binding point reserved for the frame constants, set on every Shader declaring the block
+	constexpr GLuint		FRAME_CONSTANTS_BINDING = 0;
+	constexpr const char *	FRAME_CONSTANTS_BLOCK = "FrameConstants";
+
+	/// @brief Data shared by every shader during a frame, laid out as the std140 block :
+	///
+	///     layout(std140) uniform FrameConstants {
+	///         mat4  view;
+	///         mat4  projection;
+	///         mat4  viewProjection;
+	///         vec4  cameraPosition;	// w is 1
+	///         vec2  resolution;
+	///         float time;
+	///         float deltaTime;
+	///     };
+	struct FrameConstants {
+		glm::mat4	view;
+		glm::mat4	projection;
+		glm::mat4	viewProjection;
+		glm::vec4	cameraPosition;
+		glm::vec2	resolution;
+		float		time;
+		float		deltaTime;
+	};
+
+	/// @brief The uniform buffer holding the FrameConstants, bound to FRAME_CONSTANTS_BINDING.
+	///
+	/// Filled once per frame, it replaces the camera and time uniforms set on each program : every Shader
+	/// declaring the FrameConstants block reads it, whatever the number of programs.
+	///
+	/// @note As this class may be frequently used, it is designed to be as lightweight as possible and have no logging integrated.
+	class FrameConstantsGL {
+		public:
+			FrameConstantsGL();
+			~FrameConstantsGL() = default;
+
+			FrameConstantsGL(const FrameConstantsGL &) = delete;
+			FrameConstantsGL &operator=(const FrameConstantsGL &) = delete;
+
+			/// Public functions
+
+			void	update(Objects::Camera &camera, float time, float deltaTime);
+			void	update(const FrameConstants &constants);
+			void	bind();
+
+			/// Getters
+
+			const FrameConstants &	getConstants() const;
+			BufferGL &				getBuffer();
+
+		private:
+			BufferGL		_buffer;
+			FrameConstants	_constants = {};
+	};
+} // namespace GE::OpenGL
@@ -0,0 +1,290 @@
+#include "MeshHeapGL.hpp"
+
+/// System includes
+# include <algorithm>
+# include <stdexcept>
+# include <string>
+
+namespace GE::OpenGL {
+
+	// Capacity to move to so that count more units fit, compacting alone if the free space is large enough
+	static uint32_t	requiredCapacity(const Utils::TLSFAllocator &heap, uint32_t count) {
+		const uint64_t	used = heap.getStats().used;
+		const uint64_t	capacity = heap.getCapacity();
+
+		if (capacity - used >= count)
+			return (uint32_t)capacity;
+
+		const uint64_t	grown = std::max<uint64_t>(capacity * 2, used + count);
+		if (grown > UINT32_MAX)
+			throw std::length_error("MeshHeapGL: Heap capacity overflow - Requested: " + std::to_string(used + count));
+
+		return (uint32_t)grown;
+	}
+
+	# pragma region Constructors & Destructors
+
+	MeshHeapGL::MeshHeapGL(GLsizei vertexStride, uint32_t vertexCapacity, uint32_t indexCapacity, const std::function<void()> &setupAttributes)
+		: _stride(vertexStride), _commands(GL_DRAW_INDIRECT_BUFFER, GL_STREAM_DRAW) {
+		if (vertexStride <= 0 || !vertexCapacity || !indexCapacity)
+			throw std::invalid_argument("MeshHeapGL: Stride and capacities must not be 0");
+
+		// Uploads go through the copy target, so they never disturb the element array binding of the bound VAO
+		_vertices = std::make_unique<BufferGL>(GL_COPY_WRITE_BUFFER, GL_DYNAMIC_DRAW, (size_t)vertexCapacity * _stride);
+		_indices = std::make_unique<BufferGL>(GL_COPY_WRITE_BUFFER, GL_DYNAMIC_DRAW, (size_t)indexCapacity * sizeof(uint32_t));
+		_vertexHeap.reset(vertexCapacity);
+		_indexHeap.reset(indexCapacity);
+
+		StateCacheGL &	state = StateCacheGL::getInstance();
+
+		glGenVertexArrays(1, &_VAO);
+		state.bindVertexArray(_VAO);
+		glBindVertexBuffer(0, _vertices->getID(), 0, _stride);
+		state.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indices->getID());
+		setupAttributes();
+		state.bindVertexArray(0);
+	}
+
+	MeshHeapGL::~MeshHeapGL() {
+		StateCacheGL::getInstance().deleteVertexArrays(1, &_VAO);
+	}
+
+	# pragma endregion
+
+	# pragma region Public functions
+
+	/// @brief Upload a mesh into the heap
+	/// @param vertices The vertices, vertexStride bytes each
+	/// @param vertexCount The number of vertices
+	/// @param indices The indices, relative to the first vertex of the mesh
+	/// @param indexCount The number of indices
+	/// @return The handle of the mesh
+	/// @throw std::invalid_argument if a count is 0
+	/// @throw std::length_error if the heap would have to grow past 2^32 vertices or indices
+	/// @note May compact or grow the heap, the handles of the other meshes stay valid
+	MeshHeapGL::Handle	MeshHeapGL::allocate(const void *vertices, uint32_t vertexCount, const uint32_t *indices, uint32_t indexCount) {
+		if (!vertexCount || !indexCount)
+			throw std::invalid_argument("MeshHeapGL: Empty mesh");
+
+		Mesh	mesh = {_vertexHeap.allocate(vertexCount), _indexHeap.allocate(indexCount), true};
+
+		if (mesh.vertexBlock == Utils::TLSFAllocator::INVALID || mesh.indexBlock == Utils::TLSFAllocator::INVALID) {
+			if (mesh.vertexBlock != Utils::TLSFAllocator::INVALID)
+				_vertexHeap.free(mesh.vertexBlock);
+			if (mesh.indexBlock != Utils::TLSFAllocator::INVALID)
+				_indexHeap.free(mesh.indexBlock);
+
+			_relocate(requiredCapacity(_vertexHeap, vertexCount), requiredCapacity(_indexHeap, indexCount));
+
+			// The free space is now a single block at the end of each heap
+			mesh.vertexBlock = _vertexHeap.allocate(vertexCount);
+			mesh.indexBlock = _indexHeap.allocate(indexCount);
+		}
+
+		_vertices->updateData(vertices, (size_t)vertexCount * _stride, (size_t)_vertexHeap.getOffset(mesh.vertexBlock) * _stride);
+		_indices->updateData(indices, (size_t)indexCount * sizeof(uint32_t), (size_t)_indexHeap.getOffset(mesh.indexBlock) * sizeof(uint32_t));
+
+		if (!_unusedHandles.empty()) {
+			const Handle	handle = _unusedHandles.back();
+
+			_unusedHandles.pop_back();
+			_meshes[handle - 1] = mesh;
+			return handle;
+		}
+
+		_meshes.push_back(mesh);
+		return (Handle)_meshes.size();
+	}
+
+	/// @brief Release a mesh, its handle becomes invalid
+	/// @param handle A handle returned by allocate()
+	/// @throw std::invalid_argument if the handle is not a live mesh
+	void	MeshHeapGL::free(Handle handle) {
+		Mesh &	mesh = _checkHandle(handle);
+
+		_vertexHeap.free(mesh.vertexBlock);
+		_indexHeap.free(mesh.indexBlock);
+		mesh.alive = false;
+		_unusedHandles.push_back(handle);
+	}
+
+	/// @brief Draw a list of meshes in a single call
+	/// @param handles The meshes to draw, gl_BaseInstance (gl_DrawID) is the position of the mesh in the list
+	/// @throw std::invalid_argument if a handle is not a live mesh
+	/// @note The shader program must be bound beforehand
+	void	MeshHeapGL::draw(const std::vector<Handle> &handles) {
+		_drawCommands.clear();
+		for (Handle handle : handles) {
+			const Mesh &	mesh = _checkHandle(handle);
+
+			_drawCommands.push_back({
+				_indexHeap.getSize(mesh.indexBlock),
+				1,
+				_indexHeap.getOffset(mesh.indexBlock),
+				(GLint)_vertexHeap.getOffset(mesh.vertexBlock),
+				(GLuint)_drawCommands.size()
+			});
+		}
+
+		_submit();
+	}
+
+	/// @brief Draw every mesh of the heap in a single call
+	/// @note The shader program must be bound beforehand
+	void	MeshHeapGL::drawAll() {
+		_drawCommands.clear();
+		for (const Mesh &mesh : _meshes) {
+			if (!mesh.alive)
+				continue;
+
+			_drawCommands.push_back({
+				_indexHeap.getSize(mesh.indexBlock),
+				1,
+				_indexHeap.getOffset(mesh.indexBlock),
+				(GLint)_vertexHeap.getOffset(mesh.vertexBlock),
+				(GLuint)_drawCommands.size()
+			});
+		}
+
+		_submit();
+	}
+
+	/// @brief Pack every mesh at the start of the buffers, so the free space becomes a single block
+	/// @note Copies the meshes on the GPU into new buffers, call it on idle frames rather than every frame
+	void	MeshHeapGL::compact() {
+		_relocate(_vertexHeap.getCapacity(), _indexHeap.getCapacity());
+	}
+
+	# pragma endregion
+
+	# pragma region Private functions
+
+	// Move every mesh, packed in handle order, into new buffers of the given capacities
+	void	MeshHeapGL::_relocate(uint32_t vertexCapacity, uint32_t indexCapacity) {
+		struct	Range {
+			size_t	vertexOffset;
+			size_t	vertexSize;
+			size_t	indexOffset;
+			size_t	indexSize;
+		};
+
+		StateCacheGL &		state = StateCacheGL::getInstance();
+		std::vector<Range>	ranges(_meshes.size());
+
+		for (size_t i = 0; i < _meshes.size(); i++) {
+			const Mesh &	mesh = _meshes[i];
+
+			if (mesh.alive)
+				ranges[i] = {
+					_vertexHeap.getOffset(mesh.vertexBlock),
+					_vertexHeap.getSize(mesh.vertexBlock),
+					_indexHeap.getOffset(mesh.indexBlock),
+					_indexHeap.getSize(mesh.indexBlock)
+				};
+		}
+
+		if (vertexCapacity > _vertexHeap.getCapacity() || indexCapacity > _indexHeap.getCapacity())
+			_growths++;
+		else
+			_compactions++;
+
+		std::unique_ptr<BufferGL>	vertices = std::make_unique<BufferGL>(GL_COPY_WRITE_BUFFER, GL_DYNAMIC_DRAW, (size_t)vertexCapacity * _stride);
+		std::unique_ptr<BufferGL>	indices = std::make_unique<BufferGL>(GL_COPY_WRITE_BUFFER, GL_DYNAMIC_DRAW, (size_t)indexCapacity * sizeof(uint32_t));
+
+		_vertexHeap.reset(vertexCapacity);
+		_indexHeap.reset(indexCapacity);
+
+		for (size_t i = 0; i < _meshes.size(); i++) {
+			Mesh &			mesh = _meshes[i];
+			const Range &	range = ranges[i];
+
+			if (!mesh.alive)
+				continue;
+
+			mesh.vertexBlock = _vertexHeap.allocate(range.vertexSize);
+			mesh.indexBlock = _indexHeap.allocate(range.indexSize);
+
+			state.bindBuffer(GL_COPY_READ_BUFFER, _vertices->getID());
+			state.bindBuffer(GL_COPY_WRITE_BUFFER, vertices->getID());
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, range.vertexOffset * _stride,
+				(size_t)_vertexHeap.getOffset(mesh.vertexBlock) * _stride, range.vertexSize * _stride);
+
+			state.bindBuffer(GL_COPY_READ_BUFFER, _indices->getID());
+			state.bindBuffer(GL_COPY_WRITE_BUFFER, indices->getID());
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, range.indexOffset * sizeof(uint32_t),
+				(size_t)_indexHeap.getOffset(mesh.indexBlock) * sizeof(uint32_t), range.indexSize * sizeof(uint32_t));
+		}
+
+		_vertices = std::move(vertices);
+		_indices = std::move(indices);
+
+		state.bindVertexArray(_VAO);
+		glBindVertexBuffer(0, _vertices->getID(), 0, _stride);
+		state.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indices->getID());
+		state.bindVertexArray(0);
+	}
+
+	// Upload _drawCommands and issue them
+	void	MeshHeapGL::_submit() {
+		if (_drawCommands.empty())
+			return;
+
+		const size_t	size = _drawCommands.size() * sizeof(DrawCommand);
+
+		// Orphan the previous commands rather than waiting for the draws reading them
+		if (size > _commands.getCapacity())
+			_commands.resize(size, _drawCommands.data());
+		else {
+			_commands.clear();
+			_commands.updateData(_drawCommands.data(), size, 0);
+		}
+
+		StateCacheGL &	state = StateCacheGL::getInstance();
+
+		state.setDepthMask(true);
+		state.setDepthFunc(GL_LESS);
+		state.bindVertexArray(_VAO);
+		_commands.bind();
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, (GLsizei)_drawCommands.size(), 0);
+		_drawCalls++;
+	}
+
+	MeshHeapGL::Mesh &	MeshHeapGL::_checkHandle(Handle handle) {
+		if (!handle || handle > _meshes.size() || !_meshes[handle - 1].alive)
+			throw std::invalid_argument("MeshHeapGL: Invalid handle - " + std::to_string(handle));
+
+		return _meshes[handle - 1];
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the VAO shared by every mesh
+	const GLuint &	MeshHeapGL::getVAO() const {
+		return _VAO;
+	}
+
+	/// @brief Return the occupancy of both heaps and the counters
+	/// @note Walks every block, meant for statistics rather than every frame
+	MeshHeapStats	MeshHeapGL::getStats() const {
+		const Utils::TLSFStats	vertexStats = _vertexHeap.getStats();
+		const Utils::TLSFStats	indexStats = _indexHeap.getStats();
+
+		return {
+			_meshes.size() - _unusedHandles.size(),
+			vertexStats.capacity,
+			vertexStats.used,
+			vertexStats.fragmentation,
+			indexStats.capacity,
+			indexStats.used,
+			indexStats.fragmentation,
+			_compactions,
+			_growths,
+			_drawCalls
+		};
+	}
+
+	# pragma endregion
+
+} // namespace GE::OpenGL
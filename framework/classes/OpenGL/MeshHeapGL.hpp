@@ -0,0 +1,109 @@
+#pragma once
+
+/// Includes
+# include "BufferGL.hpp"
+# include "Utils/TLSFAllocator.hpp"
+
+/// System includes
+# include <cstdint>
+# include <functional>
+# include <memory>
+# include <vector>
+
+/// Dependencies
+# include <glad/glad.h>
+
+namespace GE::OpenGL {
+
+	/// @brief Occupancy and counters of a MeshHeapGL
+	struct MeshHeapStats {
+		size_t		meshes;
+		uint32_t	vertexCapacity;			// In vertices
+		uint32_t	vertexUsed;
+		float		vertexFragmentation;	// See Utils::TLSFStats::fragmentation
+		uint32_t	indexCapacity;			// In indices
+		uint32_t	indexUsed;
+		float		indexFragmentation;
+		size_t		compactions;
+		size_t		growths;
+		size_t		drawCalls;				// glMultiDrawElementsIndirect calls
+	};
+
+	/// @brief Many indexed meshes sharing one vertex buffer, one index buffer and one VAO.
+	///
+	/// Both buffers are sub-allocated by a Utils::TLSFAllocator counting vertices and indices, so the offset of
+	/// a mesh is directly its baseVertex and firstIndex. A whole list of meshes is then drawn by a single
+	/// glMultiDrawElementsIndirect, without any buffer or VAO switch.
+	///
+	/// When an allocation does not fit, the heap compacts if the free space is only fragmented, or grows
+	/// twice as large, moving the meshes with glCopyBufferSubData : the data never goes through the CPU.
+	///
+	/// Meshes are identified by a handle, stable across compactions, 0 is never a valid handle.
+	///
+	/// @note Requires OpenGL 4.3 (vertex attribute binding, multi draw indirect).
+	/// @note Indices are GL_UNSIGNED_INT, relative to the first vertex of their mesh.
+	/// @note As this class may be frequently used, it is designed to be as lightweight as possible and have no logging integrated.
+	class MeshHeapGL {
+		public:
+			using Handle = uint32_t;
+
+			MeshHeapGL(GLsizei vertexStride, uint32_t vertexCapacity, uint32_t indexCapacity, const std::function<void()> &setupAttributes);
+			~MeshHeapGL();
+
+			MeshHeapGL(const MeshHeapGL &) = delete;
+			MeshHeapGL &operator=(const MeshHeapGL &) = delete;
+
+			/// Public functions
+
+			Handle	allocate(const void *vertices, uint32_t vertexCount, const uint32_t *indices, uint32_t indexCount);
+			void	free(Handle handle);
+			void	draw(const std::vector<Handle> &handles);
+			void	drawAll();
+			void	compact();
+
+			/// Getters
+
+			const GLuint &	getVAO() const;
+			MeshHeapStats	getStats() const;
+
+		private:
+			// Layout of glMultiDrawElementsIndirect commands
+			struct	DrawCommand {
+				GLuint	count;
+				GLuint	instanceCount;
+				GLuint	firstIndex;
+				GLint	baseVertex;
+				GLuint	baseInstance;
+			};
+
+			struct	Mesh {
+				uint32_t	vertexBlock;
+				uint32_t	indexBlock;
+				bool		alive;
+			};
+
+			GLsizei						_stride;
+			GLuint						_VAO;
+
+			std::unique_ptr<BufferGL>	_vertices;
+			std::unique_ptr<BufferGL>	_indices;
+			BufferGL					_commands;
+
+			Utils::TLSFAllocator		_vertexHeap;
+			Utils::TLSFAllocator		_indexHeap;
+
+			std::vector<Mesh>			_meshes;			// Indexed by handle - 1
+			std::vector<Handle>			_unusedHandles;
+			std::vector<DrawCommand>	_drawCommands;		// Reused by draw()
+
+			size_t						_compactions = 0;
+			size_t						_growths = 0;
+			size_t						_drawCalls = 0;
+
+			/// Private functions
+
+			void	_relocate(uint32_t vertexCapacity, uint32_t indexCapacity);
+			void	_submit();
+			Mesh &	_checkHandle(Handle handle);
+	};
+} // namespace GE::OpenGL
@@ -1,5 +1,12 @@
 #include "PMapBufferGL.hpp"
 
+/// Includes
+# include "core/Profiler.hpp"
+
+/// System includes
+# include <algorithm>
+# include <stdexcept>
+
 namespace GE::OpenGL {
 
 	# pragma region Constructors & Destructors
@@ -8,7 +15,7 @@ namespace GE::OpenGL {
 		: _type(type), _usage(usage), _capacity(capacity), _data(nullptr) {
 		
 		glGenBuffers(1, &_id);
-		glBindBuffer(_type, _id);
+		StateCacheGL::getInstance().bindBuffer(_type, _id);
 
 		glBufferStorage(type, capacity, nullptr, PERSISTENT_BUFFER_USAGE);
 
@@ -19,8 +26,11 @@ namespace GE::OpenGL {
 	}
 
 	PMapBufferGL::~PMapBufferGL() {
-		if (_data)
+		if (_data) {
+			StateCacheGL::getInstance().bindBuffer(_type, _id);
 			glUnmapBuffer(_type);
+		}
+		StateCacheGL::getInstance().deleteBuffers(1, &_id);
 	}
 	
 	# pragma endregion
@@ -29,12 +39,12 @@ namespace GE::OpenGL {
 
 	/// @brief Bind the buffer
 	void PMapBufferGL::bind() {
-		glBindBuffer(_type, _id);
+		StateCacheGL::getInstance().bindBuffer(_type, _id);
 	}
 
 	/// @brief Unbind the buffer
 	void PMapBufferGL::unbind() {
-		glBindBuffer(_type, 0);
+		StateCacheGL::getInstance().bindBuffer(_type, 0);
 	}
 
 	/// @brief Flush the buffer to the GPU
@@ -51,37 +61,46 @@ namespace GE::OpenGL {
 		if (!length || offset + length > _capacity)
 			length = _capacity - offset;
 
+		StateCacheGL::getInstance().bindBuffer(_type, _id);
 		glFlushMappedBufferRange(_type, offset, length);
 	}
 
 	/// @brief Resize the buffer to the new capacity
 	/// @param newCapacity The new capacity of the buffer
-	/// @param keepData Whether to keep the current data in the buffer
+	/// @param keepData Whether to keep the current data in the buffer, truncated if the buffer shrinks
 	/// @note This function recreates the buffer, so you need to update your buffer attributes if you use them elsewhere
+	/// @note The data is copied on the GPU, the new mapping waits for the copy unless usage has GL_MAP_UNSYNCHRONIZED_BIT
 	/// @return The new capacity of the buffer, or 0 if the resize failed
 	size_t PMapBufferGL::resize(size_t newCapacity, bool keepData) {
-		if (newCapacity < _capacity)
+		if (!newCapacity || newCapacity == _capacity)
 			return _capacity;
 
-		// Copy current data
-		uint8_t *	copy = nullptr;
-		if (keepData) {
-			copy = new uint8_t[newCapacity];
-			std::memset(copy, 0, newCapacity);
-			std::memcpy(copy, _data, _capacity);
+		StateCacheGL &	state = StateCacheGL::getInstance();
+		GLuint			id;
+
+		glGenBuffers(1, &id);
+		state.bindBuffer(_type, id);
+		glBufferStorage(_type, newCapacity, nullptr, PERSISTENT_BUFFER_USAGE);
+
+		// Move the current data without a round trip through system memory
+		if (keepData && _data) {
+			state.bindBuffer(GL_COPY_READ_BUFFER, _id);
+			state.bindBuffer(GL_COPY_WRITE_BUFFER, id);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, std::min(_capacity, newCapacity));
 		}
 
 		// Delete current buffer
-		glUnmapBuffer(_type);
-		glDeleteBuffers(1, &_id);
+		if (_data) {
+			state.bindBuffer(_type, _id);
+			glUnmapBuffer(_type);
+		}
+		state.deleteBuffers(1, &_id);
 
-		// Create a new buffer
-		glGenBuffers(1, &_id);
-		glBindBuffer(_type, _id);
-		glBufferStorage(_type, newCapacity, copy, PERSISTENT_BUFFER_USAGE);
-		_data = glMapBufferRange(_type, 0, newCapacity, _usage);
+		_id = id;
+		_reallocations++;
 
-		delete[] static_cast<uint8_t*>(copy);
+		state.bindBuffer(_type, _id);
+		_data = glMapBufferRange(_type, 0, newCapacity, _usage);
 
 		if (!_data)
 			return _capacity = 0;
@@ -89,6 +108,37 @@ namespace GE::OpenGL {
 		return _capacity = newCapacity;
 	}
 
+	/// @brief Grow the buffer until size bytes fit, by steps of the growth factor
+	/// @param size The number of bytes needed
+	/// @param keepData Whether to keep the current data in the buffer
+	/// @return The capacity of the buffer, or 0 if the resize failed
+	/// @note Does nothing if the buffer is already large enough
+	size_t PMapBufferGL::reserve(size_t size, bool keepData) {
+		if (size <= _capacity)
+			return _capacity;
+
+		size_t	newCapacity = std::max<size_t>(_capacity, 1);
+		while (newCapacity < size)
+			newCapacity = std::max(newCapacity + 1, (size_t)(newCapacity * std::max(_growth.growthFactor, 1.0f)));
+
+		return resize(newCapacity, keepData);
+	}
+
+	/// @brief Shrink the buffer if the used size fell below the shrink threshold of the capacity
+	/// @param used The number of bytes in use, kept from the start of the buffer
+	/// @return The capacity of the buffer, or 0 if the resize failed
+	/// @note Leaves room for growthFactor times the used size, so the next reserve() does not reallocate right away
+	size_t PMapBufferGL::fit(size_t used) {
+		if (used >= _capacity * _growth.shrinkThreshold)
+			return _capacity;
+
+		const size_t	newCapacity = std::max(_growth.minCapacity, (size_t)(used * std::max(_growth.growthFactor, 1.0f)));
+		if (newCapacity >= _capacity)
+			return _capacity;
+
+		return resize(newCapacity);
+	}
+
 	/// @brief Write data to the buffer at the given offset
 	/// @param data The source data to write
 	/// @param size The size of the data to write
@@ -97,6 +147,8 @@ namespace GE::OpenGL {
 	/// @note If src is nullptr, the buffer will be filled with zeros
 	/// @note This function does not flush the buffer, you need to call flush() if needed
 	bool PMapBufferGL::write(const void* data, size_t size, size_t offset) {
+		GE_PROFILE_SCOPE("PMapBufferGL::write");
+
 		if (offset + size > _capacity)
 			return false;
 
@@ -112,6 +164,12 @@ namespace GE::OpenGL {
 
 	# pragma region Getters
 
+	/// @brief Return a writable pointer to the buffer data
+	/// @return The pointer to the buffer data
+	void * PMapBufferGL::getData() {
+		return _data;
+	}
+
 	/// @brief Return a pointer to the buffer data
 	/// @return The pointer to the buffer data
 	const void * PMapBufferGL::getData() const {
@@ -135,7 +193,29 @@ namespace GE::OpenGL {
 	const size_t & PMapBufferGL::getCapacity() const {
 		return _capacity;
 	}
+
+	/// @brief Return the sizing rules of reserve() and fit()
+	/// @return The growth policy
+	const PMapGrowthPolicy & PMapBufferGL::getGrowthPolicy() const {
+		return _growth;
+	}
+
+	/// @brief Return the number of times the buffer was recreated by resize()
+	/// @return The reallocation count
+	size_t PMapBufferGL::getReallocations() const {
+		return _reallocations;
+	}
 	
 	# pragma endregion
 
+	# pragma region Setters
+
+	/// @brief Set the sizing rules of reserve() and fit()
+	/// @param policy The new growth policy
+	void PMapBufferGL::setGrowthPolicy(const PMapGrowthPolicy &policy) {
+		_growth = policy;
+	}
+
+	# pragma endregion
+
 } // namespace GE::OpenGL
\ No newline at end of file
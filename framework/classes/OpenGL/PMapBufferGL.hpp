@@ -3,6 +3,9 @@
 /// Defines
 # define PERSISTENT_BUFFER_USAGE GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT
 
+/// Includes
+# include "StateCacheGL.hpp"
+
 /// System includes
 # include <iostream>
 # include <cstring>
@@ -11,10 +14,21 @@
 # include <glad/glad.h>
 
 namespace GE::OpenGL {
+	/// @brief Sizing rules of PMapBufferGL::reserve() and PMapBufferGL::fit()
+	struct PMapGrowthPolicy {
+		float	growthFactor    = 2.0f;		// Capacity multiplier applied until the requested size fits
+		float	shrinkThreshold = 0.25f;	// fit() shrinks once the used size falls below this fraction of the capacity, 0 never shrinks
+		size_t	minCapacity     = 4096;		// fit() never shrinks below
+	};
+
 	/// @brief This class is a simple wrapper around OpenGL persistent mapped buffers.
 	///
 	/// It allows to create, bind, unbind, resize, write and flush buffers.
 	///
+	/// As a growable buffer, reserve() grows it geometrically and fit() shrinks it back once mostly unused.
+	/// Shrinking leaves room for growthFactor times the used size, so a size oscillating around the
+	/// threshold does not reallocate every frame. The content is moved on the GPU with glCopyBufferSubData.
+	///
 	/// @note The buffer is mapped persistently, so you can access the data directly via getData().
 	/// @note The buffer must be created with GL_MAP_FLUSH_EXPLICIT_BIT in usage if you want to use the flush() method.
 	/// @note As this class may be frequently used, it is designed to be as lightweight as possible and have no logging integrated.
@@ -23,18 +37,29 @@ namespace GE::OpenGL {
 			PMapBufferGL(GLenum type, size_t capacity, GLenum usage = 0);
 			~PMapBufferGL();
 
-			/// Public functionsf
+			PMapBufferGL(const PMapBufferGL &) = delete;
+			PMapBufferGL &operator=(const PMapBufferGL &) = delete;
+
+			/// Public functions
 			void    bind();
 			void    unbind();
 			size_t  resize(size_t newCapacity, bool keepData = true);
+			size_t  reserve(size_t size, bool keepData = true);
+			size_t  fit(size_t used);
 			bool    write(const void* src, size_t size, size_t offset = 0);
 			void    flush(size_t offset = 0, size_t length = 0) const;
 
 			/// Getters
+			void *			getData();
 			const void *	getData() const;
 			const GLuint &	getID() const;
 			const GLenum &	getType() const;
 			const size_t &	getCapacity() const;
+			const PMapGrowthPolicy &	getGrowthPolicy() const;
+			size_t			getReallocations() const;
+
+			/// Setters
+			void	setGrowthPolicy(const PMapGrowthPolicy &policy);
 
 		private:
 			GLuint	_id;
@@ -43,5 +68,7 @@ namespace GE::OpenGL {
 			size_t	_capacity;
 			void *	_data;
 
+			PMapGrowthPolicy	_growth;
+			size_t				_reallocations = 0;
 	};
 } // namespace GE::OpenGL
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "ProgramCacheGL.hpp"
+
+/// System includes
+# include <chrono>
+# include <cstdio>
+# include <filesystem>
+# include <fstream>
+
+namespace GE::OpenGL {
+
+	static uint64_t	hashBytes(const void *data, size_t size, uint64_t hash = 0xcbf29ce484222325ull) {
+		const uint8_t *	bytes = static_cast<const uint8_t *>(data);
+
+		for (size_t i = 0; i < size; i++)
+			hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+		return hash;
+	}
+
+	static uint64_t	hashString(const std::string &string, uint64_t hash) {
+		const uint64_t	length = string.size();
+
+		// The length separates the strings : ("ab", "c") and ("a", "bc") differ
+		hash = hashBytes(&length, sizeof(length), hash);
+		return hashBytes(string.data(), string.size(), hash);
+	}
+
+	# pragma region Public functions
+
+	/// @brief Compute the cache key of a program
+	/// @param sources The shader sources, in stage order
+	/// @param defines The defines the sources are compiled with, if not already part of the sources
+	/// @return The key, also depending on the driver identity
+	uint64_t	ProgramCacheGL::makeKey(const std::vector<std::string> &sources, const std::string &defines) {
+		if (_driver.empty())
+			_queryDriver();
+
+		uint64_t	hash = hashString(_driver, 0xcbf29ce484222325ull);
+
+		for (const std::string &source : sources)
+			hash = hashString(source, hash);
+		return hashString(defines, hash);
+	}
+
+	/// @brief Create a program from its cached binary
+	/// @param key The key of the program, see makeKey()
+	/// @return The linked program, or 0 if it is not cached or the driver rejected the binary
+	/// @note A rejected binary is removed from the cache, the caller is expected to compile and store() again
+	GLuint	ProgramCacheGL::load(uint64_t key) {
+		if (!isEnabled())
+			return 0;
+
+		const auto		start = std::chrono::steady_clock::now();
+		const std::string	path = _path(key);
+		std::ifstream	file(path, std::ios::binary);
+		FileHeader		header;
+
+		if (!file.is_open())
+			return 0;
+
+		if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+			header.magic != MAGIC || header.version != VERSION || header.key != key)
+			return 0;
+
+		std::vector<char>	binary(header.size);
+		if (!file.read(binary.data(), binary.size()) || hashBytes(binary.data(), binary.size()) != header.checksum)
+			return 0;
+		file.close();
+
+		GLuint	program = glCreateProgram();
+		GLint	success = GL_FALSE;
+
+		glProgramBinary(program, header.format, binary.data(), (GLsizei)binary.size());
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+
+		if (!success) {
+			glDeleteProgram(program);
+			std::remove(path.c_str());
+			_stats.rejected++;
+			return 0;
+		}
+
+		const double	loadTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		_stats.hits++;
+		_stats.loadTime += loadTime;
+		_stats.savedTime += header.compileTime - loadTime;
+		return program;
+	}
+
+	/// @brief Record a program compiled from sources, and cache its binary
+	/// @param key The key of the program, see makeKey()
+	/// @param program The linked program, with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set before linking
+	/// @param compileTime The milliseconds the compilation and link took
+	/// @note Failing to write the file only loses the cache entry, nothing is thrown
+	void	ProgramCacheGL::store(uint64_t key, GLuint program, double compileTime) {
+		_stats.misses++;
+		_stats.compileTime += compileTime;
+
+		if (!isEnabled())
+			return;
+
+		GLint	length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+			return;
+
+		std::vector<char>	binary(length);
+		GLenum				format = 0;
+
+		glGetProgramBinary(program, length, &length, &format, binary.data());
+		binary.resize(length);
+
+		const FileHeader	header = {
+			MAGIC, VERSION, 0, key, format, (uint32_t)binary.size(),
+			hashBytes(binary.data(), binary.size()), compileTime
+		};
+
+		// Written aside then renamed, a crash never leaves a truncated entry
+		const std::string	path = _path(key);
+		const std::string	temporary = path + ".tmp";
+		{
+			std::ofstream	file(temporary, std::ios::binary | std::ios::trunc);
+
+			file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+			file.write(binary.data(), binary.size());
+			if (!file)
+				return;
+		}
+
+		std::error_code	error;
+		std::filesystem::rename(temporary, path, error);
+		if (!error)
+			_stats.stores++;
+	}
+
+	/// @brief Remove every cached binary
+	void	ProgramCacheGL::clear() {
+		std::error_code	error;
+
+		if (_directory.empty())
+			return;
+
+		for (const auto &entry : std::filesystem::directory_iterator(_directory, error))
+			if (entry.path().extension() == ".bin")
+				std::filesystem::remove(entry.path(), error);
+	}
+
+	# pragma endregion
+
+	# pragma region Private functions
+
+	std::string	ProgramCacheGL::_path(uint64_t key) const {
+		char	name[32];
+
+		std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+		return _directory + "/" + name;
+	}
+
+	void	ProgramCacheGL::_queryDriver() {
+		for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+			const GLubyte *	string = glGetString(name);
+
+			_driver += string ? reinterpret_cast<const char *>(string) : "?";
+			_driver += '\n';
+		}
+
+		GLint	formats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		_supported = formats > 0;
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return whether binaries are loaded and stored
+	bool	ProgramCacheGL::isEnabled() const {
+		return _supported && !_directory.empty();
+	}
+
+	/// @brief Return the directory holding the binaries, empty if disabled
+	const std::string &	ProgramCacheGL::getDirectory() const {
+		return _directory;
+	}
+
+	/// @brief Return the hit, miss and timing counters
+	ProgramCacheStats	ProgramCacheGL::getStats() const {
+		return _stats;
+	}
+
+	# pragma endregion
+
+	# pragma region Setters
+
+	/// @brief Set the directory holding the binaries, enabling the cache
+	/// @param directory The directory, created if needed, or an empty string to disable the cache
+	/// @throw std::filesystem::filesystem_error if the directory cannot be created
+	void	ProgramCacheGL::setDirectory(const std::string &directory) {
+		if (!directory.empty())
+			std::filesystem::create_directories(directory);
+		_directory = directory;
+	}
+
+	# pragma endregion
+
+} // namespace GE::OpenGL
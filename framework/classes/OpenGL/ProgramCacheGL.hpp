@@ -0,0 +1,91 @@
+#pragma once
+
+/// Includes
+# include "core/Singleton.hpp"
+
+/// System includes
+# include <cstdint>
+# include <string>
+# include <vector>
+
+/// Dependencies
+# include <glad/glad.h>
+
+namespace GE::OpenGL {
+
+	/// @brief Counters of the ProgramCacheGL, since the start
+	struct ProgramCacheStats {
+		size_t	hits;			// Programs created from a cached binary
+		size_t	misses;			// Programs compiled from sources : not cached, rejected, or cache disabled
+		size_t	rejected;		// Cached binaries refused by the driver (driver update...), also counted in misses
+		size_t	stores;			// Binaries written to the cache
+		double	loadTime;		// Milliseconds spent creating programs from binaries
+		double	compileTime;	// Milliseconds spent compiling and linking from sources
+		double	savedTime;		// Milliseconds the hits would have cost to compile, minus loadTime
+	};
+
+	/**
+	 * @brief An on-disk cache of linked program binaries (glGetProgramBinary / glProgramBinary).
+	 *
+	 * Programs are keyed by a hash of their sources, their defines and the driver identity (vendor, renderer
+	 * and version strings), so a changed source or driver never reuses a stale binary. A binary the driver
+	 * refuses anyway is counted as rejected, the caller compiles from sources and stores the new binary.
+	 *
+	 * Each binary is stored with the time its compilation took, which gives the time a hit saved.
+	 *
+	 * Disabled until setDirectory() is called, or if the driver supports no binary format (known from the first makeKey()).
+	 *
+	 * @note Requires OpenGL 4.1, call it from the thread owning the context.
+	 */
+	class ProgramCacheGL : public Core::Singleton<ProgramCacheGL> {
+		friend class Core::Singleton<ProgramCacheGL>;
+
+		public:
+			/// Public functions
+
+			uint64_t	makeKey(const std::vector<std::string> &sources, const std::string &defines = "");
+			GLuint		load(uint64_t key);
+			void		store(uint64_t key, GLuint program, double compileTime);
+			void		clear();
+
+			/// Getters
+
+			bool				isEnabled() const;
+			const std::string &	getDirectory() const;
+			ProgramCacheStats	getStats() const;
+
+			/// Setters
+
+			void	setDirectory(const std::string &directory);
+
+		private:
+			static constexpr uint32_t	MAGIC = 0x42504547;	// "GEPB"
+			static constexpr uint16_t	VERSION = 1;
+
+			// Header of a cache file, followed by the binary
+			struct	FileHeader {
+				uint32_t	magic;
+				uint16_t	version;
+				uint16_t	reserved;
+				uint64_t	key;
+				uint32_t	format;		// Driver binary format
+				uint32_t	size;		// Bytes of binary
+				uint64_t	checksum;	// Hash of the binary
+				double		compileTime;	// Milliseconds the compilation took
+			};
+
+			std::string	_directory;
+			std::string	_driver;	// Vendor, renderer and version, queried on first use
+			bool		_supported = false;
+
+			ProgramCacheStats	_stats = {};
+
+			ProgramCacheGL() = default;
+			~ProgramCacheGL() = default;
+
+			/// Private functions
+
+			std::string	_path(uint64_t key) const;
+			void		_queryDriver();
+	};
+} // namespace GE::OpenGL
@@ -4,21 +4,47 @@ namespace GE::OpenGL {
 
 	# pragma region Constructors & Destructors
 
-	Shader::Shader(const std::string &vertexPath, const std::string &fragmentPath, const std::string &geometryPath, Core::Logger *logger) : logger(logger) {
+	Shader::Shader(
+		const std::string &vertexPath,
+		const std::string &fragmentPath,
+		const std::string &geometryPath,
+		Core::Logger *logger,
+		const ShaderDefines &defines
+	) : defines(defines), logger(logger) {
 		if (logger) logger->trace("Creating shader");
 
 		this->vertexPath = vertexPath;
 		this->fragmentPath = fragmentPath;
 		this->geometryPath = geometryPath;
 
-		shaderID = make_shader();
+		const auto	start = std::chrono::steady_clock::now();
+		const size_t	hits = ProgramCacheGL::getInstance().getStats().hits;
 
-		if (logger) logger->info("Shader created");
+		set_program(make_shader());
+		state = ShaderState::READY;
+
+		if (logger) {
+			const double	elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			logger->info("Shader created in " + std::to_string(elapsed) + " ms" +
+						 (ProgramCacheGL::getInstance().getStats().hits != hits ? " (binary cache hit)" : ""));
+		}
 	}
 
+	// Deferred creation, the program is set by the ShaderCompiler once linked
+	Shader::Shader(
+		Deferred,
+		const std::string &vertexPath,
+		const std::string &fragmentPath,
+		const std::string &geometryPath,
+		Core::Logger *logger,
+		const ShaderDefines &defines
+	) : shaderID(0), vertexPath(vertexPath), fragmentPath(fragmentPath), geometryPath(geometryPath), defines(defines), logger(logger) {}
+
 	Shader::~Shader() {
-		glUseProgram(0);
-		glDeleteProgram(shaderID);
+		StateCacheGL::getInstance().useProgram(0);
+		StateCacheGL::getInstance().deleteProgram(shaderID);
+		release_modules();
 
 		if (logger) logger->info("Shader deleted");
 	}
@@ -27,99 +53,294 @@ namespace GE::OpenGL {
 
 	# pragma region Private functions
 
-	// Create a shader module from a file
-	GLuint Shader::make_module(const std::string &filepath, GLuint module_type) {
-		std::ifstream file(filepath);
-		std::stringstream buffer;
-		std::string line;
+	// Submit the compilation of a shader module, its status is checked by check_program()
+	GLuint Shader::make_module(const std::string &source, GLuint module_type) {
+		const char *shaderSource = source.c_str();
 
-		if (logger) logger->trace("> Compiling shader : " + filepath);
+		GLuint shaderModule = glCreateShader(module_type);
+		glShaderSource(shaderModule, 1, &shaderSource, nullptr);
+		glCompileShader(shaderModule);
 
-		if (!file.is_open())
-			throw std::runtime_error("Failed to open file " + filepath);
+		return shaderModule;
+	}
 
-		while (getline(file, line))
-			buffer << line << '\n';
-		file.close();
+	// Submit the link of a program, its status is checked by check_program()
+	GLuint Shader::make_program(const std::vector<GLuint> &modules) {
+		GLuint program = glCreateProgram();
 
-		std::string shaderSourceStr = buffer.str();			// Cause corruption if
-		const char *shaderSource = shaderSourceStr.c_str(); // in a single line
+		for (GLuint module : modules)
+			glAttachShader(program, module);
 
-		GLuint shaderModule = glCreateShader(module_type);
-		glShaderSource(shaderModule, 1, &shaderSource, nullptr);
-		glCompileShader(shaderModule);
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glLinkProgram(program);
 
+		return program;
+	}
+
+	// Wait for a program made by make_program(), delete it and throw the compile or link log on failure
+	// The modules are left to the caller, they may be flagged for deletion already as long as they are attached
+	void Shader::check_program(GLuint program, const std::vector<GLuint> &modules, const std::vector<std::string> &paths) {
+		std::string error;
 		int success;
-		glGetShaderiv(shaderModule, GL_COMPILE_STATUS, &success);
+
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
 		if (!success) {
 			std::string infoLog;
 			infoLog.resize(1024);
-			glGetShaderInfoLog(shaderModule, 1024, nullptr, (GLchar *)infoLog.data());
-			throw std::runtime_error("Failed to compile shader " + filepath + ":\n" + infoLog);
-		}
 
-		if (logger) logger->trace("Shader compiled");
+			// Report the module that failed to compile, if any
+			for (size_t i = 0; i < modules.size() && error.empty(); i++) {
+				glGetShaderiv(modules[i], GL_COMPILE_STATUS, &success);
+				if (!success) {
+					glGetShaderInfoLog(modules[i], 1024, nullptr, (GLchar *)infoLog.data());
+					error = "Failed to compile shader " + paths[i] + ":\n" + infoLog;
+				}
+			}
+
+			if (error.empty()) {
+				glGetProgramInfoLog(program, 1024, nullptr, (GLchar *)infoLog.data());
+				error = "Failed to link shader:\n" + infoLog;
+			}
+		}
 
-		return shaderModule;
+		if (!error.empty()) {
+			glDeleteProgram(program);
+			throw std::runtime_error(error);
+		}
 	}
 
-	// Create a shader from the modules
+	// Create a shader from the program binary cache, or from the modules
 	GLuint Shader::make_shader() {
-		std::vector<GLuint> shadersIDs;
+		GE_PROFILE_SCOPE("Shader::make_shader");
+
+		std::vector<std::string> paths = {vertexPath, fragmentPath};
+		std::vector<ShaderSource> stages;
+		std::vector<std::string> sources;
+
+		// Modules kept by a hot reload would mix with stale stages
+		release_modules();
 
-		shadersIDs.push_back(make_module(vertexPath, GL_VERTEX_SHADER));
-		shadersIDs.push_back(make_module(fragmentPath, GL_FRAGMENT_SHADER));
 		if (!geometryPath.empty())
-			shadersIDs.push_back(make_module(geometryPath, GL_GEOMETRY_SHADER));
+			paths.push_back(geometryPath);
+		for (const std::string &path : paths)
+			stages.push_back(ShaderPreprocessor::process(path, defines));
+
+		track_dependencies(stages);
+		for (ShaderSource &stage : stages)
+			sources.push_back(std::move(stage.code));
 
-		if (logger) logger->trace("> Linking shader program");
+		ProgramCacheGL &	cache = ProgramCacheGL::getInstance();
+		const uint64_t		key = cache.makeKey(sources);
 
-		GLuint shader = glCreateProgram();
-		for (GLuint module = 0; module < shadersIDs.size(); module++) {
-			glAttachShader(shader, shadersIDs[module]);
-			glDeleteShader(shadersIDs[module]);
+		if (GLuint shader = cache.load(key)) {
+			if (logger) logger->trace("Shader program loaded from the binary cache");
+			return shader;
 		}
 
-		glLinkProgram(shader);
+		const auto	start = std::chrono::steady_clock::now();
+		std::vector<GLuint> shadersIDs;
+
+		// Every module is submitted before any status is queried, so the driver can compile them in parallel
+		if (logger) logger->trace("> Compiling and linking shader program");
+		for (size_t i = 0; i < sources.size(); i++)
+			shadersIDs.push_back(make_module(sources[i], MODULE_TYPES[i]));
 
-		int success;
-		glGetProgramiv(shader, GL_LINK_STATUS, &success);
-		if (!success) {
-			std::string infoLog;
-			infoLog.resize(1024);
-			glGetProgramInfoLog(shader, 1024, nullptr, (GLchar *)infoLog.data());
-			throw std::runtime_error("Failed to link shader:\n" + infoLog);
-		}
+		// Attached, the modules live until the program is deleted
+		GLuint shader = make_program(shadersIDs);
+		for (GLuint module : shadersIDs)
+			glDeleteShader(module);
+		check_program(shader, shadersIDs, paths);
+
+		cache.store(key, shader, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
 
 		if (logger) logger->trace("Shader program linked");
 
 		return shader;
 	}
 
+	// Record the files the stages were made of, and their modification time
+	// Stages without files were not preprocessed again and keep their dependencies
+	void Shader::track_dependencies(const std::vector<ShaderSource> &stages) {
+		dependencies.erase(std::remove_if(dependencies.begin(), dependencies.end(), [&stages](const Dependency &dependency) {
+			return dependency.stage < stages.size() && !stages[dependency.stage].files.empty();
+		}), dependencies.end());
+
+		for (size_t stage = 0; stage < stages.size(); stage++) {
+			for (const std::string &file : stages[stage].files) {
+				std::error_code	error;
+
+				dependencies.push_back({file, std::filesystem::last_write_time(file, error), stage});
+			}
+		}
+	}
+
+	// Return whether a stage includes a file, or is the file
+	bool Shader::depends_on(size_t stage, const std::string &file) const {
+		for (const Dependency &dependency : dependencies)
+			if (dependency.stage == stage && dependency.path == file)
+				return true;
+		return false;
+	}
+
+	// Delete the modules kept for hot reload
+	void Shader::release_modules() {
+		for (GLuint module : modules)
+			if (module)
+				glDeleteShader(module);
+		modules.clear();
+	}
+
+	// Make a linked program the program of this shader
+	void Shader::set_program(GLuint program) {
+		shaderID = program;
+		load_uniforms();
+		bind_blocks();
+	}
+
+	// List the active uniforms of the program and store their locations
+	// Arrays are stored as "name" and "name[0]", then one slot per element at consecutive locations
+	void Shader::load_uniforms() {
+		for (UniformSlot &slot : uniforms) {
+			slot.location = -1;
+			slot.type = GL_NONE;
+		}
+
+		GLint	count = 0;
+		GLint	maxLength = 0;
+
+		glGetProgramiv(shaderID, GL_ACTIVE_UNIFORMS, &count);
+		glGetProgramiv(shaderID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+		std::string	buffer(std::max(maxLength, 1), '\0');
+		size_t		active = 0;
+
+		for (GLint i = 0; i < count; i++) {
+			GLsizei	length = 0;
+			GLint	size = 0;
+			GLenum	type = GL_NONE;
+
+			glGetActiveUniform(shaderID, i, maxLength, &length, &size, &type, (GLchar *)buffer.data());
+
+			std::string	name(buffer.data(), length);
+			const bool	array = name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0;
+			if (array)
+				name.resize(name.size() - 3);
+
+			// Members of uniform blocks have no location
+			const GLint	location = glGetUniformLocation(shaderID, name.c_str());
+			if (location < 0)
+				continue;
+
+			const auto	store = [&](const std::string &slotName, GLint slotLocation) {
+				UniformSlot &	slot = uniforms[uniform_index(slotName)];
+
+				slot.location = slotLocation;
+				slot.type = type;
+			};
+
+			store(name, location);
+			if (array)
+				for (GLint element = 0; element < size; element++)
+					store(name + "[" + std::to_string(element) + "]", location + element);
+			active++;
+		}
+
+		if (logger) logger->trace("Shader has " + std::to_string(active) + " active uniforms");
+	}
+
+	// Attach the blocks shared by the framework to their reserved binding points
+	void Shader::bind_blocks() {
+		const GLuint	frameConstants = glGetUniformBlockIndex(shaderID, FRAME_CONSTANTS_BLOCK);
+
+		if (frameConstants != GL_INVALID_INDEX)
+			glUniformBlockBinding(shaderID, frameConstants, FRAME_CONSTANTS_BINDING);
+	}
+
+	// Return the index of a uniform slot, adding an inactive one if the name is unknown
+	uint32_t Shader::uniform_index(const std::string &name) {
+		const uint64_t	hash = hashUniformName(name);
+		const auto		it = uniformIndices.find(hash);
+
+		if (it != uniformIndices.end()) {
+			if (uniforms[it->second].name != name)
+				throw std::runtime_error("Shader: Uniform name hash collision - " + name + ", " + uniforms[it->second].name);
+			return it->second;
+		}
+
+		uniforms.push_back({name, -1, GL_NONE});
+		uniformIndices.emplace(hash, (uint32_t)uniforms.size() - 1);
+		return (uint32_t)uniforms.size() - 1;
+	}
+
+	// Return the location of a uniform from its name hash, -1 if unknown
+	GLint Shader::uniform_location(uint64_t hash) const {
+		const auto	it = uniformIndices.find(hash);
+
+		return it != uniformIndices.end() ? uniforms[it->second].location : -1;
+	}
+
+	void Shader::upload(GLint location, bool value) {
+		glUniform1i(location, (int)value);
+	}
+
+	void Shader::upload(GLint location, int value) {
+		glUniform1i(location, value);
+	}
+
+	void Shader::upload(GLint location, float value) {
+		glUniform1f(location, value);
+	}
+
+	void Shader::upload(GLint location, const glm::vec2 &value) {
+		glUniform2f(location, value[0], value[1]);
+	}
+
+	void Shader::upload(GLint location, const glm::vec3 &value) {
+		glUniform3f(location, value[0], value[1], value[2]);
+	}
+
+	void Shader::upload(GLint location, const glm::vec4 &value) {
+		glUniform4f(location, value[0], value[1], value[2], value[3]);
+	}
+
+	void Shader::upload(GLint location, const glm::mat4 &value) {
+		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
 	# pragma endregion
 
 	# pragma region Public functions
 
-	// Set this shader as the current shader
+	// Set this shader as the current shader, skipped if it already is
 	void Shader::use() {
-		glUseProgram(shaderID);
+		StateCacheGL::getInstance().useProgram(shaderID);
 	}
 
 	// Recompile the shader
 	void Shader::recompile() {
 		if (logger) logger->info("Recompiling shader");
 
-		glUseProgram(0);
-		glDeleteProgram(shaderID);
+		StateCacheGL::getInstance().useProgram(0);
+		StateCacheGL::getInstance().deleteProgram(shaderID);
 
+		shaderID = 0;
 		try {
-			shaderID = make_shader();
+			set_program(make_shader());
 		}
 		catch (const std::exception &e) {
+			for (UniformSlot &slot : uniforms) {
+				slot.location = -1;
+				slot.type = GL_NONE;
+			}
+			state = ShaderState::FAILED;
+
 			if (logger) logger->error("Failed to recompile shader: " + std::string(e.what()));
 			return;
 		}
 
+		// Locations may have moved, set_program() kept the handles index
+		state = ShaderState::READY;
+
 		if (logger) logger->info("Shader recompiled");
 	}
 
@@ -129,37 +350,37 @@ namespace GE::OpenGL {
 
 	// Set a boolean uniform
 	void Shader::setUniform(const std::string &name, bool value) {
-		glUniform1i(glGetUniformLocation(shaderID, name.c_str()), (int)value);
+		upload(uniform_location(hashUniformName(name)), value);
 	}
 
 	// Set an integer uniform
 	void Shader::setUniform(const std::string &name, int value) {
-		glUniform1i(glGetUniformLocation(shaderID, name.c_str()), value);
+		upload(uniform_location(hashUniformName(name)), value);
 	}
 
 	// Set a float uniform
 	void Shader::setUniform(const std::string &name, float value) {
-		glUniform1f(glGetUniformLocation(shaderID, name.c_str()), value);
+		upload(uniform_location(hashUniformName(name)), value);
 	}
 
 	// Set a vec2 uniform
 	void Shader::setUniform(const std::string &name, glm::vec2 value) {
-		glUniform2f(glGetUniformLocation(shaderID, name.c_str()), value[0], value[1]);
+		upload(uniform_location(hashUniformName(name)), value);
 	}
 
 	// Set a vec3 uniform
 	void Shader::setUniform(const std::string &name, glm::vec3 value) {
-		glUniform3f(glGetUniformLocation(shaderID, name.c_str()), value[0], value[1], value[2]);
+		upload(uniform_location(hashUniformName(name)), value);
 	}
 
 	// Set a vec4 uniform
 	void Shader::setUniform(const std::string &name, glm::vec4 value) {
-		glUniform4f(glGetUniformLocation(shaderID, name.c_str()), value[0], value[1], value[2], value[3]);
+		upload(uniform_location(hashUniformName(name)), value);
 	}
 
 	// Set a mat4 uniform
 	void Shader::setUniform(const std::string &name, glm::mat4 value) {
-		glUniformMatrix4fv(glGetUniformLocation(shaderID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+		upload(uniform_location(hashUniformName(name)), value);
 	}
 	
 	# pragma endregion
@@ -171,6 +392,37 @@ namespace GE::OpenGL {
 		return shaderID;
 	}
 
+	// Return whether the program is linked and usable
+	bool Shader::isReady() const {
+		return state == ShaderState::READY;
+	}
+
+	// Return the state of the program
+	ShaderState Shader::getState() const {
+		return state;
+	}
+
+	// Return the defines the shader is compiled with
+	const ShaderDefines &Shader::getDefines() const {
+		return defines;
+	}
+
+	// Return whether a file of the shader, includes comprised, changed since it was compiled
+	bool Shader::isOutdated() const {
+		for (const Dependency &dependency : dependencies) {
+			std::error_code	error;
+
+			if (std::filesystem::last_write_time(dependency.path, error) != dependency.time)
+				return true;
+		}
+		return false;
+	}
+
+	// Return whether the uniform is active in the current program
+	bool Shader::hasUniform(const std::string &name) const {
+		return uniform_location(hashUniformName(name)) >= 0;
+	}
+
 	# pragma endregion
 	
 } // namespace GE::OpenGL
\ No newline at end of file
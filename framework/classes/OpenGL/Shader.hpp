@@ -2,12 +2,23 @@
 
 /// Includes
 # include "core/Logger.hpp"
+# include "core/Profiler.hpp"
+# include "StateCacheGL.hpp"
+# include "FrameConstantsGL.hpp"
+# include "ProgramCacheGL.hpp"
+# include "ShaderPreprocessor.hpp"
 
 /// System includes
 # include <iostream>
 # include <algorithm>
 # include <sstream>
 # include <fstream>
+# include <chrono>
+# include <filesystem>
+# include <cstdint>
+# include <string_view>
+# include <type_traits>
+# include <unordered_map>
 # include <vector>
 
 /// Dependencies
@@ -16,18 +27,83 @@
 # include <glm/gtc/type_ptr.hpp>
 
 namespace GE::OpenGL {
+	/// @brief Hash of a uniform name (64 bits FNV-1a), usable at compile time
+	constexpr uint64_t	hashUniformName(std::string_view name) {
+		uint64_t	hash = 0xcbf29ce484222325ull;
+
+		for (char c : name)
+			hash = (hash ^ (uint8_t)c) * 0x100000001b3ull;
+		return hash;
+	}
+
+	/// @brief A uniform name hashed ahead of time, see operator""_uniform
+	struct UniformName {
+		uint64_t	hash;
+	};
+
+	/// @brief Hash a uniform name literal, e.g. shader.setUniform("view"_uniform, view)
+	/// @note Folded at compile time when used in a constant expression (e.g. a static constexpr UniformName)
+	constexpr UniformName	operator""_uniform(const char *name, size_t length) {
+		return {hashUniformName(std::string_view(name, length))};
+	}
+
+	/// @brief A typed handle to a uniform of a Shader, see Shader::getUniform()
+	/// @note Stays valid across recompile()
+	template <typename T>
+	struct Uniform {
+		using Type = T;
+
+		uint32_t	index = UINT32_MAX;
+
+		bool	isValid() const { return index != UINT32_MAX; }
+	};
+
+	class ShaderCompiler;
+
+	/// @brief The state of a Shader program
+	enum class ShaderState {
+		PENDING,	// Queued or compiling in a ShaderCompiler, use() binds no program
+		READY,		// Linked
+		FAILED		// Failed to compile or link, use() binds no program
+	};
+
 	/// @brief The Shader class is a wrapper around an OpenGL shader program.
 	///
 	/// It handles the creation, destruction and recompilation of the shader program.
 	///
 	/// It also provides methods to set uniform variables in the shader program.
+	///
+	/// The active uniforms are listed once after linking, so setting a uniform never queries the driver.
+	/// From the fastest to the slowest, a uniform is set through :
+	///  - a Uniform<T> handle resolved once with getUniform(), a direct index
+	///  - a UniformName hashed at compile time ("name"_uniform), a hash lookup
+	///  - a std::string, hashed on each call then looked up
+	///
+	/// Arrays are set from their first element through "name" or "name[0]", or from any element through "name[i]".
+	///
+	/// Setting a uniform the program does not have is ignored, as OpenGL does with location -1.
+	///
+	/// Linked programs go through the ProgramCacheGL, a program already compiled by a previous run is
+	/// loaded from its binary instead of compiled.
+	///
+	/// A program declaring the FrameConstants uniform block is bound to FRAME_CONSTANTS_BINDING automatically,
+	/// see FrameConstantsGL.
+	///
+	/// Sources go through the ShaderPreprocessor : stages share code with #include, and a define set builds a
+	/// specialized variant of the program instead of branching at runtime (see ShaderVariants).
+	///
+	/// The modules of a program are all submitted before any status is queried. To build many programs at once
+	/// without stalling on each, create them through a ShaderCompiler.
 	class Shader {
+		friend class ShaderCompiler;
+
 		public:
 			Shader(
 				const std::string &vertexPath,
 				const std::string &fragmentPath,
 				const std::string &geometryPath = "",
-				Core::Logger *logger = nullptr
+				Core::Logger *logger = nullptr,
+				const ShaderDefines &defines = {}
 			);
 			~Shader();
 
@@ -38,6 +114,11 @@ namespace GE::OpenGL {
 
 			/// Uniforms setters
 
+			template <typename T>
+			void	setUniform(Uniform<T> uniform, const typename Uniform<T>::Type &value);
+			template <typename T>
+			void	setUniform(UniformName name, const T &value);
+
 			void    setUniform(const std::string &name, bool value);
 			void    setUniform(const std::string &name, int value);
 			void    setUniform(const std::string &name, float value);
@@ -49,18 +130,136 @@ namespace GE::OpenGL {
 			/// Getters
 
 			const GLuint &getID() const;
+			bool		isReady() const;
+			ShaderState	getState() const;
+			const ShaderDefines &getDefines() const;
+			bool		isOutdated() const;
+
+			template <typename T>
+			Uniform<T>	getUniform(const std::string &name);
+			bool		hasUniform(const std::string &name) const;
 
 		private:
+			// A uniform known by the shader, active or not in the current program
+			struct UniformSlot {
+				std::string	name;
+				GLint		location;	// -1 if not active
+				GLenum		type;		// GL_NONE if not active
+			};
+
+			// Module types, in the order of the paths
+			static constexpr GLuint	MODULE_TYPES[] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER};
+
+			// Tag of the deferred constructor
+			struct Deferred {};
+
+			// A file the program was made of
+			struct Dependency {
+				std::string						path;
+				std::filesystem::file_time_type	time;	// When it was read, or the default value if missing
+				size_t							stage;	// Index in MODULE_TYPES
+			};
+
 			GLuint		shaderID;
+			ShaderState	state = ShaderState::PENDING;
 			std::string	vertexPath;
 			std::string	fragmentPath;
 			std::string	geometryPath;
+			ShaderDefines			defines;
+			std::vector<Dependency>	dependencies;	// Stages and includes, see isOutdated()
+			std::vector<GLuint>		modules;		// Per stage, kept once hot reloaded so only changed stages compile again
+
+			std::vector<UniformSlot>				uniforms;		// Never shrinks, handles index it
+			std::unordered_map<uint64_t, uint32_t>	uniformIndices;	// Name hash to uniforms index
 
 			Core::Logger	*logger = nullptr;
 
+			Shader(
+				Deferred,
+				const std::string &vertexPath,
+				const std::string &fragmentPath,
+				const std::string &geometryPath,
+				Core::Logger *logger,
+				const ShaderDefines &defines
+			);
+
 			/// Private functions
 
-			GLuint	make_module(const std::string &filepath, GLuint module_type);
-			GLuint	make_shader();
+			GLuint		make_shader();
+			void		set_program(GLuint program);
+			void		track_dependencies(const std::vector<ShaderSource> &stages);
+			bool		depends_on(size_t stage, const std::string &file) const;
+			void		release_modules();
+			void		load_uniforms();
+			void		bind_blocks();
+			uint32_t	uniform_index(const std::string &name);
+			GLint		uniform_location(uint64_t hash) const;
+
+			static GLuint		make_module(const std::string &source, GLuint module_type);
+			static GLuint		make_program(const std::vector<GLuint> &modules);
+			static void			check_program(GLuint program, const std::vector<GLuint> &modules, const std::vector<std::string> &paths);
+
+			static void	upload(GLint location, bool value);
+			static void	upload(GLint location, int value);
+			static void	upload(GLint location, float value);
+			static void	upload(GLint location, const glm::vec2 &value);
+			static void	upload(GLint location, const glm::vec3 &value);
+			static void	upload(GLint location, const glm::vec4 &value);
+			static void	upload(GLint location, const glm::mat4 &value);
 	};
+
+	/// @brief Set a uniform through a handle, without any lookup
+	/// @param uniform A handle returned by getUniform()
+	/// @param value The value to set
+	/// @note The shader must be in use
+	template <typename T>
+	void	Shader::setUniform(Uniform<T> uniform, const typename Uniform<T>::Type &value) {
+		if (uniform.index < uniforms.size())
+			upload(uniforms[uniform.index].location, value);
+	}
+
+	/// @brief Set a uniform by its hashed name
+	/// @param name The hashed name, e.g. "view"_uniform
+	/// @param value The value to set
+	/// @note The shader must be in use
+	template <typename T>
+	void	Shader::setUniform(UniformName name, const T &value) {
+		upload(uniform_location(name.hash), value);
+	}
+
+	/// @brief Resolve a uniform name to a typed handle, meant to be done once
+	/// @param name The uniform name, "name" or "name[0]" for a whole array, "name[i]" for one element
+	/// @return The handle, still valid after recompile() even if the uniform was not active before
+	/// @throw std::invalid_argument if the uniform is active with a type T cannot be set to
+	template <typename T>
+	Uniform<T>	Shader::getUniform(const std::string &name) {
+		const uint32_t	index = uniform_index(name);
+		const GLenum	type = uniforms[index].type;
+		bool			compatible = true;
+
+		if (type != GL_NONE) {
+			if constexpr (std::is_same_v<T, float>)
+				compatible = type == GL_FLOAT;
+			else if constexpr (std::is_same_v<T, glm::vec2>)
+				compatible = type == GL_FLOAT_VEC2;
+			else if constexpr (std::is_same_v<T, glm::vec3>)
+				compatible = type == GL_FLOAT_VEC3;
+			else if constexpr (std::is_same_v<T, glm::vec4>)
+				compatible = type == GL_FLOAT_VEC4;
+			else if constexpr (std::is_same_v<T, glm::mat4>)
+				compatible = type == GL_FLOAT_MAT4;
+			else {
+				// Booleans, integers and samplers are all set with glUniform1i
+				static_assert(std::is_same_v<T, bool> || std::is_same_v<T, int>, "Shader: Unsupported uniform type");
+				compatible = type != GL_FLOAT && type != GL_FLOAT_VEC2 && type != GL_FLOAT_VEC3 &&
+							 type != GL_FLOAT_VEC4 && type != GL_FLOAT_MAT4;
+			}
+		}
+
+		if (!compatible)
+			throw std::invalid_argument("Shader: Uniform type mismatch - " + name);
+
+		return {index};
+	}
+
 } // namespace GE::OpenGL
\ No newline at end of file
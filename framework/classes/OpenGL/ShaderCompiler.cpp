@@ -0,0 +1,454 @@
+#include "ShaderCompiler.hpp"
+
+/// System includes
+# include <algorithm>
+# include <cstring>
+# include <unordered_set>
+
+// GL_KHR_parallel_shader_compile, not part of every glad profile
+# ifndef GL_COMPLETION_STATUS_KHR
+#  define GL_COMPLETION_STATUS_KHR 0x91B1
+# endif
+
+namespace GE::OpenGL {
+
+	static bool	hasExtension(const char *name) {
+		GLint	count = 0;
+
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (GLint i = 0; i < count; i++) {
+			const GLubyte *	extension = glGetStringi(GL_EXTENSIONS, i);
+
+			if (extension && !std::strcmp(reinterpret_cast<const char *>(extension), name))
+				return true;
+		}
+		return false;
+	}
+
+	static double	elapsed(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	# pragma region Constructors & Destructors
+
+	/// @param threadCount The number of file reading threads, 0 means one per hardware thread minus the calling one
+	/// @param logger The logger the failed programs are reported to, if any
+	/// @note The context must be current : the extension is looked up here
+	ShaderCompiler::ShaderCompiler(size_t threadCount, Core::Logger *logger) : _logger(logger), _readers(threadCount) {
+		// The driver starts with an unlimited number of compiler threads (GL_MAX_SHADER_COMPILER_THREADS_KHR is
+		// 0xFFFFFFFF by default), only the completion status is needed
+		_parallel = hasExtension("GL_KHR_parallel_shader_compile");
+
+		if (_logger) _logger->trace(std::string("Shader compiler created, parallel compilation ") + (_parallel ? "enabled" : "unavailable"));
+	}
+
+	/// @note Programs not finished yet are dropped, the shaders not built yet are left FAILED
+	ShaderCompiler::~ShaderCompiler() {
+		_unwatchAll();
+
+		for (std::vector<Job> *jobs : {&_queued, &_reloads}) {
+			for (Job &job : *jobs) {
+				if (job.stages.valid())
+					job.stages.wait();
+				if (!job.reload)
+					job.shader->state = ShaderState::FAILED;
+			}
+		}
+
+		for (Job &job : _compiling) {
+			if (job.keep) {
+				for (size_t i = 0; i < job.modules.size(); i++)
+					if (job.rebuild[i])
+						glDeleteShader(job.modules[i]);
+			}
+			StateCacheGL::getInstance().deleteProgram(job.program);
+
+			if (!job.reload)
+				job.shader->state = ShaderState::FAILED;
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Public functions
+
+	/// @brief Queue a program, its files are read right away on a worker thread
+	/// @param vertexPath The path to the vertex shader
+	/// @param fragmentPath The path to the fragment shader
+	/// @param geometryPath The path to the geometry shader, if any
+	/// @param defines The defines of the variant
+	/// @return The shader, pending until submit() and poll() finish it
+	/// @note Files are preprocessed on the worker too
+	std::shared_ptr<Shader>	ShaderCompiler::add(
+		const std::string &vertexPath,
+		const std::string &fragmentPath,
+		const std::string &geometryPath,
+		const ShaderDefines &defines
+	) {
+		Job	job;
+
+		job.shader = std::shared_ptr<Shader>(new Shader(Shader::Deferred{}, vertexPath, fragmentPath, geometryPath, _logger, defines));
+		job.paths = {vertexPath, fragmentPath};
+		if (!geometryPath.empty())
+			job.paths.push_back(geometryPath);
+		job.rebuild.assign(job.paths.size(), true);
+		job.keep = _watcher != nullptr;
+
+		_read(job, defines);
+		_queued.push_back(std::move(job));
+		return _queued.back().shader;
+	}
+
+	/// @brief Queue a rebuild of the stages of a shader affected by changed files, started by poll()
+	/// @param shader The shader, built by this compiler or not
+	/// @param changed The changed files, stages or includes. Empty rebuilds every stage
+	/// @note The shader keeps its program until the new one links, a failure only logs
+	/// @note Stages without a kept module are always rebuilt, i.e. every stage on the first reload of an unwatched shader
+	void	ShaderCompiler::reload(const std::shared_ptr<Shader> &shader, const std::vector<std::string> &changed) {
+		Job	job;
+
+		job.shader = shader;
+		job.paths = {shader->vertexPath, shader->fragmentPath};
+		if (!shader->geometryPath.empty())
+			job.paths.push_back(shader->geometryPath);
+		job.reload = true;
+		job.keep = true;
+
+		for (size_t stage = 0; stage < job.paths.size(); stage++) {
+			bool	rebuild = changed.empty() || stage >= shader->modules.size() || !shader->modules[stage];
+
+			for (size_t i = 0; i < changed.size() && !rebuild; i++)
+				rebuild = shader->depends_on(stage, changed[i]);
+			job.rebuild.push_back(rebuild);
+		}
+
+		_read(job, shader->defines);
+		_reloads.push_back(std::move(job));
+	}
+
+	/// @brief Watch the files of a shader made elsewhere, reloading it on change
+	/// @param shader The shader, which must be built (the files it depends on are known from its build)
+	/// @throw std::logic_error if no file watcher is set
+	/// @note Shaders built by this compiler are watched already. A destroyed shader is forgotten on its next change
+	void	ShaderCompiler::watch(const std::shared_ptr<Shader> &shader) {
+		if (!_watcher)
+			throw std::logic_error("ShaderCompiler: No file watcher, see setFileWatcher()");
+
+		Shader *						key = shader.get();
+		WatchedShader &					entry = _watched[key];
+		std::unordered_set<std::string>	files;
+
+		for (size_t id : entry.ids)
+			_watcher->unwatch(id);
+		entry.ids.clear();
+		entry.shader = shader;
+
+		for (const Shader::Dependency &dependency : shader->dependencies) {
+			if (!files.insert(dependency.path).second)
+				continue;
+
+			entry.ids.push_back(_watcher->watch(dependency.path, [this, key](const std::string &path) {
+				std::vector<std::string> &	changed = _watched[key].changed;
+
+				if (std::find(changed.begin(), changed.end(), path) == changed.end())
+					changed.push_back(path);
+			}));
+		}
+	}
+
+	/// @brief Compile and link every queued program, without querying any status
+	/// @note Waits for the file reads. Cached programs are ready on return, the others are finished by poll()
+	void	ShaderCompiler::submit() {
+		if (_queued.empty())
+			return;
+
+		std::vector<Job>	batch = std::move(_queued);
+		std::vector<Job *>	compiled;
+
+		_queued.clear();
+		_batchStart = Clock::now();
+
+		// Every module first, so the driver compiles all of them while the programs are linked
+		for (Job &job : batch)
+			if (_compile(job))
+				compiled.push_back(&job);
+
+		for (Job *job : compiled)
+			_link(*job);
+
+		if (_compiling.empty())
+			_stats.lastBatch = elapsed(_batchStart);
+	}
+
+	/// @brief Start the reloads whose files are read, and finish the programs the driver is done with
+	/// @return The number of programs still compiling or reloading
+	/// @note Never blocks with GL_KHR_parallel_shader_compile, otherwise finishes every started program
+	size_t	ShaderCompiler::poll() {
+		if (_watcher)
+			_queueReloads();
+
+		// Reloads are started once preprocessed, a slow read never blocks the frame
+		std::vector<Job>	reading;
+
+		for (Job &job : _reloads) {
+			if (job.stages.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+				reading.push_back(std::move(job));
+			else if (_compile(job))
+				_link(job);
+		}
+		_reloads = std::move(reading);
+
+		if (_compiling.empty())
+			return _reloads.size();
+
+		size_t	remaining = 0;
+		bool	batch = false;
+
+		for (size_t i = 0; i < _compiling.size(); i++) {
+			batch |= !_compiling[i].reload;
+			if (_finishJob(_compiling[i], !_parallel))
+				continue;
+			if (remaining != i)
+				_compiling[remaining] = std::move(_compiling[i]);
+			remaining++;
+		}
+		_compiling.resize(remaining);
+
+		if (batch && _compiling.empty())
+			_stats.lastBatch = elapsed(_batchStart);
+
+		return remaining + _reloads.size();
+	}
+
+	/// @brief Submit the queued programs and wait for every one of them, pending reloads comprised
+	void	ShaderCompiler::finish() {
+		submit();
+
+		for (Job &job : _reloads)
+			if (_compile(job))
+				_link(job);
+		_reloads.clear();
+
+		for (Job &job : _compiling)
+			_finishJob(job, true);
+		_compiling.clear();
+
+		_stats.lastBatch = elapsed(_batchStart);
+	}
+
+	# pragma endregion
+
+	# pragma region Private functions
+
+	// Preprocess the stages to rebuild on a worker
+	void	ShaderCompiler::_read(Job &job, const ShaderDefines &defines) {
+		job.stages = _readers.submit([paths = job.paths, rebuild = job.rebuild, defines]() {
+			std::vector<ShaderSource>	stages(paths.size());
+
+			for (size_t i = 0; i < paths.size(); i++)
+				if (rebuild[i])
+					stages[i] = ShaderPreprocessor::process(paths[i], defines);
+			return stages;
+		});
+	}
+
+	// Submit the modules of a program, return false if it is done already (cache hit or failure)
+	bool	ShaderCompiler::_compile(Job &job) {
+		ProgramCacheGL &			cache = ProgramCacheGL::getInstance();
+		std::vector<ShaderSource>	stages;
+
+		job.start = Clock::now();
+		_stats.submitted += !job.reload;
+
+		try {
+			stages = job.stages.get();
+		}
+		catch (const std::exception &e) {
+			_fail(job, e.what());
+			return false;
+		}
+
+		// Includes may have changed, so do the watched files
+		job.shader->track_dependencies(stages);
+		if (_watcher && (!job.reload || _watched.count(job.shader.get())))
+			watch(job.shader);
+
+		if (!job.reload) {
+			std::vector<std::string>	sources;
+
+			for (const ShaderSource &stage : stages)
+				sources.push_back(stage.code);
+
+			job.key = cache.makeKey(sources);
+			if ((job.program = cache.load(job.key))) {
+				job.shader->set_program(job.program);
+				job.shader->state = ShaderState::READY;
+				_stats.ready++;
+				_stats.cacheHits++;
+				return false;
+			}
+		}
+
+		for (size_t i = 0; i < stages.size(); i++) {
+			if (job.rebuild[i])
+				job.modules.push_back(Shader::make_module(stages[i].code, Shader::MODULE_TYPES[i]));
+			else
+				job.modules.push_back(job.shader->modules[i]);
+		}
+		return true;
+	}
+
+	// Submit the link of a program and move its job to the compiling ones
+	void	ShaderCompiler::_link(Job &job) {
+		job.program = Shader::make_program(job.modules);
+
+		// Attached, the modules live until the program is deleted
+		if (!job.keep) {
+			for (GLuint module : job.modules)
+				glDeleteShader(module);
+		}
+
+		_compiling.push_back(std::move(job));
+	}
+
+	// Finish a program, or return false if it is still compiling and wait is not set
+	bool	ShaderCompiler::_finishJob(Job &job, bool wait) {
+		if (!wait) {
+			GLint	completed = GL_FALSE;
+
+			glGetProgramiv(job.program, GL_COMPLETION_STATUS_KHR, &completed);
+			if (!completed)
+				return false;
+		}
+
+		try {
+			Shader::check_program(job.program, job.modules, job.paths);
+		}
+		catch (const std::exception &e) {
+			if (job.keep) {
+				for (size_t i = 0; i < job.modules.size(); i++)
+					if (job.rebuild[i])
+						glDeleteShader(job.modules[i]);
+			}
+			_fail(job, e.what());
+			return true;
+		}
+
+		Shader &	shader = *job.shader;
+
+		if (job.keep) {
+			for (size_t i = 0; i < shader.modules.size(); i++)
+				if (job.rebuild[i] && shader.modules[i])
+					glDeleteShader(shader.modules[i]);
+			shader.modules = job.modules;
+		}
+
+		if (job.reload) {
+			const size_t	rebuilt = std::count(job.rebuild.begin(), job.rebuild.end(), true);
+
+			// The old program stays current until the next use(), drawing goes on with it this frame
+			StateCacheGL::getInstance().deleteProgram(shader.shaderID);
+			_stats.reloads++;
+			_stats.reloadedStages += rebuilt;
+
+			if (_logger) _logger->info("Shader " + job.paths[0] + " reloaded in " + std::to_string(elapsed(job.start)) + " ms (" +
+									   std::to_string(rebuilt) + "/" + std::to_string(job.modules.size()) + " stages compiled)");
+		}
+		else {
+			// Compiled alongside the others, this is the time the program waited rather than its own compile time
+			ProgramCacheGL::getInstance().store(job.key, job.program, elapsed(job.start));
+			_stats.ready++;
+		}
+
+		shader.set_program(job.program);
+		shader.state = ShaderState::READY;
+		return true;
+	}
+
+	// A failed reload leaves the shader as it was
+	void	ShaderCompiler::_fail(Job &job, const std::string &error) {
+		if (!job.reload)
+			job.shader->state = ShaderState::FAILED;
+		_stats.failed++;
+
+		if (_logger) _logger->error("Failed to " + std::string(job.reload ? "reload" : "build") + " shader " + job.paths[0] + ": " + error);
+	}
+
+	// Turn the changes noticed by the watcher into reloads, one at a time per shader
+	void	ShaderCompiler::_queueReloads() {
+		for (auto entry = _watched.begin(); entry != _watched.end();) {
+			WatchedShader &	watched = entry->second;
+
+			if (watched.changed.empty()) {
+				++entry;
+				continue;
+			}
+
+			std::shared_ptr<Shader>	shader = watched.shader.lock();
+
+			if (!shader) {
+				for (size_t id : watched.ids)
+					_watcher->unwatch(id);
+				entry = _watched.erase(entry);
+				continue;
+			}
+
+			// Its kept modules may change until the build in flight finishes
+			if (!_isBuilding(shader.get())) {
+				reload(shader, watched.changed);
+				watched.changed.clear();
+			}
+			++entry;
+		}
+	}
+
+	bool	ShaderCompiler::_isBuilding(const Shader *shader) const {
+		for (const std::vector<Job> *jobs : {&_queued, &_reloads, &_compiling})
+			for (const Job &job : *jobs)
+				if (job.shader.get() == shader)
+					return true;
+		return false;
+	}
+
+	void	ShaderCompiler::_unwatchAll() {
+		if (_watcher) {
+			for (const auto &[shader, watched] : _watched)
+				for (size_t id : watched.ids)
+					_watcher->unwatch(id);
+		}
+		_watched.clear();
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return whether GL_KHR_parallel_shader_compile is used, making poll() non-blocking
+	bool	ShaderCompiler::isParallel() const {
+		return _parallel;
+	}
+
+	/// @brief Return the number of programs added, reloaded or submitted and not finished yet
+	size_t	ShaderCompiler::getPendingCount() const {
+		return _queued.size() + _reloads.size() + _compiling.size();
+	}
+
+	/// @brief Return the program and timing counters
+	ShaderCompilerStats	ShaderCompiler::getStats() const {
+		return _stats;
+	}
+
+	# pragma endregion
+
+	# pragma region Setters
+
+	/// @brief Set the watcher used for hot reload, the programs built from now on are watched
+	/// @param watcher The watcher, polled by the caller before poll(). It must outlive the compiler, or nullptr to stop watching
+	void	ShaderCompiler::setFileWatcher(Utils::FileWatcher *watcher) {
+		_unwatchAll();
+		_watcher = watcher;
+	}
+
+	# pragma endregion
+
+} // namespace GE::OpenGL
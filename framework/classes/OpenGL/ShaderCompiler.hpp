@@ -0,0 +1,132 @@
+#pragma once
+
+/// Includes
+# include "Shader.hpp"
+# include "Utils/ThreadPool.hpp"
+# include "Utils/FileWatcher.hpp"
+
+/// System includes
+# include <chrono>
+# include <future>
+# include <memory>
+# include <string>
+# include <unordered_map>
+# include <vector>
+
+/// Dependencies
+# include <glad/glad.h>
+
+namespace GE::OpenGL {
+
+	/// @brief Counters of a ShaderCompiler, since its creation
+	struct ShaderCompilerStats {
+		size_t	submitted;		// Programs submitted
+		size_t	ready;			// Programs linked, including cache hits
+		size_t	failed;			// Programs that failed to read, compile or link, reloads comprised
+		size_t	cacheHits;		// Programs loaded from the ProgramCacheGL
+		size_t	reloads;		// Programs swapped by a reload
+		size_t	reloadedStages;	// Modules compiled by the reloads, the other stages were reused
+		double	lastBatch;		// Milliseconds from the last submit() until its last program was done
+	};
+
+	/**
+	 * @brief Builds many Shader programs at once, without stalling on each of them.
+	 *
+	 * add() returns a pending Shader and reads and preprocesses its files on worker threads. submit() then compiles every module
+	 * and links every program before any status is queried, so the driver works on all of them at the same time.
+	 * With GL_KHR_parallel_shader_compile, poll() only finishes the programs reporting GL_COMPLETION_STATUS_KHR
+	 * and never blocks : the frame loop keeps running while shaders compile. Without it, poll() waits for all of them.
+	 *
+	 * A Shader is usable once isReady(), a failed one keeps ShaderState::FAILED and its error is logged.
+	 * Programs already in the ProgramCacheGL are ready right after submit().
+	 *
+	 * Hot reload : with a Utils::FileWatcher set, the files of every program built here (or given to watch()) are watched,
+	 * and a change queues a reload() of the program, started by poll() :
+	 *  - only the stages including a changed file are preprocessed, on the workers, and compiled again
+	 *  - the modules of the other stages are kept from the previous build and linked as is
+	 *  - the Shader keeps its current program until the new one links, then poll() swaps them ; a failed reload
+	 *    is logged and changes nothing
+	 *
+	 * @note Call the public functions from the thread owning the context, only file reads run on the workers.
+	 */
+	class ShaderCompiler {
+		public:
+			explicit ShaderCompiler(size_t threadCount = 0, Core::Logger *logger = nullptr);
+			~ShaderCompiler();
+
+			ShaderCompiler(const ShaderCompiler &) = delete;
+			ShaderCompiler &operator=(const ShaderCompiler &) = delete;
+
+			/// Public functions
+
+			std::shared_ptr<Shader>	add(
+				const std::string &vertexPath,
+				const std::string &fragmentPath,
+				const std::string &geometryPath = "",
+				const ShaderDefines &defines = {}
+			);
+			void					reload(const std::shared_ptr<Shader> &shader, const std::vector<std::string> &changed = {});
+			void					watch(const std::shared_ptr<Shader> &shader);
+			void					submit();
+			size_t					poll();
+			void					finish();
+
+			/// Getters
+
+			bool				isParallel() const;
+			size_t				getPendingCount() const;
+			ShaderCompilerStats	getStats() const;
+
+			/// Setters
+
+			void	setFileWatcher(Utils::FileWatcher *watcher);
+
+		private:
+			using Clock = std::chrono::steady_clock;
+
+			// A program from add() or reload() to ready or failed
+			struct Job {
+				std::shared_ptr<Shader>					shader;
+				std::vector<std::string>				paths;
+				std::vector<bool>						rebuild;	// Per stage, false reuses the module kept by the Shader
+				std::future<std::vector<ShaderSource>>	stages;		// Preprocessed by a worker, empty for reused stages
+				std::vector<GLuint>						modules;
+				GLuint									program = 0;
+				uint64_t								key = 0;
+				Clock::time_point						start;
+				bool									reload = false;
+				bool									keep = false;	// Modules kept by the Shader for the next reload
+			};
+
+			// A shader whose files are watched
+			struct WatchedShader {
+				std::weak_ptr<Shader>		shader;
+				std::vector<size_t>			ids;		// FileWatcher watches
+				std::vector<std::string>	changed;	// Files changed since its last reload
+			};
+
+			std::vector<Job>	_queued;	// Added, files being read
+			std::vector<Job>	_reloads;	// Reloaded, files being read
+			std::vector<Job>	_compiling;	// Submitted, not finished yet
+			bool				_parallel = false;
+			Clock::time_point	_batchStart;
+
+			Utils::FileWatcher *						_watcher = nullptr;
+			std::unordered_map<Shader *, WatchedShader>	_watched;
+
+			ShaderCompilerStats	_stats = {};
+			Core::Logger *		_logger;
+			Utils::ThreadPool	_readers;
+
+			/// Private functions
+
+			void	_read(Job &job, const ShaderDefines &defines);
+			bool	_compile(Job &job);
+			void	_link(Job &job);
+			bool	_finishJob(Job &job, bool wait);
+			void	_fail(Job &job, const std::string &error);
+			void	_queueReloads();
+			bool	_isBuilding(const Shader *shader) const;
+			void	_unwatchAll();
+	};
+} // namespace GE::OpenGL
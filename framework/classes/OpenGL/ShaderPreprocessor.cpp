@@ -0,0 +1,140 @@
+#include "ShaderPreprocessor.hpp"
+
+/// System includes
+# include <algorithm>
+# include <filesystem>
+# include <fstream>
+# include <stdexcept>
+
+namespace GE::OpenGL {
+
+	static std::string	readFile(const std::string &path) {
+		std::ifstream	file(path, std::ios::binary | std::ios::ate);
+
+		if (!file.is_open())
+			throw std::runtime_error("ShaderPreprocessor: Failed to open file " + path);
+
+		std::string	text(file.tellg(), '\0');
+		file.seekg(0);
+		if (!file.read(text.data(), text.size()))
+			throw std::runtime_error("ShaderPreprocessor: Failed to read file " + path);
+
+		return text;
+	}
+
+	// Return the argument of a `#name` directive, or nullptr if the line is not this directive
+	static const char *	directive(const std::string &line, const char *name) {
+		size_t	i = line.find_first_not_of(" \t");
+
+		if (i == std::string::npos || line[i] != '#')
+			return nullptr;
+
+		i = line.find_first_not_of(" \t", i + 1);
+		const size_t	length = std::char_traits<char>::length(name);
+
+		if (i == std::string::npos || line.compare(i, length, name) != 0)
+			return nullptr;
+		return line.c_str() + i + length;
+	}
+
+	/// @brief Hash a define set, the key of a shader variant
+	uint64_t	hashDefines(const ShaderDefines &defines) {
+		uint64_t	hash = 0xcbf29ce484222325ull;
+
+		for (const auto &[name, value] : defines) {
+			for (char c : name + '=' + value + '\n')
+				hash = (hash ^ (uint8_t)c) * 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	# pragma region Public functions
+
+	/// @brief Preprocess a shader stage
+	/// @param path The path to the stage file
+	/// @param defines The defines to inject
+	/// @return The source to compile and the files it was made of
+	/// @throw std::runtime_error if a file cannot be read or an #include is malformed
+	/// @note Includes are resolved whatever the #if blocks around them
+	ShaderSource	ShaderPreprocessor::process(const std::string &path, const ShaderDefines &defines) {
+		ShaderSource	source;
+
+		_processFile(std::filesystem::path(path).lexically_normal().string(), defines, source);
+		return source;
+	}
+
+	# pragma endregion
+
+	# pragma region Private functions
+
+	void	ShaderPreprocessor::_processFile(const std::string &path, const ShaderDefines &defines, ShaderSource &source) {
+		const std::string	text = readFile(path);
+		const std::string	index = std::to_string(source.files.size());
+		const bool			root = source.files.empty();
+		std::string			defineBlock;
+
+		source.files.push_back(path);
+
+		if (root) {
+			for (const auto &[name, value] : defines)
+				defineBlock += "#define " + name + (value.empty() ? "" : " " + value) + '\n';
+		}
+
+		// Without #version, the defines open the stage
+		if (root && text.find("#version") == std::string::npos)
+			source.code += defineBlock + "#line 1 0\n";
+
+		size_t	begin = 0;
+		size_t	lineNumber = 0;
+
+		while (begin < text.size()) {
+			size_t	end = text.find('\n', begin);
+			if (end == std::string::npos)
+				end = text.size();
+
+			std::string	line = text.substr(begin, end - begin);
+			begin = end + 1;
+			lineNumber++;
+
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+
+			if (directive(line, "version")) {
+				// Only the stage file declares the version, blank lines keep the numbering of includes
+				if (root)
+					source.code += line + '\n' + defineBlock + "#line " + std::to_string(lineNumber + 1) + " 0\n";
+				else
+					source.code += '\n';
+				continue;
+			}
+
+			const char *	argument = directive(line, "include");
+			if (!argument) {
+				source.code += line + '\n';
+				continue;
+			}
+
+			const std::string	rest(argument);
+			const size_t		open = rest.find_first_of("\"<");
+			const size_t		close = (open == std::string::npos) ? open : rest.find(rest[open] == '<' ? '>' : '"', open + 1);
+
+			if (close == std::string::npos)
+				throw std::runtime_error("ShaderPreprocessor: Malformed #include in " + path + " line " + std::to_string(lineNumber));
+
+			const std::string	included = (std::filesystem::path(path).parent_path() / rest.substr(open + 1, close - open - 1)).lexically_normal().string();
+
+			// Already part of the stage
+			if (std::find(source.files.begin(), source.files.end(), included) != source.files.end()) {
+				source.code += '\n';
+				continue;
+			}
+
+			source.code += "#line 1 " + std::to_string(source.files.size()) + '\n';
+			_processFile(included, defines, source);
+			source.code += "#line " + std::to_string(lineNumber + 1) + " " + index + '\n';
+		}
+	}
+
+	# pragma endregion
+
+} // namespace GE::OpenGL
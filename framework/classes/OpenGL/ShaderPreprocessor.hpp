@@ -0,0 +1,41 @@
+#pragma once
+
+/// System includes
+# include <cstdint>
+# include <map>
+# include <string>
+# include <vector>
+
+namespace GE::OpenGL {
+
+	/// @brief A set of #define injected in a shader, name to value (an empty value defines the name only)
+	/// @note Ordered, so a set hashes the same whatever the insertion order
+	using ShaderDefines = std::map<std::string, std::string>;
+
+	uint64_t	hashDefines(const ShaderDefines &defines);
+
+	/// @brief A preprocessed shader stage
+	struct ShaderSource {
+		std::string					code;	// Ready to compile
+		std::vector<std::string>	files;	// The stage file then its includes, the index is the GLSL source string number
+	};
+
+	/**
+	 * @brief Resolves #include and injects #define in GLSL sources.
+	 *
+	 * `#include "path"` (or `<path>`) is resolved relative to the including file. A file already included by
+	 * the stage is skipped, so headers need no guard and include cycles stop.
+	 *
+	 * The defines are inserted right after `#version`, before any line of the stage. `#line` directives keep
+	 * the driver errors pointing to the right line : a message on "2(14)" is line 14 of files[2].
+	 *
+	 * @note Stateless and thread safe, the ShaderCompiler runs it on its worker threads.
+	 */
+	class ShaderPreprocessor {
+		public:
+			static ShaderSource	process(const std::string &path, const ShaderDefines &defines = {});
+
+		private:
+			static void	_processFile(const std::string &path, const ShaderDefines &defines, ShaderSource &source);
+	};
+} // namespace GE::OpenGL
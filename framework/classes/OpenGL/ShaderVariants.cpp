@@ -0,0 +1,76 @@
+#include "ShaderVariants.hpp"
+
+namespace GE::OpenGL {
+
+	# pragma region Constructors & Destructors
+
+	/// @param vertexPath The path to the vertex shader
+	/// @param fragmentPath The path to the fragment shader
+	/// @param geometryPath The path to the geometry shader, if any
+	/// @param logger The logger given to every variant, if any
+	/// @note No variant is compiled until get()
+	ShaderVariants::ShaderVariants(
+		const std::string &vertexPath,
+		const std::string &fragmentPath,
+		const std::string &geometryPath,
+		Core::Logger *logger
+	) : _vertexPath(vertexPath), _fragmentPath(fragmentPath), _geometryPath(geometryPath), _logger(logger) {}
+
+	# pragma endregion
+
+	# pragma region Public functions
+
+	/// @brief Return the variant of a define set, compiling it on first use
+	/// @param defines The define set
+	/// @return The variant, valid until clear() or the destruction of the ShaderVariants
+	/// @throw std::runtime_error if the variant fails to compile, nothing is cached then
+	Shader &	ShaderVariants::get(const ShaderDefines &defines) {
+		const uint64_t	key = hashDefines(defines);
+		auto			variant = _variants.find(key);
+
+		if (variant != _variants.end())
+			return *variant->second;
+
+		auto	shader = std::make_unique<Shader>(_vertexPath, _fragmentPath, _geometryPath, _logger, defines);
+
+		return *_variants.emplace(key, std::move(shader)).first->second;
+	}
+
+	/// @brief Recompile the variants whose files changed since they were compiled
+	/// @return The number of variants recompiled
+	/// @note A variant failing to compile is logged and keeps no program, as Shader::recompile()
+	size_t	ShaderVariants::recompile() {
+		size_t	count = 0;
+
+		for (auto &[key, shader] : _variants) {
+			if (!shader->isOutdated())
+				continue;
+
+			shader->recompile();
+			count++;
+		}
+		return count;
+	}
+
+	/// @brief Delete every variant
+	void	ShaderVariants::clear() {
+		_variants.clear();
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the number of compiled variants
+	size_t	ShaderVariants::getCount() const {
+		return _variants.size();
+	}
+
+	/// @brief Return whether the variant of a define set is compiled
+	bool	ShaderVariants::has(const ShaderDefines &defines) const {
+		return _variants.count(hashDefines(defines)) != 0;
+	}
+
+	# pragma endregion
+
+} // namespace GE::OpenGL
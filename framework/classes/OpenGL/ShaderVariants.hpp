@@ -0,0 +1,55 @@
+#pragma once
+
+/// Includes
+# include "Shader.hpp"
+# include "ShaderPreprocessor.hpp"
+
+/// System includes
+# include <memory>
+# include <string>
+# include <unordered_map>
+
+namespace GE::OpenGL {
+
+	/**
+	 * @brief The compiled permutations of one set of shader files, keyed by the hash of their define set.
+	 *
+	 * Each feature combination gets a program specialized at compile time, instead of one program branching on
+	 * uniforms. A variant is compiled on its first get(), then reused.
+	 *
+	 * recompile() only rebuilds the variants one of whose files, includes comprised, changed on disk.
+	 */
+	class ShaderVariants {
+		public:
+			ShaderVariants(
+				const std::string &vertexPath,
+				const std::string &fragmentPath,
+				const std::string &geometryPath = "",
+				Core::Logger *logger = nullptr
+			);
+			~ShaderVariants() = default;
+
+			ShaderVariants(const ShaderVariants &) = delete;
+			ShaderVariants &operator=(const ShaderVariants &) = delete;
+
+			/// Public functions
+
+			Shader &	get(const ShaderDefines &defines = {});
+			size_t		recompile();
+			void		clear();
+
+			/// Getters
+
+			size_t	getCount() const;
+			bool	has(const ShaderDefines &defines) const;
+
+		private:
+			std::string	_vertexPath;
+			std::string	_fragmentPath;
+			std::string	_geometryPath;
+
+			std::unordered_map<uint64_t, std::unique_ptr<Shader>>	_variants;	// Define set hash to variant
+
+			Core::Logger *	_logger;
+	};
+} // namespace GE::OpenGL
@@ -0,0 +1,269 @@
+#include "StateCacheGL.hpp"
+
+/// System includes
+# include <algorithm>
+
+namespace GE::OpenGL {
+
+	# pragma region Constructors & Destructors
+
+	StateCacheGL::StateCacheGL() {
+		invalidate();
+	}
+
+	# pragma endregion
+
+	# pragma region Public functions
+
+	/// @brief Bind a buffer to a target
+	/// @param target The buffer target (e.g. GL_ARRAY_BUFFER)
+	/// @param buffer The buffer ID, 0 to unbind
+	/// @note GL_ELEMENT_ARRAY_BUFFER is part of the vertex array state, it is forgotten when the vertex array changes
+	void	StateCacheGL::bindBuffer(GLenum target, GLuint buffer) {
+		const int	index = _bufferIndex(target);
+
+		if (index < 0 || _update(_buffers[index], buffer))
+			glBindBuffer(target, buffer);
+	}
+
+	/// @brief Bind a whole buffer to an indexed target, it also becomes the generic binding of the target
+	/// @param target The indexed target (e.g. GL_UNIFORM_BUFFER)
+	/// @param index The binding point
+	/// @param buffer The buffer ID
+	/// @note Indexed bindings are not tracked, the call is always issued
+	void	StateCacheGL::bindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+		const int	bufferIndex = _bufferIndex(target);
+
+		if (bufferIndex >= 0)
+			_buffers[bufferIndex] = buffer;
+
+		_issued++;
+		glBindBufferBase(target, index, buffer);
+	}
+
+	/// @brief Bind a range of a buffer to an indexed target, it also becomes the generic binding of the target
+	/// @param target The indexed target (e.g. GL_UNIFORM_BUFFER)
+	/// @param index The binding point
+	/// @param buffer The buffer ID
+	/// @param offset The start of the range in bytes
+	/// @param size The size of the range in bytes
+	/// @note Indexed bindings are not tracked, the call is always issued
+	void	StateCacheGL::bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+		const int	bufferIndex = _bufferIndex(target);
+
+		if (bufferIndex >= 0)
+			_buffers[bufferIndex] = buffer;
+
+		_issued++;
+		glBindBufferRange(target, index, buffer, offset, size);
+	}
+
+	/// @brief Bind a vertex array
+	/// @param VAO The vertex array ID, 0 to unbind
+	void	StateCacheGL::bindVertexArray(GLuint VAO) {
+		if (!_update(_VAO, VAO))
+			return;
+
+		_buffers[_bufferIndex(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+		glBindVertexArray(VAO);
+	}
+
+	/// @brief Set the current program
+	/// @param program The program ID, 0 for none
+	void	StateCacheGL::useProgram(GLuint program) {
+		if (_update(_program, program))
+			glUseProgram(program);
+	}
+
+	/// @brief Bind a texture to a texture unit
+	/// @param unit The texture unit, starting from 0 (GL_TEXTURE0)
+	/// @param target The texture target (e.g. GL_TEXTURE_2D)
+	/// @param texture The texture ID, 0 to unbind
+	void	StateCacheGL::bindTexture(GLuint unit, GLenum target, GLuint texture) {
+		const int	index = _textureIndex(target);
+
+		if (index >= 0 && unit < TEXTURE_UNITS && !_update(_textures[unit][index], texture))
+			return;
+
+		if (_update(_activeUnit, unit))
+			glActiveTexture(GL_TEXTURE0 + unit);
+		glBindTexture(target, texture);
+	}
+
+	/// @brief Delete buffers, forgetting their bindings
+	void	StateCacheGL::deleteBuffers(GLsizei count, const GLuint *buffers) {
+		for (GLsizei i = 0; i < count; i++)
+			_forget(_buffers, BUFFER_TARGETS, buffers[i]);
+		glDeleteBuffers(count, buffers);
+	}
+
+	/// @brief Delete vertex arrays, forgetting their binding
+	void	StateCacheGL::deleteVertexArrays(GLsizei count, const GLuint *VAOs) {
+		for (GLsizei i = 0; i < count; i++) {
+			if (VAOs[i] && VAOs[i] == _VAO) {
+				_VAO = 0;
+				_buffers[_bufferIndex(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+			}
+		}
+		glDeleteVertexArrays(count, VAOs);
+	}
+
+	/// @brief Delete a program, it stays in use until another one is set
+	void	StateCacheGL::deleteProgram(GLuint program) {
+		glDeleteProgram(program);
+	}
+
+	/// @brief Delete textures, forgetting their bindings
+	void	StateCacheGL::deleteTextures(GLsizei count, const GLuint *textures) {
+		for (GLsizei i = 0; i < count; i++)
+			_forget(&_textures[0][0], TEXTURE_UNITS * TEXTURE_TARGETS, textures[i]);
+		glDeleteTextures(count, textures);
+	}
+
+	/// @brief Forget the whole state, the next changes are all issued
+	void	StateCacheGL::invalidate() {
+		std::fill_n(_buffers, BUFFER_TARGETS, UNKNOWN);
+		std::fill_n(&_textures[0][0], TEXTURE_UNITS * TEXTURE_TARGETS, UNKNOWN);
+		std::fill_n(_capabilities, CAPABILITIES, UNKNOWN);
+		_VAO = UNKNOWN;
+		_program = UNKNOWN;
+		_activeUnit = UNKNOWN;
+		_depthFunc = UNKNOWN;
+		_depthMask = UNKNOWN;
+		_blendSource = UNKNOWN;
+		_blendDestination = UNKNOWN;
+	}
+
+	/// @brief Reset the issued and skipped counters
+	void	StateCacheGL::resetStats() {
+		_issued = 0;
+		_skipped = 0;
+	}
+
+	# pragma endregion
+
+	# pragma region Private functions
+
+	// Store value, returns false (and counts a skipped call) if it was already set
+	bool	StateCacheGL::_update(GLuint &cached, GLuint value) {
+		if (cached == value) {
+			_skipped++;
+			return false;
+		}
+
+		cached = value;
+		_issued++;
+		return true;
+	}
+
+	// Reset the bindings of a deleted object, OpenGL binds 0 in its place
+	void	StateCacheGL::_forget(GLuint *cached, size_t count, GLuint value) {
+		if (!value)
+			return;
+
+		for (size_t i = 0; i < count; i++)
+			if (cached[i] == value)
+				cached[i] = 0;
+	}
+
+	int	StateCacheGL::_bufferIndex(GLenum target) {
+		switch (target) {
+			case GL_ARRAY_BUFFER:				return 0;
+			case GL_ELEMENT_ARRAY_BUFFER:		return 1;
+			case GL_COPY_READ_BUFFER:			return 2;
+			case GL_COPY_WRITE_BUFFER:			return 3;
+			case GL_DRAW_INDIRECT_BUFFER:		return 4;
+			case GL_DISPATCH_INDIRECT_BUFFER:	return 5;
+			case GL_UNIFORM_BUFFER:				return 6;
+			case GL_SHADER_STORAGE_BUFFER:		return 7;
+			case GL_ATOMIC_COUNTER_BUFFER:		return 8;
+			case GL_PIXEL_PACK_BUFFER:			return 9;
+			case GL_PIXEL_UNPACK_BUFFER:		return 10;
+			case GL_TEXTURE_BUFFER:				return 11;
+			case GL_TRANSFORM_FEEDBACK_BUFFER:	return 12;
+			case GL_QUERY_BUFFER:				return 13;
+			default:							return -1;
+		}
+	}
+
+	int	StateCacheGL::_textureIndex(GLenum target) {
+		switch (target) {
+			case GL_TEXTURE_2D:			return 0;
+			case GL_TEXTURE_CUBE_MAP:	return 1;
+			case GL_TEXTURE_3D:			return 2;
+			case GL_TEXTURE_2D_ARRAY:	return 3;
+			case GL_TEXTURE_BUFFER:		return 4;
+			default:					return -1;
+		}
+	}
+
+	int	StateCacheGL::_capabilityIndex(GLenum capability) {
+		switch (capability) {
+			case GL_DEPTH_TEST:					return 0;
+			case GL_BLEND:						return 1;
+			case GL_CULL_FACE:					return 2;
+			case GL_SCISSOR_TEST:				return 3;
+			case GL_STENCIL_TEST:				return 4;
+			case GL_PROGRAM_POINT_SIZE:			return 5;
+			case GL_TEXTURE_CUBE_MAP_SEAMLESS:	return 6;
+			case GL_POLYGON_OFFSET_FILL:		return 7;
+			default:							return -1;
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the issued and skipped counters
+	StateCacheStats	StateCacheGL::getStats() const {
+		return {_issued, _skipped};
+	}
+
+	# pragma endregion
+
+	# pragma region Setters
+
+	/// @brief Enable or disable a capability (glEnable / glDisable)
+	/// @param capability The capability (e.g. GL_DEPTH_TEST)
+	/// @param enabled Whether the capability is enabled
+	void	StateCacheGL::setCapability(GLenum capability, bool enabled) {
+		const int	index = _capabilityIndex(capability);
+
+		if (index >= 0 && !_update(_capabilities[index], enabled))
+			return;
+
+		if (enabled)
+			glEnable(capability);
+		else
+			glDisable(capability);
+	}
+
+	/// @brief Set the depth comparison function
+	void	StateCacheGL::setDepthFunc(GLenum func) {
+		if (_update(_depthFunc, func))
+			glDepthFunc(func);
+	}
+
+	/// @brief Enable or disable depth writes
+	void	StateCacheGL::setDepthMask(bool enabled) {
+		if (_update(_depthMask, enabled))
+			glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+	}
+
+	/// @brief Set the blend factors
+	void	StateCacheGL::setBlendFunc(GLenum source, GLenum destination) {
+		if (_blendSource == source && _blendDestination == destination) {
+			_skipped++;
+			return;
+		}
+
+		_blendSource = source;
+		_blendDestination = destination;
+		_issued++;
+		glBlendFunc(source, destination);
+	}
+
+	# pragma endregion
+
+} // namespace GE::OpenGL
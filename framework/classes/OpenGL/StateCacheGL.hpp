@@ -0,0 +1,98 @@
+#pragma once
+
+/// Includes
+# include "core/Singleton.hpp"
+
+/// System includes
+# include <cstddef>
+# include <cstdint>
+
+/// Dependencies
+# include <glad/glad.h>
+
+namespace GE::OpenGL {
+
+	/// @brief Counters of the StateCacheGL, since the last resetStats()
+	struct StateCacheStats {
+		size_t	issued;		// State changes forwarded to OpenGL
+		size_t	skipped;	// Redundant state changes dropped
+	};
+
+	/// @brief A shadow of the OpenGL state, so that binds and state changes already in effect are not issued again.
+	///
+	/// Every framework class binds buffers, vertex arrays, programs and textures, and sets depth and blend state,
+	/// through this cache instead of calling OpenGL directly. Draws set the state they need rather than restoring
+	/// defaults afterwards, the cache drops the calls that would not change anything.
+	///
+	/// Objects must also be deleted through the cache, as OpenGL unbinds them on deletion.
+	///
+	/// @note Tracks the state of the single context the framework renders with, call it from the thread owning it.
+	/// Window invalidates it when its context is created and destroyed, a new context starts with nothing cached.
+	/// @note Call invalidate() after OpenGL calls made outside of the cache, the next changes are then all issued.
+	/// @note As this class may be frequently used, it is designed to be as lightweight as possible and have no logging integrated.
+	class StateCacheGL : public Core::Singleton<StateCacheGL> {
+		friend class Core::Singleton<StateCacheGL>;
+
+		public:
+			/// Public functions
+
+			void	bindBuffer(GLenum target, GLuint buffer);
+			void	bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+			void	bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+			void	bindVertexArray(GLuint VAO);
+			void	useProgram(GLuint program);
+			void	bindTexture(GLuint unit, GLenum target, GLuint texture);
+
+			void	deleteBuffers(GLsizei count, const GLuint *buffers);
+			void	deleteVertexArrays(GLsizei count, const GLuint *VAOs);
+			void	deleteProgram(GLuint program);
+			void	deleteTextures(GLsizei count, const GLuint *textures);
+
+			void	invalidate();
+			void	resetStats();
+
+			/// Getters
+
+			StateCacheStats	getStats() const;
+
+			/// Setters
+
+			void	setCapability(GLenum capability, bool enabled);
+			void	setDepthFunc(GLenum func);
+			void	setDepthMask(bool enabled);
+			void	setBlendFunc(GLenum source, GLenum destination);
+
+		private:
+			static constexpr GLuint	UNKNOWN = UINT32_MAX;	// Value never set through the cache
+			static constexpr int	BUFFER_TARGETS = 14;
+			static constexpr int	TEXTURE_UNITS = 32;
+			static constexpr int	TEXTURE_TARGETS = 5;
+			static constexpr int	CAPABILITIES = 8;
+
+			GLuint	_buffers[BUFFER_TARGETS];
+			GLuint	_VAO;
+			GLuint	_program;
+			GLuint	_activeUnit;
+			GLuint	_textures[TEXTURE_UNITS][TEXTURE_TARGETS];
+			GLuint	_capabilities[CAPABILITIES];
+			GLuint	_depthFunc;
+			GLuint	_depthMask;
+			GLuint	_blendSource;
+			GLuint	_blendDestination;
+
+			size_t	_issued = 0;
+			size_t	_skipped = 0;
+
+			StateCacheGL();
+			~StateCacheGL() = default;
+
+			/// Private functions
+
+			bool	_update(GLuint &cached, GLuint value);
+			void	_forget(GLuint *cached, size_t count, GLuint value);
+
+			static int	_bufferIndex(GLenum target);
+			static int	_textureIndex(GLenum target);
+			static int	_capabilityIndex(GLenum capability);
+	};
+} // namespace GE::OpenGL
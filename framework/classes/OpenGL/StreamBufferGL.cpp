@@ -0,0 +1,186 @@
+#include "StreamBufferGL.hpp"
+
+/// System includes
+# include <algorithm>
+# include <chrono>
+# include <stdexcept>
+# include <string>
+
+namespace GE::OpenGL {
+
+	static size_t	ringCapacity(size_t frameSize, size_t frameCount) {
+		if (!frameSize || !frameCount)
+			throw std::invalid_argument("StreamBufferGL: Frame size and frame count must not be 0");
+
+		return frameSize * frameCount;
+	}
+
+	# pragma region Constructors & Destructors
+
+	StreamBufferGL::StreamBufferGL(GLenum type, size_t frameSize, size_t frameCount)
+		: _buffer(type, ringCapacity(frameSize, frameCount), PERSISTENT_BUFFER_USAGE), _alignment(16) {
+		GLint	alignment = 0;
+
+		// Offsets bound with glBindBufferRange must follow the implementation alignment
+		if (type == GL_UNIFORM_BUFFER)
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		else if (type == GL_SHADER_STORAGE_BUFFER)
+			glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+
+		_alignment = std::max<size_t>(_alignment, alignment);
+	}
+
+	StreamBufferGL::~StreamBufferGL() {
+		for (const FrameFence &frame : _fences)
+			glDeleteSync(frame.fence);
+	}
+
+	# pragma endregion
+
+	# pragma region Public functions
+
+	/// @brief Hand out a range of the ring for the current frame
+	/// @param size The number of bytes
+	/// @param alignment The alignment of the offset, 0 for the default (see getAlignment())
+	/// @return The range, writable until the draws reading it are submitted and endFrame() is called
+	/// @throw std::out_of_range if size is larger than the buffer
+	/// @throw std::runtime_error if the current frame alone fills the buffer, or waiting on a fence fails
+	/// @note Blocks only if the GPU is still reading the range from frameCount frames ago
+	StreamRange	StreamBufferGL::allocate(size_t size, size_t alignment) {
+		const size_t	capacity = _buffer.getCapacity();
+
+		if (!alignment)
+			alignment = _alignment;
+		if (size > capacity)
+			throw std::out_of_range("StreamBufferGL: Allocation overflow - Size: " + std::to_string(size) +
+									", Capacity: " + std::to_string(capacity));
+
+		for (;;) {
+			// Nothing in use, on entry or once the GPU released everything : restart at the beginning
+			if (!_used)
+				_head = 0;
+
+			size_t	offset = (_head + alignment - 1) / alignment * alignment;
+			size_t	consumed = offset - _head + size;
+
+			// Not enough room before the end, the rest of the ring is skipped
+			if (offset + size > capacity) {
+				offset = 0;
+				consumed = capacity - _head + size;
+			}
+
+			if (_used + consumed <= capacity) {
+				_head = offset + size;
+				_used += consumed;
+				_frameBytes += consumed;
+				_allocations++;
+				_allocatedBytes += consumed;
+
+				return {static_cast<uint8_t *>(_buffer.getData()) + offset, offset, size};
+			}
+
+			if (_fences.empty())
+				throw std::runtime_error("StreamBufferGL: Frame overflow - " + std::to_string(_frameBytes) +
+										 " bytes allocated this frame, Capacity: " + std::to_string(capacity));
+
+			_retire(true);
+		}
+	}
+
+	/// @brief Fence the ranges allocated since the last call
+	/// @note Call it once per frame, after the draws reading the ranges are submitted
+	void	StreamBufferGL::endFrame() {
+		if (_frameBytes) {
+			_fences.push_back({glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), _frameBytes});
+			_frameBytes = 0;
+		}
+		_frames++;
+
+		// Release what the GPU already finished, without waiting
+		while (!_fences.empty() && _retire(false));
+	}
+
+	/// @brief Bind the whole buffer
+	void	StreamBufferGL::bind() {
+		_buffer.bind();
+	}
+
+	/// @brief Bind a range to an indexed target (uniform or shader storage binding)
+	/// @param index The binding point
+	/// @param range A range returned by allocate()
+	void	StreamBufferGL::bindRange(GLuint index, const StreamRange &range) {
+		StateCacheGL::getInstance().bindBufferRange(_buffer.getType(), index, _buffer.getID(), range.offset, range.size);
+	}
+
+	# pragma endregion
+
+	# pragma region Private functions
+
+	// Release the oldest fenced frame, returns false if it is still in use and wait is false
+	bool	StreamBufferGL::_retire(bool wait) {
+		const FrameFence &	frame = _fences.front();
+		GLenum				status = glClientWaitSync(frame.fence, 0, 0);
+
+		if (status == GL_TIMEOUT_EXPIRED) {
+			if (!wait)
+				return false;
+
+			const auto	start = std::chrono::steady_clock::now();
+
+			do {
+				status = glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+			} while (status == GL_TIMEOUT_EXPIRED);
+
+			_waitTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			_waits++;
+		}
+
+		if (status == GL_WAIT_FAILED)
+			throw std::runtime_error("StreamBufferGL: Failed to wait for a frame fence");
+
+		glDeleteSync(frame.fence);
+		_used -= frame.bytes;
+		_fences.pop_front();
+		return true;
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the underlying persistent buffer
+	PMapBufferGL &	StreamBufferGL::getBuffer() {
+		return _buffer;
+	}
+
+	/// @brief Return the buffer ID
+	const GLuint &	StreamBufferGL::getID() const {
+		return _buffer.getID();
+	}
+
+	/// @brief Return the size of the ring in bytes
+	size_t	StreamBufferGL::getCapacity() const {
+		return _buffer.getCapacity();
+	}
+
+	/// @brief Return the default alignment of allocate()
+	/// @return 16, or the offset alignment of the implementation for uniform and shader storage buffers if larger
+	size_t	StreamBufferGL::getAlignment() const {
+		return _alignment;
+	}
+
+	/// @brief Return the allocation and wait counters
+	StreamBufferStats	StreamBufferGL::getStats() const {
+		return {
+			_frames,
+			_allocations,
+			_allocatedBytes,
+			_waits,
+			(double)_waitTime / 1e6,
+			_fences.size()
+		};
+	}
+
+	# pragma endregion
+
+} // namespace GE::OpenGL
@@ -0,0 +1,91 @@
+#pragma once
+
+/// Includes
+# include "PMapBufferGL.hpp"
+
+/// System includes
+# include <cstdint>
+# include <deque>
+
+/// Dependencies
+# include <glad/glad.h>
+
+namespace GE::OpenGL {
+
+	/// @brief A sub-range of a StreamBufferGL, writable until the end of the frame
+	struct StreamRange {
+		void *	data;		// Mapped pointer to write to
+		size_t	offset;		// Offset in the buffer, for glBindBufferRange or vertex attributes
+		size_t	size;
+	};
+
+	/// @brief Counters of a StreamBufferGL, since its creation
+	struct StreamBufferStats {
+		size_t	frames;
+		size_t	allocations;
+		size_t	allocatedBytes;		// Alignment and wrap padding included
+		size_t	waits;				// Allocations that blocked on a fence the GPU had not reached yet
+		double	waitTime;			// Milliseconds spent blocked
+		size_t	framesInFlight;		// Frames fenced but not known to be finished by the GPU
+	};
+
+	/// @brief A ring buffer streaming per-frame data through a persistently mapped buffer.
+	///
+	/// Each frame, allocate() hands out aligned sub-ranges written directly into the mapping, and endFrame()
+	/// fences them. A range is only handed out again once the GPU passed the fence of the frame that used it,
+	/// so writes never race the draws reading the previous frames, without glFinish().
+	///
+	/// Sized for frameCount frames of frameSize bytes, it behaves as a triple buffer by default, the CPU
+	/// only waits when it gets frameCount frames ahead of the GPU.
+	///
+	/// @note The mapping is coherent, writes need no flush.
+	/// @note As this class may be frequently used, it is designed to be as lightweight as possible and have no logging integrated.
+	class StreamBufferGL {
+		public:
+			StreamBufferGL(GLenum type, size_t frameSize, size_t frameCount = 3);
+			~StreamBufferGL();
+
+			StreamBufferGL(const StreamBufferGL &) = delete;
+			StreamBufferGL &operator=(const StreamBufferGL &) = delete;
+
+			/// Public functions
+
+			StreamRange	allocate(size_t size, size_t alignment = 0);
+			void		endFrame();
+			void		bind();
+			void		bindRange(GLuint index, const StreamRange &range);
+
+			/// Getters
+
+			PMapBufferGL &		getBuffer();
+			const GLuint &		getID() const;
+			size_t				getCapacity() const;
+			size_t				getAlignment() const;
+			StreamBufferStats	getStats() const;
+
+		private:
+			// A finished frame, its bytes are reusable once the fence is signaled
+			struct	FrameFence {
+				GLsync	fence;
+				size_t	bytes;
+			};
+
+			PMapBufferGL			_buffer;
+			size_t					_alignment;		// Default alignment of allocate()
+
+			size_t					_head = 0;		// Next free offset
+			size_t					_used = 0;		// Bytes between the oldest fenced frame and _head
+			size_t					_frameBytes = 0;	// Bytes allocated by the current frame
+			std::deque<FrameFence>	_fences;		// Oldest first
+
+			size_t					_frames = 0;
+			size_t					_allocations = 0;
+			size_t					_allocatedBytes = 0;
+			size_t					_waits = 0;
+			uint64_t				_waitTime = 0;	// Nanoseconds
+
+			/// Private functions
+
+			bool	_retire(bool wait);
+	};
+} // namespace GE::OpenGL
@@ -0,0 +1,153 @@
+#include "TimerQueryGL.hpp"
+
+/// System includes
+# include <stdexcept>
+
+namespace GE::OpenGL {
+
+	# pragma region Constructors & Destructors
+
+	TimerQueryGL::TimerQueryGL() : _frames(LATENCY + 1) {}
+
+	# pragma endregion
+
+	# pragma region Public functions
+
+	/// @brief Start timing a region, nested in the regions already begun
+	/// @param name The region name, a string literal or __func__
+	void	TimerQueryGL::begin(const char *name) {
+		Frame &	frame = _frames[_current];
+
+		if (!_open.empty())
+			glEndQuery(GL_TIME_ELAPSED);
+
+		const int32_t	parent = _open.empty() ? -1 : (int32_t)_open.back();
+
+		frame.regions.push_back({name, Core::Profiler::now(), parent, (uint32_t)_open.size()});
+		_open.push_back(frame.regions.size() - 1);
+		_beginSegment(_open.back());
+	}
+
+	/// @brief Stop timing the innermost region, the enclosing one resumes
+	/// @throw std::logic_error if no region was begun
+	void	TimerQueryGL::end() {
+		if (_open.empty())
+			throw std::logic_error("TimerQueryGL: end() without begin()");
+
+		glEndQuery(GL_TIME_ELAPSED);
+		_open.pop_back();
+
+		if (!_open.empty())
+			_beginSegment(_open.back());
+	}
+
+	/// @brief Close the frame, and read the results of the frame issued LATENCY frames earlier if the GPU finished it
+	/// @throw std::logic_error if a region is still open
+	/// @note Call it once per frame, outside of any region. The Window loops do it with GE_ENABLE_PROFILING.
+	void	TimerQueryGL::endFrame() {
+		if (!_open.empty())
+			throw std::logic_error("TimerQueryGL: endFrame() inside a region");
+
+		_current = (_current + 1) % _frames.size();
+		_read(_frames[_current]);
+	}
+
+	/// @brief Delete the queries, while the context still exists. The next regions create them again.
+	void	TimerQueryGL::release() {
+		for (Frame &frame : _frames) {
+			if (!frame.queries.empty())
+				glDeleteQueries(frame.queries.size(), frame.queries.data());
+			frame = Frame();
+		}
+		_open.clear();
+		_timings.clear();
+	}
+
+	# pragma endregion
+
+	# pragma region Private functions
+
+	// Start a query timing a region, until the next begin() or end()
+	void	TimerQueryGL::_beginSegment(uint32_t region) {
+		Frame &	frame = _frames[_current];
+
+		if (frame.segments.size() == frame.queries.size()) {
+			GLuint	query;
+			glGenQueries(1, &query);
+			frame.queries.push_back(query);
+		}
+
+		glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.segments.size()]);
+		frame.segments.push_back(region);
+	}
+
+	// Read the queries of a finished frame into the timings, and reset it for reuse
+	void	TimerQueryGL::_read(Frame &frame) {
+		// No timings for a frame without regions or skipped, rather than those of an older frame
+		_timings.clear();
+		if (frame.segments.empty())
+			return;
+
+		// Queries finish in order, the last one being available means all of them are
+		GLuint	available = GL_FALSE;
+		glGetQueryObjectuiv(frame.queries[frame.segments.size() - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+		if (available) {
+			std::vector<GLuint64>	elapsed(frame.regions.size(), 0);
+
+			for (size_t i = 0; i < frame.segments.size(); i++) {
+				GLuint64	nanoseconds = 0;
+				glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &nanoseconds);
+				elapsed[frame.segments[i]] += nanoseconds;
+			}
+
+			// Nested regions come after their parent, add them up innermost first
+			for (size_t i = frame.regions.size(); i-- > 0;)
+				if (frame.regions[i].parent >= 0)
+					elapsed[frame.regions[i].parent] += elapsed[i];
+
+			for (size_t i = 0; i < frame.regions.size(); i++) {
+				const Region &	region = frame.regions[i];
+
+				_timings.push_back({region.name, elapsed[i] / 1e6, region.depth});
+				#ifdef GE_ENABLE_PROFILING
+					Core::Profiler::getInstance().recordGPU("OpenGL", region.name, region.issued, elapsed[i] / 1e6, region.depth);
+				#endif
+			}
+		}
+		else
+			_skipped++;
+
+		frame.segments.clear();
+		frame.regions.clear();
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the timings of the last frame read, see endFrame()
+	/// @note Empty if the results of that frame were skipped, see getSkippedCount()
+	const std::vector<GPUTiming> &	TimerQueryGL::getTimings() const {
+		return _timings;
+	}
+
+	/// @brief Return the GPU time in milliseconds of the top-level regions of the last frame read, 0 if it was skipped
+	double	TimerQueryGL::getTotal() const {
+		double	total = 0;
+
+		for (const GPUTiming &timing : _timings)
+			if (!timing.depth)
+				total += timing.time;
+		return total;
+	}
+
+	/// @brief Return the number of frames whose results were not available in time, and were skipped
+	/// @note Frequent skips mean the GPU runs more than LATENCY frames behind
+	size_t	TimerQueryGL::getSkippedCount() const {
+		return _skipped;
+	}
+
+	# pragma endregion
+
+} // namespace GE::OpenGL
@@ -0,0 +1,107 @@
+#pragma once
+
+/// Includes
+# include "core/Singleton.hpp"
+# include "core/Profiler.hpp"
+
+/// System includes
+# include <cstddef>
+# include <cstdint>
+# include <vector>
+
+/// Dependencies
+# include <glad/glad.h>
+
+// GPU profiling macros, expanding to nothing unless GE_ENABLE_PROFILING is defined, see core/Profiler.hpp
+# ifdef GE_ENABLE_PROFILING
+#  define GE_PROFILE_GPU(name)		::GE::OpenGL::TimerQueryScope GE_PROFILE_CONCAT(geProfileGPU, __LINE__)(name)
+#  define GE_PROFILE_GPU_FRAME()	::GE::OpenGL::TimerQueryGL::getInstance().endFrame()
+# else
+#  define GE_PROFILE_GPU(name)		((void)0)
+#  define GE_PROFILE_GPU_FRAME()	((void)0)
+# endif
+
+namespace GE::OpenGL {
+
+	/// @brief The GPU time of a region, in the order the regions began
+	struct GPUTiming {
+		const char *	name;
+		double			time;	// Milliseconds, nested regions comprised
+		uint32_t		depth;
+	};
+
+	/// @brief Times regions of OpenGL commands on the GPU with GL_TIME_ELAPSED queries, without ever waiting for them.
+	///
+	/// Each frame gets its own set of queries in a ring of LATENCY + 1 frames : endFrame() reads the frame issued
+	/// LATENCY frames earlier, which the GPU has finished in any steady state. If it has not, its results are
+	/// skipped rather than waited for.
+	///
+	/// GL_TIME_ELAPSED queries cannot nest : a region beginning inside another one ends the query of the outer region,
+	/// and starts a new one for it when it ends. The outer region is then the sum of its queries and of the nested regions.
+	///
+	/// With GE_ENABLE_PROFILING, the results are also sent to the Core::Profiler, in the "OpenGL" track of the frame breakdown.
+	///
+	/// @note Times the single context the framework renders with, call it from the thread owning it.
+	/// @note Call release() before the context is destroyed.
+	/// @note As this class may be frequently used, it is designed to be as lightweight as possible and have no logging integrated.
+	class TimerQueryGL : public Core::Singleton<TimerQueryGL> {
+		friend class Core::Singleton<TimerQueryGL>;
+
+		public:
+			static constexpr size_t	LATENCY = 3;	// Frames between a region and its read back
+
+			/// Public functions
+
+			void	begin(const char *name);
+			void	end();
+			void	endFrame();
+			void	release();
+
+			/// Getters
+
+			const std::vector<GPUTiming> &	getTimings() const;
+			double							getTotal() const;
+			size_t							getSkippedCount() const;
+
+		private:
+			// A region between begin() and end()
+			struct Region {
+				const char *	name;
+				uint64_t		issued;		// Core::Profiler::now() at begin()
+				int32_t			parent;		// Index of the enclosing region, -1 for none
+				uint32_t		depth;
+			};
+
+			// The queries of a frame, each one times a segment of a region
+			struct Frame {
+				std::vector<GLuint>		queries;	// Kept from frame to frame, only grows
+				std::vector<uint32_t>	segments;	// Region timed by each query used
+				std::vector<Region>		regions;
+			};
+
+			std::vector<Frame>		_frames;
+			size_t					_current = 0;
+			std::vector<uint32_t>	_open;		// Regions begun and not ended yet, innermost last
+
+			std::vector<GPUTiming>	_timings;
+			size_t					_skipped = 0;
+
+			TimerQueryGL();
+			~TimerQueryGL() = default;
+
+			/// Private functions
+
+			void	_beginSegment(uint32_t region);
+			void	_read(Frame &frame);
+	};
+
+	/// @brief A region timed until the end of the scope, see GE_PROFILE_GPU().
+	class TimerQueryScope {
+		public:
+			explicit TimerQueryScope(const char *name) { TimerQueryGL::getInstance().begin(name); }
+			~TimerQueryScope() { TimerQueryGL::getInstance().end(); }
+
+			TimerQueryScope(const TimerQueryScope &) = delete;
+			TimerQueryScope &operator=(const TimerQueryScope &) = delete;
+	};
+} // namespace GE::OpenGL
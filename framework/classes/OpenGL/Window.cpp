@@ -1,5 +1,8 @@
 #include "Window.hpp"
 
+/// System includes
+# include <thread>
+
 namespace GE::OpenGL {
 
 	# pragma region Constructors & Destructors
@@ -30,12 +33,17 @@ namespace GE::OpenGL {
 		}
 		if (logger) logger->trace("GLAD initialized");
 
+		// The state cache may still shadow the context of a previous window
+		StateCacheGL::getInstance().invalidate();
+
 		glfwSetWindowPos(window, posX, posY);
 
 		if (logger) logger->info("Window created");
 	}
 
 	Window::~Window() {
+		TimerQueryGL::getInstance().release();
+		StateCacheGL::getInstance().invalidate();
 		glfwDestroyWindow(window);
 		glfwTerminate();
 
@@ -46,25 +54,61 @@ namespace GE::OpenGL {
 
 	# pragma region Private functions
 
-	// Update the frame rate and the fps counters
+	// Update the frame rate, the fps counters and the frame statistics, and close the profiler frame
+	// Called outside of the profiled regions, the GPU timings read back are part of the frame closed here
 	void	Window::updateFrameRate() {
-		static double	lastTime = glfwGetTime();
-		static double	lastFrame = glfwGetTime();
-		static size_t	frames = 0;
+		double currentTime = glfwGetTime();
+
+		GE_PROFILE_GPU_FRAME();
+		GE_PROFILE_FRAME();
+
+		// The first frame has no previous one to be timed from
+		if (lastFrame < 0) {
+			lastFrame = currentTime;
+			lastFPSUpdate = currentTime;
+			return;
+		}
 
-		frames++;
+		framesSinceFPSUpdate++;
 
 		// Update the frame time
-		double currentTime = glfwGetTime();
 		this->frameTime = (currentTime - lastFrame) * 1000.0;
 		lastFrame = currentTime;
+		frameStats.push(frameTime);
 
 		// Update the fps counter every second
-		if (currentTime - lastTime >= 1.0) {
-			this->fps = frames;
-			frames = 0;
-			lastTime = currentTime;
+		if (currentTime - lastFPSUpdate >= 1.0) {
+			this->fps = framesSinceFPSUpdate;
+			framesSinceFPSUpdate = 0;
+			lastFPSUpdate = currentTime;
+		}
+	}
+
+	// Wait until the next frame deadline : sleep, then spin the last LIMITER_SPIN milliseconds
+	void	Window::limitFrame() {
+		using Clock = std::chrono::steady_clock;
+
+		if (targetFrameTime <= 0)
+			return;
+
+		const Clock::duration	target = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(targetFrameTime));
+		const Clock::duration	spin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(LIMITER_SPIN));
+		const Clock::time_point	now = Clock::now();
+
+		// Deadlines follow each other, so the frame time averages the target even with uneven frames
+		frameDeadline += target;
+
+		// Late by more than a frame (hitch, breakpoint...) : start again from now instead of rushing frames
+		if (frameDeadline + target < now) {
+			frameDeadline = now;
+			return;
 		}
+
+		if (frameDeadline - now > spin)
+			std::this_thread::sleep_for(frameDeadline - now - spin);
+
+		while (Clock::now() < frameDeadline)
+			std::this_thread::yield();
 	}
 
 	# pragma endregion
@@ -91,6 +135,16 @@ namespace GE::OpenGL {
 		return frameTime;
 	}
 
+	// Return the rolling frame time statistics of the window (percentiles, 1% lows, hitches)
+	const Utils::FrameStats	&Window::getFrameStats() const {
+		return frameStats;
+	}
+
+	// Return the rolling frame time statistics of the window, e.g. to set the hitch threshold or export them
+	Utils::FrameStats	&Window::getFrameStats() {
+		return frameStats;
+	}
+
 	// Return true if the window is focused
 	bool	Window::isFocused() const {
 		return glfwGetWindowAttrib(window, GLFW_FOCUSED);
@@ -110,6 +164,18 @@ namespace GE::OpenGL {
 		glfwSetWindowShouldClose(window, value);
 	}
 
+	// Synchronize the buffer swaps with the screen refresh
+	void	Window::setVSync(bool value) {
+		glfwSwapInterval(value ? 1 : 0);
+	}
+
+	// Pace the loops to a frame time in milliseconds (e.g. 1000.0 / 144), 0 disables the limiter
+	// Without vsync the loops would otherwise render as fast as possible
+	void	Window::setTargetFrameTime(double milliseconds) {
+		targetFrameTime = milliseconds > 0 ? milliseconds : 0;
+		frameDeadline = std::chrono::steady_clock::now();
+	}
+
 	# pragma endregion
 
 } // namespace GE::OpenGL
\ No newline at end of file
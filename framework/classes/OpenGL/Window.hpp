@@ -5,8 +5,14 @@
 
 /// Includes
 # include "Logger.hpp"
+# include "Profiler.hpp"
+# include "StateCacheGL.hpp"
+# include "TimerQueryGL.hpp"
+# include "Utils/FrameStats.hpp"
 
 /// System includes
+# include <chrono>
+# include <cmath>
 # include <string>
 # include <vector>
 
@@ -15,11 +21,21 @@
 # include <glfw/glfw3.h>
 
 namespace GE::OpenGL {
+	/// @brief Settings of Window::fixedLoop()
+	struct FixedLoopInfo {
+		double	updateRate = 60.0;	// Simulation steps per second
+		size_t	maxUpdates = 5;		// Steps per frame at most, after a hitch the simulation slows down rather than spiraling
+		bool	lowLatency = false;	// Wait, poll the input, update and draw, then glFinish() : no frame is queued behind the input
+	};
+
 	/// @brief The Window class is a wrapper around a GLFW window.
 	///
 	/// It handles the creation, destruction and main loop of the window.
 	///
 	/// It also provides some useful getters and setters.
+	///
+	/// Both loops pace the frames to setTargetFrameTime() when set, sleeping most of the wait then spinning the last
+	/// LIMITER_SPIN milliseconds, as sleeps overshoot by up to a scheduler tick. Otherwise vsync paces them.
 	class Window {
 		public:
 			Window(
@@ -36,22 +52,91 @@ namespace GE::OpenGL {
 			/// Public functions
 
 			/// @brief Main loop of the window, calls the given function each frame with the given arguments.
+			/// @tparam F Any callable : function, lambda, functor...
 			/// @tparam ...T Types of the arguments to pass to the function.
-			/// @param func Pointer to the function to call each frame.
+			/// @param func The callable to call each frame.
 			/// @param ...args Arguments to pass to the function.
 			/// @note The function polls events, updates frame time, clear and swaps buffers automatically.
-			template <typename ...T>
-			void	mainLoop(void (*func)(T&...), T&... args) {
+			template <typename F, typename ...T>
+			void	mainLoop(F &&func, T&... args) {
 				if (logger) logger->info("Window : Entering loop");
 
+				this->frameDeadline = std::chrono::steady_clock::now();
 				while (!glfwWindowShouldClose(window)) {
-					glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 					this->updateFrameRate();
+					{
+						GE_PROFILE_SCOPE("Window::frame");
+						GE_PROFILE_GPU("Window::frame");
 
-					func(args...);
+						glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+						func(args...);
+					}
 
 					glfwPollEvents();
 					glfwSwapBuffers(window);
+					this->limitFrame();
+				}
+
+				if (logger) logger->info("Window : Exiting loop");
+			}
+
+			/// @brief Main loop running the simulation at a fixed rate, and rendering as often as the pacing allows.
+			/// @param info The simulation rate and the loop mode.
+			/// @param update Callable taking the step duration in seconds (double), called 0 to maxUpdates times a frame.
+			/// @param render Callable taking the interpolation alpha (double, [0, 1)) between the last two steps.
+			/// @note Render the state interpolated between the previous and the current step by alpha, the motion
+			/// stays smooth whatever the frame rate. The loop clears, polls events and swaps buffers automatically.
+			template <typename Update, typename Render>
+			void	fixedLoop(const FixedLoopInfo &info, Update &&update, Render &&render) {
+				using Clock = std::chrono::steady_clock;
+
+				const double	step = 1.0 / info.updateRate;
+				double			accumulator = 0;
+				Clock::time_point	previous = Clock::now();
+
+				if (logger) logger->info("Window : Entering fixed loop at " + std::to_string(info.updateRate) + " updates per second");
+
+				this->frameDeadline = previous;
+				while (!glfwWindowShouldClose(window)) {
+					// Input sampled after the wait, right before it is used
+					if (info.lowLatency) {
+						this->limitFrame();
+						glfwPollEvents();
+					}
+
+					const Clock::time_point	now = Clock::now();
+					accumulator += std::chrono::duration<double>(now - previous).count();
+					previous = now;
+
+					size_t	steps = 0;
+					for (; accumulator >= step && steps < info.maxUpdates; steps++) {
+						GE_PROFILE_SCOPE("Window::update");
+
+						update(step);
+						accumulator -= step;
+					}
+					// Time the simulation could not catch up with is dropped
+					if (accumulator >= step)
+						accumulator = std::fmod(accumulator, step);
+
+					this->updateFrameRate();
+					{
+						GE_PROFILE_SCOPE("Window::render");
+						GE_PROFILE_GPU("Window::render");
+
+						glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+						render(accumulator / step);
+					}
+
+					if (info.lowLatency) {
+						glfwSwapBuffers(window);
+						glFinish();
+					}
+					else {
+						glfwPollEvents();
+						glfwSwapBuffers(window);
+						this->limitFrame();
+					}
 				}
 
 				if (logger) logger->info("Window : Exiting loop");
@@ -64,23 +149,36 @@ namespace GE::OpenGL {
 
 			size_t	getFPS();
 			double	getFrameTime() const;
+			const Utils::FrameStats &getFrameStats() const;
+			Utils::FrameStats &getFrameStats();
 			bool	isFocused() const;
 
 			/// Setters
 
 			void	setTitle(const std::string &title);
 			void	setShouldClose(bool value);
+			void	setVSync(bool value);
+			void	setTargetFrameTime(double milliseconds);
 
 		private:
+			static constexpr double	LIMITER_SPIN = 2.0;	// Milliseconds
+
 			Core::Logger	*logger = nullptr;
 			GLFWwindow *window;
 
 			// Only used for the main loop
 			size_t		fps = 0;
 			double		frameTime = 0;
+			double		lastFrame = -1;		// Seconds, -1 before the first frame
+			double		lastFPSUpdate = 0;	// Seconds
+			size_t		framesSinceFPSUpdate = 0;
+			Utils::FrameStats	frameStats;
+			double		targetFrameTime = 0;	// Milliseconds, 0 disables the limiter
+			std::chrono::steady_clock::time_point	frameDeadline;
 
 			/// Private functions
 
 			void	updateFrameRate();
+			void	limitFrame();
 	};
 } // namespace GE::OpenGL
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "FileWatcher.hpp"
+
+/// System includes
+# include <vector>
+
+# if defined(__linux__)
+#  include <poll.h>
+#  include <sys/eventfd.h>
+#  include <sys/inotify.h>
+#  include <unistd.h>
+# endif
+
+namespace GE::Utils {
+
+	static std::string	normalize(const std::string &path) {
+		return std::filesystem::path(path).lexically_normal().string();
+	}
+
+	static std::filesystem::file_time_type	modificationTime(const std::string &path) {
+		std::error_code	error;
+
+		return std::filesystem::last_write_time(path, error);
+	}
+
+	# pragma region Constructors & Destructors
+
+	FileWatcher::FileWatcher() {
+		#if defined(__linux__)
+			_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+			_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+			if (_inotify >= 0 && _wake >= 0)
+				_thread = std::thread(&FileWatcher::_run, this);
+			else {
+				if (_inotify >= 0)
+					close(_inotify);
+				if (_wake >= 0)
+					close(_wake);
+				_inotify = _wake = -1;
+			}
+		#endif
+	}
+
+	FileWatcher::~FileWatcher() {
+		#if defined(__linux__)
+			if (_thread.joinable()) {
+				const uint64_t	one = 1;
+
+				if (write(_wake, &one, sizeof(one)) == sizeof(one))
+					_thread.join();
+				else
+					_thread.detach();
+				close(_inotify);
+				close(_wake);
+			}
+		#endif
+	}
+
+	# pragma endregion
+
+	# pragma region Public methods
+
+	/// @brief Watch a file
+	/// @param path The file, it may not exist yet
+	/// @param callback Called by poll() with the path given here (normalized) when the file changed
+	/// @return The id of the watch, see unwatch()
+	/// @note A file may be watched several times, each callback is called
+	size_t	FileWatcher::watch(const std::string &path, Callback callback) {
+		const std::string	file = normalize(path);
+		const size_t		id = _nextId++;
+
+		_watches[id] = {file, std::move(callback)};
+
+		std::lock_guard<std::mutex>	lock(_mutex);
+
+		if (_paths[file]++ == 0) {
+			if (isNative())
+				_watchDirectory(std::filesystem::path(file).parent_path().string());
+			else
+				_times[file] = modificationTime(file);
+		}
+
+		return id;
+	}
+
+	/// @brief Stop a watch
+	/// @param id The id returned by watch(), unknown ids are ignored
+	/// @note The directory stays watched by inotify, events of unwatched files are dropped
+	void	FileWatcher::unwatch(size_t id) {
+		auto	watch = _watches.find(id);
+
+		if (watch == _watches.end())
+			return;
+
+		std::lock_guard<std::mutex>	lock(_mutex);
+
+		auto	path = _paths.find(watch->second.path);
+		if (--path->second == 0) {
+			_times.erase(path->first);
+			_paths.erase(path);
+		}
+		_watches.erase(watch);
+	}
+
+	/// @brief Call the callbacks of the files changed since the last call
+	/// @return The number of changed files
+	/// @note Without inotify, the modification time of every watched file is read here
+	size_t	FileWatcher::poll() {
+		std::unordered_set<std::string>	changed;
+		{
+			std::lock_guard<std::mutex>	lock(_mutex);
+
+			if (!isNative()) {
+				for (auto &[path, time] : _times) {
+					const std::filesystem::file_time_type	current = modificationTime(path);
+
+					if (current != time) {
+						time = current;
+						_changed.insert(path);
+					}
+				}
+			}
+			changed.swap(_changed);
+		}
+
+		if (changed.empty())
+			return 0;
+
+		// Callbacks may watch or unwatch, iterate on a copy of the matching ids
+		std::vector<size_t>	ids;
+
+		for (const auto &[id, watch] : _watches)
+			if (changed.count(watch.path))
+				ids.push_back(id);
+
+		for (size_t id : ids) {
+			auto	watch = _watches.find(id);
+
+			if (watch != _watches.end()) {
+				const Watch	copy = watch->second;
+				copy.callback(copy.path);
+			}
+		}
+
+		return changed.size();
+	}
+
+	# pragma endregion
+
+	# pragma region Private methods
+
+	// Watch the directory of a file rather than the file, so a file replaced by a rename keeps being watched
+	void	FileWatcher::_watchDirectory(const std::string &directory) {
+		#if defined(__linux__)
+			const std::string	path = directory.empty() ? "." : directory;
+			const int			descriptor = inotify_add_watch(_inotify, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+
+			if (descriptor >= 0)
+				_directories[descriptor] = directory;
+		#else
+			(void)directory;
+		#endif
+	}
+
+	void	FileWatcher::_run() {
+		#if defined(__linux__)
+			alignas(inotify_event) char	buffer[4096];
+			pollfd						descriptors[2] = {{_inotify, POLLIN, 0}, {_wake, POLLIN, 0}};
+
+			while (true) {
+				if (::poll(descriptors, 2, -1) < 0)
+					continue;
+				if (descriptors[1].revents)
+					return;
+
+				const ssize_t	length = read(_inotify, buffer, sizeof(buffer));
+				if (length <= 0)
+					continue;
+
+				std::lock_guard<std::mutex>	lock(_mutex);
+
+				for (ssize_t offset = 0; offset < length;) {
+					const inotify_event *	event = reinterpret_cast<const inotify_event *>(buffer + offset);
+					auto					directory = _directories.find(event->wd);
+
+					offset += sizeof(inotify_event) + event->len;
+					if (directory == _directories.end() || !event->len)
+						continue;
+
+					const std::string	path = normalize((std::filesystem::path(directory->second) / event->name).string());
+
+					if (_paths.count(path))
+						_changed.insert(path);
+				}
+			}
+		#endif
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return whether changes are noticed by inotify rather than by poll()
+	bool	FileWatcher::isNative() const {
+		return _inotify >= 0;
+	}
+
+	/// @brief Return the number of active watches
+	size_t	FileWatcher::getWatchCount() const {
+		return _watches.size();
+	}
+
+	# pragma endregion
+
+} // namespace GE::Utils
@@ -0,0 +1,71 @@
+#pragma once
+
+/// System includes
+# include <filesystem>
+# include <functional>
+# include <mutex>
+# include <string>
+# include <thread>
+# include <unordered_map>
+# include <unordered_set>
+
+namespace GE::Utils {
+	/**
+	 * @brief Watches files for modifications and calls back their users, e.g. to hot reload shaders or kernels.
+	 *
+	 * On Linux, a background thread waits on inotify for the directories of the watched files, so noticing a change
+	 * costs nothing to the frame. Elsewhere, or if inotify is unavailable, poll() compares the modification times.
+	 *
+	 * Changes are collected until poll(), which calls the callbacks of each changed file once, on the calling thread :
+	 * a callback may touch the OpenGL context if poll() is called from its thread.
+	 *
+	 * @note Editors saving through a temporary file and a rename are handled. A deleted file is reported when it is recreated.
+	 */
+	class FileWatcher {
+		public:
+			using Callback = std::function<void(const std::string &path)>;
+
+			FileWatcher();
+			~FileWatcher();
+
+			FileWatcher(const FileWatcher &) = delete;
+			FileWatcher &operator=(const FileWatcher &) = delete;
+
+			/// Public methods
+
+			size_t	watch(const std::string &path, Callback callback);
+			void	unwatch(size_t id);
+			size_t	poll();
+
+			/// Getters
+
+			bool	isNative() const;
+			size_t	getWatchCount() const;
+
+		private:
+			struct	Watch {
+				std::string	path;
+				Callback	callback;
+			};
+
+			std::unordered_map<size_t, Watch>	_watches;
+			size_t								_nextId = 1;
+
+			// Shared with the background thread
+			std::mutex								_mutex;
+			std::unordered_map<std::string, size_t>	_paths;			// Watched paths, with their number of watches
+			std::unordered_set<std::string>			_changed;		// Since the last poll()
+			std::unordered_map<int, std::string>	_directories;	// Inotify watch descriptor to directory
+
+			std::unordered_map<std::string, std::filesystem::file_time_type>	_times;	// Fallback without inotify
+
+			int			_inotify = -1;
+			int			_wake = -1;		// Event descriptor stopping the thread
+			std::thread	_thread;
+
+			/// Private methods
+
+			void	_watchDirectory(const std::string &directory);
+			void	_run();
+	};
+} // namespace GE::Utils
@@ -0,0 +1,339 @@
+#include "FractalNoise.hpp"
+
+/// Includes
+# include "core/Profiler.hpp"
+
+/// System includes
+# include <algorithm>
+# include <cmath>
+# include <stdexcept>
+# include <string>
+
+namespace GE::Utils {
+
+	# pragma region Constructors & Destructors
+
+	FractalNoise::FractalNoise(const NoiseGenerator &noise, const FractalInfo &info, Type type, Basis basis)
+		: _noise(noise), _type(type), _basis(basis) {
+		setInfo(info);
+	}
+
+	# pragma endregion
+
+	# pragma region Public methods
+
+	/// @brief Sample the fractal noise at a 2D position
+	/// @param v The position to sample
+	/// @return The fractal value in about [-1, 1]
+	float	FractalNoise::sample2D(const glm::vec2 &v) const {
+		float	sum = 0, amplitude = 1, frequency = _info.frequency, weight = 1;
+
+		for (int octave = 0; octave < _activeOctaves; octave++) {
+			const glm::vec3	offset = _octaveOffset(octave);
+
+			sum += _accumulate(_basis2D(v * frequency + glm::vec2{offset.x, offset.y}), amplitude, weight);
+			if (weight <= 0)
+				break;
+
+			amplitude *= _info.gain;
+			frequency *= _info.lacunarity;
+		}
+
+		return _finalize(sum);
+	}
+
+	/// @brief Sample the fractal noise at a 3D position
+	/// @param v The position to sample
+	/// @return The fractal value in about [-1, 1]
+	float	FractalNoise::sample3D(const glm::vec3 &v) const {
+		float	sum = 0, amplitude = 1, frequency = _info.frequency, weight = 1;
+
+		for (int octave = 0; octave < _activeOctaves; octave++) {
+			sum += _accumulate(_basis3D(v * frequency + _octaveOffset(octave)), amplitude, weight);
+			if (weight <= 0)
+				break;
+
+			amplitude *= _info.gain;
+			frequency *= _info.lacunarity;
+		}
+
+		return _finalize(sum);
+	}
+
+	/// @brief Sample the fractal noise at a 2D position displaced by the fractal noise itself
+	/// @param v The position to sample
+	/// @return The fractal value in about [-1, 1]
+	/// @note Costs three sample2D() calls
+	float	FractalNoise::warped2D(const glm::vec2 &v) const {
+		const glm::vec2	warp = {
+			sample2D(v + glm::vec2{5.2f, 1.3f}),
+			sample2D(v + glm::vec2{1.7f, 9.2f})
+		};
+
+		return sample2D(v + warp * _info.warpStrength);
+	}
+
+	/// @brief Sample the fractal noise at a 3D position displaced by the fractal noise itself
+	/// @param v The position to sample
+	/// @return The fractal value in about [-1, 1]
+	/// @note Costs four sample3D() calls
+	float	FractalNoise::warped3D(const glm::vec3 &v) const {
+		const glm::vec3	warp = {
+			sample3D(v + glm::vec3{5.2f, 1.3f, 2.8f}),
+			sample3D(v + glm::vec3{1.7f, 9.2f, 4.1f}),
+			sample3D(v + glm::vec3{8.3f, 2.8f, 7.4f})
+		};
+
+		return sample3D(v + warp * _info.warpStrength);
+	}
+
+	/// @brief Sample the fractal noise and its gradient at a 2D position
+	/// @param v The position to sample
+	/// @return x = sample2D(v), yz = gradient of sample2D at v
+	glm::vec3	FractalNoise::sample2DDerivative(const glm::vec2 &v) const {
+		glm::vec4	sum = {0, 0, 0, 0};
+		glm::vec3	weightGradient = {0, 0, 0};
+		float		amplitude = 1, frequency = _info.frequency, weight = 1;
+
+		for (int octave = 0; octave < _activeOctaves; octave++) {
+			const glm::vec3	offset = _octaveOffset(octave);
+			const glm::vec3	noise = (_basis == Basis::PERLIN)
+				? _noise.perlin2DDerivative(v * frequency + glm::vec2{offset.x, offset.y})
+				: _noise.simplex2DDerivative(v * frequency + glm::vec2{offset.x, offset.y});
+
+			sum += _accumulateDerivative({noise.x, noise.y * frequency, noise.z * frequency, 0}, amplitude, weight, weightGradient);
+			if (weight <= 0)
+				break;
+
+			amplitude *= _info.gain;
+			frequency *= _info.lacunarity;
+		}
+
+		return {_finalize(sum.x), glm::vec2{sum.y, sum.z} * (_type == Type::RIDGED ? 2.0f * _normalization : _normalization)};
+	}
+
+	/// @brief Sample the fractal noise and its gradient at a 3D position
+	/// @param v The position to sample
+	/// @return x = sample3D(v), yzw = gradient of sample3D at v
+	glm::vec4	FractalNoise::sample3DDerivative(const glm::vec3 &v) const {
+		glm::vec4	sum = {0, 0, 0, 0};
+		glm::vec3	weightGradient = {0, 0, 0};
+		float		amplitude = 1, frequency = _info.frequency, weight = 1;
+
+		for (int octave = 0; octave < _activeOctaves; octave++) {
+			const glm::vec3	position = v * frequency + _octaveOffset(octave);
+			const glm::vec4	noise = (_basis == Basis::PERLIN)
+				? _noise.perlin3DDerivative(position)
+				: _noise.simplex3DDerivative(position);
+
+			sum += _accumulateDerivative({noise.x, noise.y * frequency, noise.z * frequency, noise.w * frequency}, amplitude, weight, weightGradient);
+			if (weight <= 0)
+				break;
+
+			amplitude *= _info.gain;
+			frequency *= _info.lacunarity;
+		}
+
+		return {_finalize(sum.x), glm::vec3{sum.y, sum.z, sum.w} * (_type == Type::RIDGED ? 2.0f * _normalization : _normalization)};
+	}
+
+	/// @brief Fill a strided grid with the fractal noise, all octaves in a single call
+	/// @param out The destination grid, row y starts at out + y * stride
+	/// @param origin The noise coordinates of the first sample
+	/// @param step The distance between two samples on each axis
+	/// @param count The number of samples on each axis
+	/// @param stride The number of floats between two rows, 0 means count.x
+	/// @throw std::invalid_argument if stride is smaller than count.x
+	/// @note With the PERLIN basis each octave goes through NoiseGenerator::perlin2DGrid()
+	void	FractalNoise::sample2DGrid(float *out, const glm::vec2 &origin, const glm::vec2 &step, const glm::uvec2 &count, size_t stride) const {
+		GE_PROFILE_SCOPE("FractalNoise::sample2DGrid");
+
+		if (!out || !count.x || !count.y)
+			return;
+
+		if (!stride)
+			stride = count.x;
+		else if (stride < count.x)
+			throw std::invalid_argument("FractalNoise: Grid stride (" + std::to_string(stride) +
+										") is smaller than the row length (" + std::to_string(count.x) + ")");
+
+		const size_t		sampleCount = (size_t)count.x * count.y;
+		std::vector<float>	octaveValues(sampleCount);
+		std::vector<float>	weights(sampleCount, 1.0f);
+		float				amplitude = 1, frequency = _info.frequency;
+
+		for (size_t y = 0; y < count.y; y++)
+			std::fill(out + y * stride, out + y * stride + count.x, 0.0f);
+
+		for (int octave = 0; octave < _activeOctaves; octave++) {
+			const glm::vec3	offset = _octaveOffset(octave);
+			const glm::vec2	octaveOrigin = origin * frequency + glm::vec2{offset.x, offset.y};
+			const glm::vec2	octaveStep = step * frequency;
+
+			if (_basis == Basis::PERLIN)
+				_noise.perlin2DGrid(octaveValues.data(), octaveOrigin, octaveStep, count);
+			else
+				for (size_t y = 0; y < count.y; y++)
+					for (size_t x = 0; x < count.x; x++)
+						octaveValues[y * count.x + x] = _noise.simplex2D(octaveOrigin + glm::vec2{(float)x, (float)y} * octaveStep);
+
+			for (size_t y = 0; y < count.y; y++)
+				for (size_t x = 0; x < count.x; x++)
+					out[y * stride + x] += _accumulate(octaveValues[y * count.x + x], amplitude, weights[y * count.x + x]);
+
+			amplitude *= _info.gain;
+			frequency *= _info.lacunarity;
+		}
+
+		for (size_t y = 0; y < count.y; y++)
+			for (size_t x = 0; x < count.x; x++)
+				out[y * stride + x] = _finalize(out[y * stride + x]);
+	}
+
+	# pragma endregion
+
+	# pragma region Private methods
+
+	// Count the octaves above the amplitude threshold and the normalization of their sum
+	void	FractalNoise::_updateOctaves() {
+		float	amplitude = 1, total = 0;
+
+		_activeOctaves = 0;
+		for (int octave = 0; octave < _info.octaves && amplitude >= _info.amplitudeThreshold; octave++) {
+			total += amplitude;
+			amplitude *= _info.gain;
+			_activeOctaves++;
+		}
+
+		_normalization = (total > 0) ? 1.0f / total : 0.0f;
+	}
+
+	float	FractalNoise::_basis2D(const glm::vec2 &v) const {
+		return (_basis == Basis::PERLIN) ? _noise.perlin2D(v) : _noise.simplex2D(v);
+	}
+
+	float	FractalNoise::_basis3D(const glm::vec3 &v) const {
+		return (_basis == Basis::PERLIN) ? _noise.perlin3D(v) : _noise.simplex3D(v);
+	}
+
+	// Shape one octave according to the fractal type
+	// weight is only used by RIDGED, it masks the next octaves where this one is low
+	float	FractalNoise::_accumulate(float noise, float amplitude, float &weight) const {
+		switch (_type) {
+			case Type::BILLOW:
+				return (2.0f * std::abs(noise) - 1.0f) * amplitude;
+
+			case Type::RIDGED: {
+				float	signal = _info.ridgeOffset - std::abs(noise);
+
+				signal *= signal * weight;
+				weight = std::clamp(signal * _info.ridgeWeight, 0.0f, 1.0f);
+				return signal * amplitude;
+			}
+
+			default:
+				return noise * amplitude;
+		}
+	}
+
+	// _accumulate() carrying the gradient along, noise = (value, gradient w.r.t. the sampled position)
+	// weightGradient is the gradient of the RIDGED weight, which depends on the previous octaves
+	glm::vec4	FractalNoise::_accumulateDerivative(const glm::vec4 &noise, float amplitude, float &weight, glm::vec3 &weightGradient) const {
+		const glm::vec3	gradient = {noise.y, noise.z, noise.w};
+		const float		sign = (noise.x < 0) ? -1.0f : 1.0f;
+
+		switch (_type) {
+			case Type::BILLOW:
+				return glm::vec4{2.0f * std::abs(noise.x) - 1.0f, gradient * (2.0f * sign)} * amplitude;
+
+			case Type::RIDGED: {
+				const float		ridge = _info.ridgeOffset - std::abs(noise.x);
+				const float		signal = ridge * ridge * weight;
+				const glm::vec3	dSignal = gradient * (-2.0f * sign * ridge * weight) + weightGradient * (ridge * ridge);
+				const float		nextWeight = signal * _info.ridgeWeight;
+
+				weight = std::clamp(nextWeight, 0.0f, 1.0f);
+				weightGradient = (nextWeight > 0 && nextWeight < 1) ? dSignal * _info.ridgeWeight : glm::vec3{0, 0, 0};
+				return glm::vec4{signal, dSignal} * amplitude;
+			}
+
+			default:
+				return noise * amplitude;
+		}
+	}
+
+	// Bring the octave sum back to about [-1, 1]
+	float	FractalNoise::_finalize(float sum) const {
+		if (_type == Type::RIDGED)
+			return sum * _normalization * 2.0f - 1.0f;
+
+		return sum * _normalization;
+	}
+
+	// Decorrelate the octaves, otherwise every lattice would align at the origin
+	glm::vec3	FractalNoise::_octaveOffset(int octave) {
+		return glm::vec3{31.416f, 17.728f, 23.173f} * (float)octave;
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the octave settings
+	const FractalInfo &	FractalNoise::getInfo() const {
+		return _info;
+	}
+
+	/// @brief Return the fractal type
+	FractalNoise::Type	FractalNoise::getType() const {
+		return _type;
+	}
+
+	/// @brief Return the noise evaluated by each octave
+	FractalNoise::Basis	FractalNoise::getBasis() const {
+		return _basis;
+	}
+
+	/// @brief Return the number of octaves actually evaluated, after the amplitude threshold
+	int	FractalNoise::getActiveOctaves() const {
+		return _activeOctaves;
+	}
+
+	/// @brief Return the factor bringing the sum of the active octaves back to about [-1, 1]
+	float	FractalNoise::getNormalization() const {
+		return _normalization;
+	}
+
+	/// @brief Return the generator evaluated by each octave
+	const NoiseGenerator &	FractalNoise::getNoise() const {
+		return _noise;
+	}
+
+	# pragma endregion
+
+	# pragma region Setters
+
+	/// @brief Set the octave settings
+	/// @param info The new octave settings
+	/// @throw std::invalid_argument if info.octaves is lower than 1
+	void	FractalNoise::setInfo(const FractalInfo &info) {
+		if (info.octaves < 1)
+			throw std::invalid_argument("FractalNoise: Invalid octave count " + std::to_string(info.octaves));
+
+		_info = info;
+		_updateOctaves();
+	}
+
+	/// @brief Set the fractal type
+	void	FractalNoise::setType(Type type) {
+		_type = type;
+	}
+
+	/// @brief Set the noise evaluated by each octave
+	void	FractalNoise::setBasis(Basis basis) {
+		_basis = basis;
+	}
+
+	# pragma endregion
+
+} // namespace GE::Utils
\ No newline at end of file
@@ -0,0 +1,116 @@
+# pragma once
+
+/// Includes
+# include "NoiseGenerator.hpp"
+
+/// System includes
+# include <vector>
+
+/// Dependencies
+# include <glm/glm.hpp>
+
+namespace GE::Utils {
+
+	/// @brief Stores the octave settings of a fractal noise
+	struct FractalInfo {
+		int		octaves            = 6;
+		float	frequency          = 1.0f;	// Frequency of the first octave
+		float	lacunarity         = 2.0f;	// Frequency multiplier between octaves
+		float	gain               = 0.5f;	// Amplitude multiplier between octaves
+		float	amplitudeThreshold = 1e-3f;	// Octaves with a lower amplitude are skipped
+		float	ridgeOffset        = 1.0f;	// RIDGED only, offset applied before squaring
+		float	ridgeWeight        = 2.0f;	// RIDGED only, how much an octave masks the next ones
+		float	warpStrength       = 4.0f;	// Displacement applied by the warped functions
+	};
+
+	/**
+	 * @brief Layers several octaves of a NoiseGenerator into fractal noise.
+	 *
+	 * Currently supports :
+	 * - fBm (fractional Brownian motion)
+	 * - Ridged multifractal
+	 * - Billow
+	 * - Domain warping of any of the above
+	 * - Analytic derivatives of the above (without warping), for normals and slopes
+	 *
+	 * Octaves whose amplitude falls below FractalInfo::amplitudeThreshold are never evaluated,
+	 * and ridged octaves stop as soon as the previous ones fully mask them.
+	 *
+	 * All types return values in about [-1, 1].
+	 *
+	 * @note The NoiseGenerator is referenced, not copied, it must outlive the FractalNoise.
+	 * @note Sampling functions are const and thread-safe, setters must not run while another thread samples.
+	 */
+	class	FractalNoise {
+		public:
+			// Fractal types
+			enum class Type {
+				FBM,
+				RIDGED,
+				BILLOW
+			};
+
+			// Noise evaluated by each octave
+			enum class Basis {
+				PERLIN,
+				SIMPLEX
+			};
+
+			FractalNoise(const NoiseGenerator &noise, const FractalInfo &info = {}, Type type = Type::FBM, Basis basis = Basis::PERLIN);
+			~FractalNoise() = default;
+
+			/// Public methods
+
+			float	sample2D(const glm::vec2 &v) const;
+			float	sample3D(const glm::vec3 &v) const;
+
+			float	warped2D(const glm::vec2 &v) const;
+			float	warped3D(const glm::vec3 &v) const;
+
+			glm::vec3	sample2DDerivative(const glm::vec2 &v) const;
+			glm::vec4	sample3DDerivative(const glm::vec3 &v) const;
+
+			void	sample2DGrid(
+				float *out,
+				const glm::vec2 &origin,
+				const glm::vec2 &step,
+				const glm::uvec2 &count,
+				size_t stride = 0
+			) const;
+
+			/// Getters
+
+			const FractalInfo &	getInfo() const;
+			Type				getType() const;
+			Basis				getBasis() const;
+			int					getActiveOctaves() const;
+			float				getNormalization() const;
+			const NoiseGenerator &	getNoise() const;
+
+			/// Setters
+
+			void	setInfo(const FractalInfo &info);
+			void	setType(Type type);
+			void	setBasis(Basis basis);
+
+		private:
+			const NoiseGenerator &	_noise;
+			FractalInfo			_info;
+			Type				_type;
+			Basis				_basis;
+
+			int					_activeOctaves;	// Octaves above the amplitude threshold
+			float				_normalization;	// 1 / sum of the active amplitudes
+
+			/// Private methods
+
+			void			_updateOctaves();
+			float			_basis2D(const glm::vec2 &v) const;
+			float			_basis3D(const glm::vec3 &v) const;
+			float			_accumulate(float noise, float amplitude, float &weight) const;
+			glm::vec4		_accumulateDerivative(const glm::vec4 &noise, float amplitude, float &weight, glm::vec3 &weightGradient) const;
+			float			_finalize(float sum) const;
+
+			static glm::vec3	_octaveOffset(int octave);
+	};
+} // namespace GE::Utils
\ No newline at end of file
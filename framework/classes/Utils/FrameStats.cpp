@@ -0,0 +1,185 @@
+#include "FrameStats.hpp"
+
+/// System includes
+# include <algorithm>
+# include <cmath>
+# include <fstream>
+# include <numeric>
+# include <stdexcept>
+
+/// Dependencies
+# include <json/json_config.hpp>
+
+namespace GE::Utils {
+
+	// Nearest-rank percentile of sorted values
+	static double	percentile(const std::vector<double> &sorted, double rank) {
+		const size_t	index = (size_t)std::ceil(rank / 100.0 * sorted.size());
+
+		return sorted[std::clamp<size_t>(index, 1, sorted.size()) - 1];
+	}
+
+	# pragma region Constructors & Destructors
+
+	/// @param capacity The number of frames kept, the most recent ones
+	/// @param hitchThreshold The frame time in milliseconds over which a frame is a hitch
+	/// @throw std::invalid_argument if capacity is 0
+	FrameStats::FrameStats(size_t capacity, double hitchThreshold) : _hitchThreshold(hitchThreshold) {
+		if (!capacity)
+			throw std::invalid_argument("FrameStats: Capacity must be positive");
+		_frames.resize(capacity);
+	}
+
+	# pragma endregion
+
+	# pragma region Public methods
+
+	/// @brief Record a frame, replacing the oldest one when full
+	/// @param frameTime The frame time in milliseconds
+	void	FrameStats::push(double frameTime) {
+		_frames[_next] = frameTime;
+		_next = (_next + 1) % _frames.size();
+		_count = std::min(_count + 1, _frames.size());
+
+		_totalFrames++;
+		_totalHitches += frameTime > _hitchThreshold;
+	}
+
+	/// @brief Forget every frame and reset the totals
+	void	FrameStats::clear() {
+		_next = 0;
+		_count = 0;
+		_totalFrames = 0;
+		_totalHitches = 0;
+	}
+
+	/// @brief Compute the statistics of the frames held
+	/// @return The summary, zeroed except the totals if no frame was pushed
+	FrameStatsSummary	FrameStats::summarize() const {
+		FrameStatsSummary	summary = {};
+
+		summary.totalFrames = _totalFrames;
+		summary.totalHitches = _totalHitches;
+		if (!_count)
+			return summary;
+
+		std::vector<double>	sorted = getFrameTimes();
+		std::sort(sorted.begin(), sorted.end());
+
+		const size_t	slowest = std::max<size_t>(1, sorted.size() / 100);
+		const double	slowestMean = std::accumulate(sorted.end() - slowest, sorted.end(), 0.0) / slowest;
+
+		summary.frames = sorted.size();
+		summary.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+		summary.min = sorted.front();
+		summary.max = sorted.back();
+		summary.p50 = percentile(sorted, 50);
+		summary.p95 = percentile(sorted, 95);
+		summary.p99 = percentile(sorted, 99);
+		summary.meanFPS = summary.mean > 0 ? 1000.0 / summary.mean : 0;
+		summary.low1FPS = slowestMean > 0 ? 1000.0 / slowestMean : 0;
+		summary.hitches = sorted.end() - std::upper_bound(sorted.begin(), sorted.end(), _hitchThreshold);
+
+		return summary;
+	}
+
+	/// @brief Write the frame times, oldest first, as a CSV file with a "frame,time_ms" header
+	/// @param path The file to write, replaced if it exists
+	/// @throw std::runtime_error if the file cannot be written
+	void	FrameStats::exportCSV(const std::string &path) const {
+		std::ofstream	file(path, std::ios::trunc);
+
+		if (!file.is_open())
+			throw std::runtime_error("FrameStats: Failed to open file " + path);
+
+		const std::vector<double>	frames = getFrameTimes();
+
+		file << "frame,time_ms\n";
+		for (size_t i = 0; i < frames.size(); i++)
+			file << i << ',' << frames[i] << '\n';
+
+		if (!file)
+			throw std::runtime_error("FrameStats: Failed to write file " + path);
+	}
+
+	/// @brief Write the summary and the frame times, oldest first, as a JSON file
+	/// @param path The file to write, replaced if it exists
+	/// @throw std::runtime_error if the file cannot be written
+	void	FrameStats::exportJSON(const std::string &path) const {
+		std::ofstream	file(path, std::ios::trunc);
+
+		if (!file.is_open())
+			throw std::runtime_error("FrameStats: Failed to open file " + path);
+
+		const FrameStatsSummary	summary = summarize();
+		json					root;
+
+		root["hitchThreshold"] = _hitchThreshold;
+		root["summary"]["frames"] = summary.frames;
+		root["summary"]["mean"] = summary.mean;
+		root["summary"]["min"] = summary.min;
+		root["summary"]["max"] = summary.max;
+		root["summary"]["p50"] = summary.p50;
+		root["summary"]["p95"] = summary.p95;
+		root["summary"]["p99"] = summary.p99;
+		root["summary"]["meanFPS"] = summary.meanFPS;
+		root["summary"]["low1FPS"] = summary.low1FPS;
+		root["summary"]["hitches"] = summary.hitches;
+		root["summary"]["totalFrames"] = summary.totalFrames;
+		root["summary"]["totalHitches"] = summary.totalHitches;
+		root["frameTimes"] = getFrameTimes();
+
+		file << root.dump(1, '\t') << '\n';
+
+		if (!file)
+			throw std::runtime_error("FrameStats: Failed to write file " + path);
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the number of frames the ring holds at most
+	size_t	FrameStats::getCapacity() const {
+		return _frames.size();
+	}
+
+	/// @brief Return the number of frames held
+	size_t	FrameStats::getCount() const {
+		return _count;
+	}
+
+	/// @brief Return the last frame time in milliseconds, 0 if none
+	double	FrameStats::getLast() const {
+		return _count ? _frames[(_next + _frames.size() - 1) % _frames.size()] : 0;
+	}
+
+	/// @brief Return the frame time in milliseconds over which a frame is a hitch
+	double	FrameStats::getHitchThreshold() const {
+		return _hitchThreshold;
+	}
+
+	/// @brief Return the frame times held in milliseconds, oldest first
+	std::vector<double>	FrameStats::getFrameTimes() const {
+		std::vector<double>	frames;
+		const size_t		first = (_next + _frames.size() - _count) % _frames.size();
+
+		frames.reserve(_count);
+		for (size_t i = 0; i < _count; i++)
+			frames.push_back(_frames[(first + i) % _frames.size()]);
+		return frames;
+	}
+
+	# pragma endregion
+
+	# pragma region Setters
+
+	/// @brief Set the frame time in milliseconds over which a frame is a hitch, e.g. twice the target frame time
+	/// @note totalHitches keeps the frames counted with the previous threshold
+	void	FrameStats::setHitchThreshold(double milliseconds) {
+		_hitchThreshold = milliseconds;
+	}
+
+	# pragma endregion
+
+} // namespace GE::Utils
@@ -0,0 +1,68 @@
+#pragma once
+
+/// System includes
+# include <cstddef>
+# include <string>
+# include <vector>
+
+namespace GE::Utils {
+
+	/// @brief Statistics of the frames held by a FrameStats, times in milliseconds
+	struct FrameStatsSummary {
+		size_t	frames;			// Frames summarized, up to the capacity
+		double	mean;
+		double	min;
+		double	max;
+		double	p50;
+		double	p95;
+		double	p99;
+		double	meanFPS;		// 1000 / mean
+		double	low1FPS;		// "1% low" : 1000 / mean of the slowest 1% of the frames
+		size_t	hitches;		// Frames over the hitch threshold
+		size_t	totalFrames;	// Since the start or the last clear()
+		size_t	totalHitches;	// Since the start or the last clear()
+	};
+
+	/**
+	 * @brief A rolling window of frame times, summarized on demand in percentiles, 1% lows and hitches.
+	 *
+	 * push() only writes a ring slot, summarize() sorts a copy of the ring : call it for a display refreshed a few
+	 * times a second or an export, not every frame.
+	 *
+	 * The average hides stutters : a frame of 100 ms among 99 frames of 10 ms still averages 11 ms, while the p99 and the
+	 * 1% low show it.
+	 */
+	class FrameStats {
+		public:
+			explicit FrameStats(size_t capacity = 1024, double hitchThreshold = 1000.0 / 30.0);
+			~FrameStats() = default;
+
+			/// Public methods
+
+			void				push(double frameTime);
+			void				clear();
+			FrameStatsSummary	summarize() const;
+			void				exportCSV(const std::string &path) const;
+			void				exportJSON(const std::string &path) const;
+
+			/// Getters
+
+			size_t				getCapacity() const;
+			size_t				getCount() const;
+			double				getLast() const;
+			double				getHitchThreshold() const;
+			std::vector<double>	getFrameTimes() const;
+
+			/// Setters
+
+			void	setHitchThreshold(double milliseconds);
+
+		private:
+			std::vector<double>	_frames;	// Ring of frame times
+			size_t				_next = 0;
+			size_t				_count = 0;
+			size_t				_totalFrames = 0;
+			size_t				_totalHitches = 0;
+			double				_hitchThreshold;
+	};
+} // namespace GE::Utils
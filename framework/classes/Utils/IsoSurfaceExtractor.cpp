@@ -0,0 +1,413 @@
+#include "IsoSurfaceExtractor.hpp"
+
+/// System includes
+# include <algorithm>
+# include <array>
+# include <chrono>
+# include <cmath>
+# include <stdexcept>
+
+namespace GE::Utils {
+
+	// Cell corners are numbered x + 2y + 4z
+	// Cell edges are numbered axis * 4 + k, k giving the start corner on the two other axes, in (axis + 1, axis + 2) order
+	static constexpr uint32_t	noVertex = UINT32_MAX;
+
+	struct	MarchingCase {
+		uint8_t	triangleCount;
+		uint8_t	edges[12 * 3];
+	};
+
+	static glm::ivec3	edgeStart(int edge) {
+		const int	axis = edge / 4, k = edge % 4;
+		glm::ivec3	offset(0);
+
+		offset[(axis + 1) % 3] = k & 1;
+		offset[(axis + 2) % 3] = k >> 1;
+		return offset;
+	}
+
+	static int	cornerIndex(const glm::ivec3 &offset) {
+		return offset.x | offset.y << 1 | offset.z << 2;
+	}
+
+	// Edge joining two corners differing on one axis
+	static int	edgeBetween(const glm::ivec3 &a, const glm::ivec3 &b) {
+		const glm::ivec3	low = glm::min(a, b);
+		const int			axis = (a.x != b.x) ? 0 : (a.y != b.y) ? 1 : 2;
+
+		return axis * 4 + low[(axis + 1) % 3] + low[(axis + 2) % 3] * 2;
+	}
+
+	/*
+	 * The marching cubes cases, built once instead of typed in.
+	 *
+	 * Each cube face is walked counter-clockwise seen from outside the cube. Every crossed edge is either an entry
+	 * (air to solid) or an exit, and each entry is joined to the next exit : on ambiguous faces the two solid
+	 * corners stay separated. Neighbor cells walk their shared face both ways but pair the same crossings, so
+	 * the surface has no hole. The segments chain into closed loops, triangulated as fans.
+	 */
+	static const std::array<MarchingCase, 256> &	marchingCases() {
+		static const std::array<MarchingCase, 256>	cases = []() {
+			std::array<MarchingCase, 256>	table = {};
+
+			for (int config = 0; config < 256; config++) {
+				int		next[12];
+				std::fill_n(next, 12, -1);
+
+				for (int axis = 0; axis < 3; axis++) {
+					for (int side = 0; side < 2; side++) {
+						const int	u = (axis + 1) % 3, v = (axis + 2) % 3;
+						glm::ivec3	corners[4];
+
+						for (int i = 0; i < 4; i++) {
+							corners[i][axis] = side;
+							corners[i][u] = (i == 1 || i == 2);
+							corners[i][v] = (i >= 2);
+						}
+						if (!side)
+							std::swap(corners[1], corners[3]);
+
+						int		crossings[4], entries[4], count = 0;
+						for (int i = 0; i < 4; i++) {
+							const bool	from = config >> cornerIndex(corners[i]) & 1;
+							const bool	to = config >> cornerIndex(corners[(i + 1) % 4]) & 1;
+
+							if (from != to) {
+								crossings[count] = edgeBetween(corners[i], corners[(i + 1) % 4]);
+								entries[count++] = to;
+							}
+						}
+
+						for (int i = 0; i < count; i++) {
+							if (!entries[i])
+								continue;
+							for (int j = 1; j < count; j++) {
+								if (!entries[(i + j) % count]) {
+									next[crossings[i]] = crossings[(i + j) % count];
+									break;
+								}
+							}
+						}
+					}
+				}
+
+				MarchingCase &	out = table[config];
+				bool			visited[12] = {};
+
+				for (int start = 0; start < 12; start++) {
+					if (next[start] < 0 || visited[start])
+						continue;
+
+					int		loop[12], length = 0;
+					for (int edge = start; !visited[edge]; edge = next[edge]) {
+						visited[edge] = true;
+						loop[length++] = edge;
+					}
+
+					for (int i = 1; i + 1 < length; i++) {
+						out.edges[out.triangleCount * 3 + 0] = (uint8_t)loop[0];
+						out.edges[out.triangleCount * 3 + 1] = (uint8_t)loop[i];
+						out.edges[out.triangleCount * 3 + 2] = (uint8_t)loop[i + 1];
+						out.triangleCount++;
+					}
+				}
+			}
+			return table;
+		}();
+
+		return cases;
+	}
+
+	// Solve the 3x3 symmetric system m * x = b, 0 if singular
+	static glm::vec3	solveSymmetric(const float m[3][3], const glm::vec3 &b) {
+		const float	c00 = m[1][1] * m[2][2] - m[1][2] * m[1][2];
+		const float	c01 = m[0][2] * m[1][2] - m[0][1] * m[2][2];
+		const float	c02 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+		const float	det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+
+		if (std::fabs(det) < 1e-12f)
+			return glm::vec3(0);
+
+		const float	c11 = m[0][0] * m[2][2] - m[0][2] * m[0][2];
+		const float	c12 = m[0][1] * m[0][2] - m[0][0] * m[1][2];
+		const float	c22 = m[0][0] * m[1][1] - m[0][1] * m[0][1];
+
+		return glm::vec3(
+			c00 * b.x + c01 * b.y + c02 * b.z,
+			c01 * b.x + c11 * b.y + c12 * b.z,
+			c02 * b.x + c12 * b.y + c22 * b.z
+		) / det;
+	}
+
+	// Gradient of the trilinear interpolation of a cell at f, in [0, 1] on each axis
+	static glm::vec3	trilinearGradient(const float corners[8], const glm::vec3 &f) {
+		glm::vec3	gradient(0);
+
+		for (int corner = 0; corner < 8; corner++) {
+			const glm::vec3	side = {(float)(corner & 1), (float)(corner >> 1 & 1), (float)(corner >> 2)};
+			const glm::vec3	weight = {
+				side.x ? f.x : 1 - f.x,
+				side.y ? f.y : 1 - f.y,
+				side.z ? f.z : 1 - f.z
+			};
+			const glm::vec3	sign = side * 2.0f - 1.0f;
+
+			gradient += glm::vec3(sign.x * weight.y * weight.z, weight.x * sign.y * weight.z, weight.x * weight.y * sign.z) * corners[corner];
+		}
+		return gradient;
+	}
+
+	// Normal out of the solid from a density gradient, up if the gradient vanishes
+	static glm::vec3	outwardNormal(const glm::vec3 &gradient) {
+		const float	length = glm::length(gradient);
+
+		return (length > 1e-12f) ? -gradient / length : glm::vec3(0, 1, 0);
+	}
+
+	# pragma region Constructors & Destructors
+
+	IsoSurfaceExtractor::IsoSurfaceExtractor(const IsoSurfaceInfo &info) : _info(info), _pool(info.threadCount) {
+		if (!(info.sampleSpacing > 0))
+			throw std::invalid_argument("IsoSurfaceExtractor: Sample spacing must be positive");
+
+		marchingCases();
+	}
+
+	// _pool is destroyed first : queued blocks are dropped, running ones are waited for
+	IsoSurfaceExtractor::~IsoSurfaceExtractor() {}
+
+	# pragma endregion
+
+	# pragma region Public methods
+
+	/// @brief Mesh a density tile on a worker thread
+	/// @param tile A DENSITY tile, from TerrainField::requestDensity() or filled by hand
+	/// @return A future to the mesh, or to the exception thrown by extract()
+	/// @throw std::invalid_argument if tile is null
+	std::future<IsoMeshPtr>	IsoSurfaceExtractor::submit(TerrainTilePtr tile) {
+		if (!tile)
+			throw std::invalid_argument("IsoSurfaceExtractor: Null tile");
+
+		return _pool.submit([this, tile]() -> IsoMeshPtr {
+			std::shared_ptr<IsoMesh>	mesh = std::make_shared<IsoMesh>();
+
+			extract(tile->values.data(), tile->size, tile->origin, *mesh);
+			return mesh;
+		});
+	}
+
+	/// @brief Mesh a density block on the calling thread
+	/// @param density The samples, x first, then y, then z
+	/// @param size The number of samples on each axis
+	/// @param origin The world position of the first sample
+	/// @param mesh The output, cleared first
+	/// @throw std::invalid_argument if the block has less than 2 samples on an axis
+	void	IsoSurfaceExtractor::extract(const float *density, const glm::uvec3 &size, const glm::vec3 &origin, IsoMesh &mesh) {
+		if (!density || size.x < 2 || size.y < 2 || size.z < 2)
+			throw std::invalid_argument("IsoSurfaceExtractor: A density block needs at least 2 samples on each axis");
+
+		const auto	start = std::chrono::steady_clock::now();
+		const Block	block = {density, glm::ivec3(size), origin, _info.sampleSpacing, _info.isoLevel};
+
+		mesh.vertices.clear();
+		mesh.indices.clear();
+
+		if (_info.method == IsoSurfaceMethod::DUAL_CONTOURING)
+			_dualContouring(block, mesh);
+		else
+			_marchingCubes(block, mesh);
+
+		_extractionTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		_extractedBlocks++;
+		_vertices += mesh.vertices.size();
+		_triangles += mesh.indices.size() / 3;
+	}
+
+	# pragma endregion
+
+	# pragma region Private methods
+
+	// Central differences, one-sided on the block faces
+	glm::vec3	IsoSurfaceExtractor::Block::gradient(int x, int y, int z) const {
+		const glm::ivec3	p = {x, y, z};
+		glm::vec3			gradient;
+
+		for (int axis = 0; axis < 3; axis++) {
+			glm::ivec3	low = p, high = p;
+
+			low[axis] = std::max(p[axis] - 1, 0);
+			high[axis] = std::min(p[axis] + 1, size[axis] - 1);
+			gradient[axis] = (at(high.x, high.y, high.z) - at(low.x, low.y, low.z)) / (float)(high[axis] - low[axis]);
+		}
+		return gradient;
+	}
+
+	// Edge vertices are cached for two sample layers : the edges starting on layer z and z + 1
+	void	IsoSurfaceExtractor::_marchingCubes(const Block &block, IsoMesh &mesh) const {
+		const std::array<MarchingCase, 256> &	cases = marchingCases();
+		const glm::ivec3						size = block.size;
+		const size_t							layer = (size_t)size.x * size.y * 3;
+
+		std::vector<uint32_t>	cache(layer * 2, noVertex);
+
+		const auto	edgeVertex = [&](const glm::ivec3 &p, int axis) -> uint32_t {
+			uint32_t &	slot = cache[(p.z & 1) * layer + ((size_t)p.y * size.x + p.x) * 3 + axis];
+			if (slot != noVertex)
+				return slot;
+
+			glm::ivec3	q = p;
+			q[axis]++;
+
+			const float	a = block.at(p.x, p.y, p.z), b = block.at(q.x, q.y, q.z);
+			const float	t = (block.isoLevel - a) / (b - a);
+			glm::vec3	position = glm::vec3(p);
+
+			position[axis] += t;
+			slot = (uint32_t)mesh.vertices.size();
+			mesh.vertices.push_back({
+				block.origin + position * block.spacing,
+				outwardNormal(glm::mix(block.gradient(p.x, p.y, p.z), block.gradient(q.x, q.y, q.z), t))
+			});
+			return slot;
+		};
+
+		for (int z = 0; z < size.z - 1; z++) {
+			// Layer z + 1 reuses the slots of layer z - 1
+			if (z)
+				std::fill_n(cache.begin() + ((z + 1) & 1) * layer, layer, noVertex);
+
+			for (int y = 0; y < size.y - 1; y++) {
+				int	config = block.solid(0, y, z) << 1 | block.solid(0, y + 1, z) << 3
+						   | block.solid(0, y, z + 1) << 5 | block.solid(0, y + 1, z + 1) << 7;
+
+				for (int x = 0; x < size.x - 1; x++) {
+					// The +x corners of the previous cell are the -x corners of this one
+					config = (config >> 1 & 0x55)
+						   | block.solid(x + 1, y, z) << 1 | block.solid(x + 1, y + 1, z) << 3
+						   | block.solid(x + 1, y, z + 1) << 5 | block.solid(x + 1, y + 1, z + 1) << 7;
+					if (config == 0 || config == 0xFF)
+						continue;
+
+					const MarchingCase &	cell = cases[config];
+					for (int i = 0; i < cell.triangleCount * 3; i++) {
+						const int	edge = cell.edges[i];
+						mesh.indices.push_back(edgeVertex(glm::ivec3{x, y, z} + edgeStart(edge), edge / 4));
+					}
+				}
+			}
+		}
+	}
+
+	// Cell vertices are placed on first use, quads are emitted for the crossed edges starting from 1 to size - 2
+	void	IsoSurfaceExtractor::_dualContouring(const Block &block, IsoMesh &mesh) const {
+		const glm::ivec3	cells = block.size - 1;
+
+		std::vector<uint32_t>	cellVertices((size_t)cells.x * cells.y * cells.z, noVertex);
+
+		// Minimize the distance to the tangent planes at the crossings, biased toward their mean
+		const auto	cellVertex = [&](const glm::ivec3 &cell) -> uint32_t {
+			uint32_t &	slot = cellVertices[((size_t)cell.z * cells.y + cell.y) * cells.x + cell.x];
+			if (slot != noVertex)
+				return slot;
+
+			// Only the cell samples are read, so the cells shared by two blocks get the same vertex in both
+			float	corners[8];
+			for (int corner = 0; corner < 8; corner++)
+				corners[corner] = block.at(cell.x + (corner & 1), cell.y + (corner >> 1 & 1), cell.z + (corner >> 2));
+
+			glm::vec3	points[12], normals[12], mean(0), normal(0);
+			int			count = 0;
+
+			for (int edge = 0; edge < 12; edge++) {
+				const glm::ivec3	start = edgeStart(edge);
+				const float			a = corners[cornerIndex(start)], b = corners[cornerIndex(start) | 1 << (edge / 4)];
+
+				if ((a > block.isoLevel) == (b > block.isoLevel))
+					continue;
+
+				points[count] = glm::vec3(start);
+				points[count][edge / 4] += (block.isoLevel - a) / (b - a);
+				normals[count] = -outwardNormal(trilinearGradient(corners, points[count]));
+				mean += points[count];
+				normal += normals[count];
+				count++;
+			}
+			mean = mean / (float)count;
+
+			float		ata[3][3] = {{_info.qefBias, 0, 0}, {0, _info.qefBias, 0}, {0, 0, _info.qefBias}};
+			glm::vec3	atb(0);
+
+			for (int i = 0; i < count; i++) {
+				for (int r = 0; r < 3; r++)
+					for (int c = 0; c < 3; c++)
+						ata[r][c] += normals[i][r] * normals[i][c];
+				atb += normals[i] * glm::dot(normals[i], points[i] - mean);
+			}
+
+			// Clamped to the cell, a vertex outside would fold the quads around it
+			glm::vec3	position = mean + solveSymmetric(ata, atb);
+			position = glm::vec3(cell) + glm::max(glm::vec3(0), glm::min(position, glm::vec3(1)));
+
+			slot = (uint32_t)mesh.vertices.size();
+			mesh.vertices.push_back({block.origin + position * block.spacing, outwardNormal(normal)});
+			return slot;
+		};
+
+		for (int z = 1; z < block.size.z - 1; z++) {
+			for (int y = 1; y < block.size.y - 1; y++) {
+				for (int x = 1; x < block.size.x - 1; x++) {
+					const glm::ivec3	p = {x, y, z};
+					const bool			solid = block.solid(x, y, z);
+
+					for (int axis = 0; axis < 3; axis++) {
+						glm::ivec3	q = p;
+						q[axis]++;
+
+						if (block.solid(q.x, q.y, q.z) == solid)
+							continue;
+
+						// The four cells around the edge, counter-clockwise seen from +axis
+						const int	u = (axis + 1) % 3, v = (axis + 2) % 3;
+						uint32_t	quad[4];
+
+						for (int i = 0; i < 4; i++) {
+							glm::ivec3	cell = p;
+							cell[u] -= (i == 0 || i == 3);
+							cell[v] -= (i <= 1);
+							quad[i] = cellVertex(cell);
+						}
+
+						// Facing +axis when the solid is behind the edge
+						if (solid)
+							mesh.indices.insert(mesh.indices.end(), {quad[0], quad[1], quad[2], quad[0], quad[2], quad[3]});
+						else
+							mesh.indices.insert(mesh.indices.end(), {quad[0], quad[2], quad[1], quad[0], quad[3], quad[2]});
+					}
+				}
+			}
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the settings of the extractor
+	const IsoSurfaceInfo &	IsoSurfaceExtractor::getInfo() const {
+		return _info;
+	}
+
+	/// @brief Return the extraction counters
+	IsoSurfaceStats	IsoSurfaceExtractor::getStats() const {
+		return {
+			_extractedBlocks.load(),
+			_vertices.load(),
+			_triangles.load(),
+			(double)_extractionTime.load() / 1e6
+		};
+	}
+
+	# pragma endregion
+
+} // namespace GE::Utils
@@ -0,0 +1,124 @@
+# pragma once
+
+/// Includes
+# include "ThreadPool.hpp"
+# include "TerrainField.hpp"
+
+/// System includes
+# include <atomic>
+# include <cstdint>
+# include <future>
+# include <memory>
+# include <vector>
+
+/// Dependencies
+# include <glm/glm.hpp>
+
+namespace GE::Utils {
+
+	// Vertex of an isosurface mesh, stored in 24 bytes
+	struct IsoVertex {
+		glm::vec3	position;	// World position
+		glm::vec3	normal;		// Unit length, pointing out of the solid
+	};
+
+	// Indexed triangles, counter-clockwise seen from outside the solid
+	struct IsoMesh {
+		std::vector<IsoVertex>	vertices;
+		std::vector<uint32_t>	indices;
+	};
+
+	using IsoMeshPtr = std::shared_ptr<const IsoMesh>;
+
+	enum class IsoSurfaceMethod : uint8_t {
+		MARCHING_CUBES,		// Vertices on the cell edges, shared by the cells around each edge
+		DUAL_CONTOURING		// One vertex per cell, placed by a QEF : keeps sharp features
+	};
+
+	/// @brief Stores the settings of an IsoSurfaceExtractor
+	struct IsoSurfaceInfo {
+		IsoSurfaceMethod	method        = IsoSurfaceMethod::MARCHING_CUBES;
+		float				isoLevel      = 0.0f;	// Densities above are solid
+		float				sampleSpacing = 1.0f;	// World distance between two samples, as TerrainFieldInfo::sampleSpacing
+		float				qefBias       = 0.05f;	// Dual contouring : pull toward the mean of the crossings, keeps flat areas stable
+		size_t				threadCount   = 0;		// Worker threads, 0 means one per hardware thread minus one
+	};
+
+	/// @brief Extraction counters of an IsoSurfaceExtractor
+	/// @note Throughput per core is extractedBlocks * 1000 / extractionTime blocks per second
+	struct IsoSurfaceStats {
+		size_t	extractedBlocks;
+		size_t	vertices;
+		size_t	triangles;
+		double	extractionTime;	// Milliseconds spent extracting, summed over all workers
+	};
+
+	/**
+	 * @brief Turns 3D density blocks into smooth indexed meshes on a worker pool.
+	 *
+	 * Blocks are independent, so submit() meshes as many of them in parallel as there are workers.
+	 * extract() meshes a block on the calling thread, for callers scheduling their own work.
+	 *
+	 * Vertices are shared : marching cubes creates one vertex per crossed grid edge, reused by the four
+	 * cells around it, and dual contouring one vertex per cell, reused by the quads around it.
+	 *
+	 * Blocks tile seamlessly when neighbors share samples :
+	 *  - marching cubes meshes every cell, blocks need 1 sample of overlap (TerrainFieldInfo::padding = {1, 1, 1})
+	 *  - dual contouring meshes the edges starting from sample 1 to size - 2, blocks need 2 samples of overlap
+	 *
+	 * @note Marching cubes normals come from the density gradient, estimated one-sided on the block faces.
+	 * @note Dual contouring gives a cell crossed by several sheets of surface a single vertex, the mesh
+	 * is then non-manifold there : sample fine enough for the cells to hold one sheet.
+	 * @note All public methods are thread-safe.
+	 */
+	class IsoSurfaceExtractor {
+		public:
+			explicit IsoSurfaceExtractor(const IsoSurfaceInfo &info = {});
+			~IsoSurfaceExtractor();
+
+			IsoSurfaceExtractor(const IsoSurfaceExtractor &) = delete;
+			IsoSurfaceExtractor &operator=(const IsoSurfaceExtractor &) = delete;
+
+			/// Public methods
+
+			std::future<IsoMeshPtr>	submit(TerrainTilePtr tile);
+			void					extract(const float *density, const glm::uvec3 &size, const glm::vec3 &origin, IsoMesh &mesh);
+
+			/// Getters
+
+			const IsoSurfaceInfo &	getInfo() const;
+			IsoSurfaceStats			getStats() const;
+
+		private:
+			// A density block being meshed, values are stored x first, then y, then z
+			struct	Block {
+				const float *	density;
+				glm::ivec3		size;
+				glm::vec3		origin;
+				float			spacing;
+				float			isoLevel;
+
+				float		at(int x, int y, int z) const {
+					return density[((size_t)z * size.y + y) * size.x + x];
+				}
+				bool		solid(int x, int y, int z) const {
+					return at(x, y, z) > isoLevel;
+				}
+				glm::vec3	gradient(int x, int y, int z) const;
+			};
+
+			IsoSurfaceInfo			_info;
+
+			std::atomic<size_t>		_extractedBlocks{0};
+			std::atomic<size_t>		_vertices{0};
+			std::atomic<size_t>		_triangles{0};
+			std::atomic<uint64_t>	_extractionTime{0};	// Nanoseconds
+
+			ThreadPool				_pool;	// Last member, joined first on destruction
+
+			/// Private methods
+
+			void	_marchingCubes(const Block &block, IsoMesh &mesh) const;
+			void	_dualContouring(const Block &block, IsoMesh &mesh) const;
+	};
+} // namespace GE::Utils
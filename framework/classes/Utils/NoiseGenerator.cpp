@@ -1,18 +1,106 @@
 
 #include "NoiseGenerator.hpp"
 
+/// System includes
+# include <algorithm>
+# include <stdexcept>
+# include <string>
+
+# if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#  define GE_NOISE_X86_SIMD
+#  include <immintrin.h>
+# endif
+
 namespace GE::Utils {
 
+	// Gradients of the 3D noises : the 12 cube edges, padded to 16 to index with a mask
+	static const float	gradients3D[16][3] = {
+		{ 1, 1, 0}, {-1, 1, 0}, { 1,-1, 0}, {-1,-1, 0},
+		{ 1, 0, 1}, {-1, 0, 1}, { 1, 0,-1}, {-1, 0,-1},
+		{ 0, 1, 1}, { 0,-1, 1}, { 0, 1,-1}, { 0,-1,-1},
+		{ 1, 1, 0}, {-1, 1, 0}, { 0,-1, 1}, { 0,-1,-1}
+	};
+
+	// Gradients of the 4D simplex noise : the 32 edges of a tesseract
+	static const float	gradients4D[32][4] = {
+		{ 0, 1, 1, 1}, { 0, 1, 1,-1}, { 0, 1,-1, 1}, { 0, 1,-1,-1},
+		{ 0,-1, 1, 1}, { 0,-1, 1,-1}, { 0,-1,-1, 1}, { 0,-1,-1,-1},
+		{ 1, 0, 1, 1}, { 1, 0, 1,-1}, { 1, 0,-1, 1}, { 1, 0,-1,-1},
+		{-1, 0, 1, 1}, {-1, 0, 1,-1}, {-1, 0,-1, 1}, {-1, 0,-1,-1},
+		{ 1, 1, 0, 1}, { 1, 1, 0,-1}, { 1,-1, 0, 1}, { 1,-1, 0,-1},
+		{-1, 1, 0, 1}, {-1, 1, 0,-1}, {-1,-1, 0, 1}, {-1,-1, 0,-1},
+		{ 1, 1, 1, 0}, { 1, 1,-1, 0}, { 1,-1, 1, 0}, { 1,-1,-1, 0},
+		{-1, 1, 1, 0}, {-1, 1,-1, 0}, {-1,-1, 1, 0}, {-1,-1,-1, 0}
+	};
+
+	static inline float	dot3(const float *g, float x, float y, float z)				{ return g[0] * x + g[1] * y + g[2] * z; }
+	static inline float	dot4(const float *g, float x, float y, float z, float w)	{ return g[0] * x + g[1] * y + g[2] * z + g[3] * w; }
+	static inline int	fastFloor(float v)											{ const int i = (int)v; return (v < (float)i) ? i - 1 : i; }
+
 	# pragma region Public methods
 
+	/// @brief Derive the whole generator state from a seed
+	/// @param seed The world seed
+	/// @note The lattice seed is still the 1 + rand() after srand(seed) of the glibc, so old seeds give the old worlds.
+	/// It is computed locally, the permutation table from a SplitMix64 stream : libc rand() state is left untouched.
 	void	NoiseGenerator::setSeed(const uint64_t &seed) {
-		srand(seed);
-		_seed = 1 + rand();
+		uint64_t	state = seed;
+
+		_seed = seed;
+		_latticeSeed = 1 + _legacyRand((uint32_t)seed);
+
+		// Fisher-Yates shuffle of the permutation table
+		for (int i = 0; i < 256; i++)
+			_permutation[i] = i;
+		for (int i = 255; i > 0; i--)
+			std::swap(_permutation[i], _permutation[_splitMix64(state) % (i + 1)]);
+		for (int i = 0; i < 256; i++)
+			_permutation[256 + i] = _permutation[i];
+	}
+
+	/// @brief Select the algorithm used by perlin3D()
+	/// @param mode GRADIENT for true 3D noise, LEGACY_COMPOSITE for the former 6 x perlin2D() blend
+	void	NoiseGenerator::setPerlin3DMode(Perlin3DMode mode) {
+		_perlin3DMode = mode;
+	}
+
+	/// @brief Return the seed given to setSeed()
+	uint64_t	NoiseGenerator::getSeed() const {
+		return _seed;
+	}
+
+	/// @brief Return the algorithm used by perlin3D()
+	NoiseGenerator::Perlin3DMode	NoiseGenerator::getPerlin3DMode() const {
+		return _perlin3DMode;
+	}
+
+	/// @brief Return the permutation table hashing the lattice of the 3D Perlin and Simplex noises
+	/// @note Exposed for ports of the noises, such as OpenCL::NoiseGeneratorCL
+	const std::array<uint8_t, 512> &	NoiseGenerator::getPermutation() const {
+		return _permutation;
+	}
+
+	/// @brief Return the key hashing the lattice gradients of the 2D Perlin noise
+	/// @note Exposed for ports of the noises, such as OpenCL::NoiseGeneratorCL
+	uint32_t	NoiseGenerator::getLatticeSeed() const {
+		return _latticeSeed;
+	}
+
+	/// @brief Return the widest instruction set the batched functions can use on this CPU
+	NoiseGenerator::SIMDLevel	NoiseGenerator::getSupportedSIMDLevel() {
+		# ifdef GE_NOISE_X86_SIMD
+			static const SIMDLevel	level = __builtin_cpu_supports("avx2")   ? SIMDLevel::AVX2
+										  : __builtin_cpu_supports("sse4.1") ? SIMDLevel::SSE41
+										  : SIMDLevel::SCALAR;
+			return level;
+		# else
+			return SIMDLevel::SCALAR;
+		# endif
 	}
 
 	# pragma region Perlin Noise
 
-	float	NoiseGenerator::perlin2D(const glm::vec2 &v) {
+	float	NoiseGenerator::perlin2D(const glm::vec2 &v) const {
 		const glm::ivec2	topLeft     = { v.x    , v.y     };
 		const glm::ivec2	topRight    = { v.x + 1, v.y     };
 		const glm::ivec2	bottomLeft  = { v.x    , v.y + 1 };
@@ -30,31 +118,100 @@ namespace GE::Utils {
 			wVector.y));
 	}
 
-	float	NoiseGenerator::perlin3D(const glm::vec3 &v) {
-		float	ab = perlin2D({v.x, v.y});
-		float	bc = perlin2D({v.y, v.z});
-		float	ac = perlin2D({v.x, v.z});
+	float	NoiseGenerator::perlin3D(const glm::vec3 &v) const {
+		if (_perlin3DMode == Perlin3DMode::LEGACY_COMPOSITE)
+			return _perlin3DComposite(v);
 
-		float	ba = perlin2D({v.y, v.x});
-		float	cb = perlin2D({v.z, v.y});
-		float	ca = perlin2D({v.z, v.x});
+		return _perlin3DGradient(v);
+	}
 
-		float	abc = ab + bc + ac + ba + cb + ca;
-		return (abc / 6.0f);
+	/// @brief Fill a strided grid with 2D Perlin noise
+	/// @param out The destination grid, row y starts at out + y * stride
+	/// @param origin The noise coordinates of the first sample
+	/// @param step The distance between two samples on each axis
+	/// @param count The number of samples on each axis
+	/// @param stride The number of floats between two rows, 0 means count.x
+	/// @param level The instruction set to use, clamped to what the CPU supports
+	/// @throw std::invalid_argument if stride is smaller than count.x
+	/// @note Gives the same values as calling perlin2D() on each sample, but computes every lattice gradient only once.
+	/// @note Results are bit-exact with perlin2D() unless fast-math lets the compiler reorder the scalar path (error < 1e-4).
+	void	NoiseGenerator::perlin2DGrid(float *out, const glm::vec2 &origin, const glm::vec2 &step, const glm::uvec2 &count, size_t stride, SIMDLevel level) const {
+		if (!out || !count.x || !count.y)
+			return;
+
+		if (!stride)
+			stride = count.x;
+		else if (stride < count.x)
+			throw std::invalid_argument("NoiseGenerator: Grid stride (" + std::to_string(stride) +
+										") is smaller than the row length (" + std::to_string(count.x) + ")");
+
+		const SIMDLevel	supported = getSupportedSIMDLevel();
+		if (level == SIMDLevel::AUTO || level > supported)
+			level = supported;
+
+		// Lattice columns touched by a row, padded to absorb the rounding of (x + 1)
+		const float		lastX    = origin.x + (float)(count.x - 1) * step.x;
+		const int		latticeX = (int)std::min(origin.x, lastX) - 1;
+		const size_t	span     = (size_t)((int)std::max(origin.x, lastX) - latticeX) + 3;
+
+		// Samples more than a cell apart share no gradient, evaluate them one by one
+		if (span > 2 * (size_t)count.x + 4) {
+			for (size_t y = 0; y < count.y; y++)
+				for (size_t x = 0; x < count.x; x++)
+					out[y * stride + x] = perlin2D({origin.x + (float)x * step.x, origin.y + (float)y * step.y});
+			return;
+		}
+
+		std::vector<float>	gradients(span * 4);
+		float *	gx0 = gradients.data();
+		float *	gy0 = gx0 + span;
+		float *	gx1 = gy0 + span;
+		float *	gy1 = gx1 + span;
+		int		cachedY0 = 0;
+		int		cachedY1 = 0;
+		bool	cached = false;
+
+		for (size_t y = 0; y < count.y; y++) {
+			const float	py  = origin.y + (float)y * step.y;
+			const int	iy0 = (int)py;
+			const int	iy1 = (int)(py + 1);
+
+			// Rows inside the same lattice cell reuse the gradients of the previous row
+			if (!cached || iy0 != cachedY0 || iy1 != cachedY1) {
+				if (cached && iy0 == cachedY1) {
+					std::swap(gx0, gx1);
+					std::swap(gy0, gy1);
+				}
+				else
+					_perlin2DFillGradients(gx0, gy0, latticeX, span, iy0);
+
+				_perlin2DFillGradients(gx1, gy1, latticeX, span, iy1);
+				cachedY0 = iy0;
+				cachedY1 = iy1;
+				cached = true;
+			}
+
+			const Perlin2DRow	row = { out + y * stride, count.x, origin.x, step.x, py, latticeX, gx0, gy0, gx1, gy1 };
+			switch (level) {
+				case SIMDLevel::AVX2:	_perlin2DRowAVX2(row);		break;
+				case SIMDLevel::SSE41:	_perlin2DRowSSE41(row);		break;
+				default:				_perlin2DRowScalar(row, 0);	break;
+			}
+		}
 	}
 
-	inline float	NoiseGenerator::_perlin2DDot(const glm::ivec2 &v1, const glm::vec2 &v2) {
+	inline float	NoiseGenerator::_perlin2DDot(const glm::ivec2 &v1, const glm::vec2 &v2) const {
 		return (glm::dot(glm::vec2{v2.x - (float)v1.x, v2.y - (float)v1.y}, _perlin2DRandomGradiant(v1)));
 	}
 
-	inline float	NoiseGenerator::_perlin2DCubInterpol(const glm::vec2 &v, const float &weight) {
+	inline float	NoiseGenerator::_perlin2DCubInterpol(const glm::vec2 &v, const float &weight) const {
 		return ((v.y - v.x) * (3.0f - weight * 2.0f) * weight * weight + v.x);
 	}
 
-	glm::vec2	NoiseGenerator::_perlin2DRandomGradiant(const glm::ivec2 &v) {
+	glm::vec2	NoiseGenerator::_perlin2DRandomGradiant(const glm::ivec2 &v) const {
 		const unsigned int	w = 8 * sizeof(unsigned);
 		const unsigned int	s = w / 2; 
-		unsigned int		a = v.x + _seed, b = v.y + _seed;
+		unsigned int		a = v.x + _latticeSeed, b = v.y + _latticeSeed;
 		
 		a *= 3284157443;
 	
@@ -68,6 +225,567 @@ namespace GE::Utils {
 		return  glm::vec2{sin(random), cos(random)};
 	}
 
+	// Improved Perlin noise : quintic fade, hashed lattice corners, gradients from gradients3D
+	float	NoiseGenerator::_perlin3DGradient(const glm::vec3 &v) const {
+		const int	fx = fastFloor(v.x), fy = fastFloor(v.y), fz = fastFloor(v.z);
+		const int	X = fx & 255, Y = fy & 255, Z = fz & 255;
+		const float	x = v.x - (float)fx, y = v.y - (float)fy, z = v.z - (float)fz;
+
+		const auto	fade = [](float t) { return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); };
+		const auto	lerp = [](float a, float b, float t) { return a + t * (b - a); };
+		const float	u = fade(x), w = fade(y), s = fade(z);
+
+		const uint8_t *	p = _permutation.data();
+		const int	A  = p[X] + Y,     B  = p[X + 1] + Y;
+		const int	AA = p[A] + Z,     AB = p[A + 1] + Z;
+		const int	BA = p[B] + Z,     BB = p[B + 1] + Z;
+
+		return lerp(
+			lerp(
+				lerp(dot3(gradients3D[p[AA] & 15], x, y, z),        dot3(gradients3D[p[BA] & 15], x - 1, y, z), u),
+				lerp(dot3(gradients3D[p[AB] & 15], x, y - 1, z),    dot3(gradients3D[p[BB] & 15], x - 1, y - 1, z), u),
+			w),
+			lerp(
+				lerp(dot3(gradients3D[p[AA + 1] & 15], x, y, z - 1),     dot3(gradients3D[p[BA + 1] & 15], x - 1, y, z - 1), u),
+				lerp(dot3(gradients3D[p[AB + 1] & 15], x, y - 1, z - 1), dot3(gradients3D[p[BB + 1] & 15], x - 1, y - 1, z - 1), u),
+			w),
+		s);
+	}
+
+	// Former perlin3D() : average of perlin2D() over the six ordered axis pairs
+	float	NoiseGenerator::_perlin3DComposite(const glm::vec3 &v) const {
+		float	ab = perlin2D({v.x, v.y});
+		float	bc = perlin2D({v.y, v.z});
+		float	ac = perlin2D({v.x, v.z});
+
+		float	ba = perlin2D({v.y, v.x});
+		float	cb = perlin2D({v.z, v.y});
+		float	ca = perlin2D({v.z, v.x});
+
+		float	abc = ab + bc + ac + ba + cb + ca;
+		return (abc / 6.0f);
+	}
+
+	// First rand() after srand(seed) of the glibc : its TYPE_3 additive feedback generator, as in random_r()
+	uint32_t	NoiseGenerator::_legacyRand(uint32_t seed) {
+		// r[0 .. 30] from a Lehmer generator, then r[i] = r[i - 31] + r[i - 3] : rand() returns r[i] >> 1 from i = 344
+		uint32_t	r[345];
+
+		r[0] = seed ? seed : 1;
+		for (int i = 1; i < 31; i++) {
+			const int64_t	previous = (int32_t)r[i - 1];
+			int64_t			word = 16807 * (previous % 127773) - 2836 * (previous / 127773);
+
+			if (word < 0)
+				word += 2147483647;
+			r[i] = (uint32_t)word;
+		}
+		for (int i = 31; i < 34; i++)
+			r[i] = r[i - 31];
+		for (int i = 34; i < 345; i++)
+			r[i] = r[i - 31] + r[i - 3];
+		return r[344] >> 1;
+	}
+
+	// SplitMix64 step, used to shuffle the permutation table
+	uint64_t	NoiseGenerator::_splitMix64(uint64_t &state) {
+		uint64_t	z = (state += 0x9E3779B97F4A7C15ull);
+
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	// Compute the gradients of span consecutive lattice points of a lattice row
+	void	NoiseGenerator::_perlin2DFillGradients(float *gx, float *gy, int latticeX, size_t span, int latticeY) const {
+		for (size_t i = 0; i < span; i++) {
+			const glm::vec2	gradient = _perlin2DRandomGradiant({latticeX + (int)i, latticeY});
+
+			gx[i] = gradient.x;
+			gy[i] = gradient.y;
+		}
+	}
+
+	// Reference row kernel, also handles the tail of the SIMD kernels
+	// Mirrors perlin2D() operation by operation, lattice corners included
+	void	NoiseGenerator::_perlin2DRowScalar(const Perlin2DRow &row, size_t begin) {
+		const auto	interpol = [](float a, float b, float weight) {
+			return ((b - a) * (3.0f - weight * 2.0f) * weight * weight + a);
+		};
+
+		const float	dy0 = row.y - (float)(int)row.y;
+		const float	dy1 = row.y - (float)(int)(row.y + 1);
+
+		for (size_t i = begin; i < row.count; i++) {
+			const float	x   = row.originX + (float)i * row.stepX;
+			const int	ix0 = (int)x;
+			const int	ix1 = (int)(x + 1);
+			const float	dx0 = x - (float)ix0;
+			const float	dx1 = x - (float)ix1;
+			const int	k0  = ix0 - row.latticeX;
+			const int	k1  = ix1 - row.latticeX;
+
+			const float	n00 = dx0 * row.gx0[k0] + dy0 * row.gy0[k0];
+			const float	n10 = dx1 * row.gx0[k1] + dy0 * row.gy0[k1];
+			const float	n01 = dx0 * row.gx1[k0] + dy1 * row.gy1[k0];
+			const float	n11 = dx1 * row.gx1[k1] + dy1 * row.gy1[k1];
+
+			row.out[i] = interpol(interpol(n00, n10, dx0), interpol(n01, n11, dx0), dy0);
+		}
+	}
+
+	# ifdef GE_NOISE_X86_SIMD
+
+	__attribute__((target("sse4.1")))
+	static inline __m128	_interpolSSE41(__m128 a, __m128 b, __m128 weight) {
+		const __m128	t = _mm_mul_ps(_mm_sub_ps(b, a), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(weight, _mm_set1_ps(2.0f))));
+		return _mm_add_ps(_mm_mul_ps(_mm_mul_ps(t, weight), weight), a);
+	}
+
+	__attribute__((target("sse4.1")))
+	static inline __m128	_gatherSSE41(const float *table, __m128i index) {
+		return _mm_setr_ps(
+			table[_mm_extract_epi32(index, 0)], table[_mm_extract_epi32(index, 1)],
+			table[_mm_extract_epi32(index, 2)], table[_mm_extract_epi32(index, 3)]
+		);
+	}
+
+	// 4 samples per iteration, gradients are read back from the shared lattice rows
+	__attribute__((target("sse4.1")))
+	void	NoiseGenerator::_perlin2DRowSSE41(const Perlin2DRow &row) {
+		const size_t	vectorCount = row.count & ~(size_t)3;
+		const __m128	lane     = _mm_setr_ps(0, 1, 2, 3);
+		const __m128	one      = _mm_set1_ps(1.0f);
+		const __m128	originX  = _mm_set1_ps(row.originX);
+		const __m128	stepX    = _mm_set1_ps(row.stepX);
+		const __m128i	latticeX = _mm_set1_epi32(row.latticeX);
+		const __m128	dy0      = _mm_set1_ps(row.y - (float)(int)row.y);
+		const __m128	dy1      = _mm_set1_ps(row.y - (float)(int)(row.y + 1));
+
+		for (size_t i = 0; i < vectorCount; i += 4) {
+			const __m128	x   = _mm_add_ps(originX, _mm_mul_ps(_mm_add_ps(_mm_set1_ps((float)i), lane), stepX));
+			const __m128i	ix0 = _mm_cvttps_epi32(x);
+			const __m128i	ix1 = _mm_cvttps_epi32(_mm_add_ps(x, one));
+			const __m128	dx0 = _mm_sub_ps(x, _mm_cvtepi32_ps(ix0));
+			const __m128	dx1 = _mm_sub_ps(x, _mm_cvtepi32_ps(ix1));
+			const __m128i	k0  = _mm_sub_epi32(ix0, latticeX);
+			const __m128i	k1  = _mm_sub_epi32(ix1, latticeX);
+
+			const __m128	n00 = _mm_add_ps(_mm_mul_ps(dx0, _gatherSSE41(row.gx0, k0)), _mm_mul_ps(dy0, _gatherSSE41(row.gy0, k0)));
+			const __m128	n10 = _mm_add_ps(_mm_mul_ps(dx1, _gatherSSE41(row.gx0, k1)), _mm_mul_ps(dy0, _gatherSSE41(row.gy0, k1)));
+			const __m128	n01 = _mm_add_ps(_mm_mul_ps(dx0, _gatherSSE41(row.gx1, k0)), _mm_mul_ps(dy1, _gatherSSE41(row.gy1, k0)));
+			const __m128	n11 = _mm_add_ps(_mm_mul_ps(dx1, _gatherSSE41(row.gx1, k1)), _mm_mul_ps(dy1, _gatherSSE41(row.gy1, k1)));
+
+			_mm_storeu_ps(row.out + i, _interpolSSE41(_interpolSSE41(n00, n10, dx0), _interpolSSE41(n01, n11, dx0), dy0));
+		}
+
+		_perlin2DRowScalar(row, vectorCount);
+	}
+
+	__attribute__((target("avx2")))
+	static inline __m256	_interpolAVX2(__m256 a, __m256 b, __m256 weight) {
+		const __m256	t = _mm256_mul_ps(_mm256_sub_ps(b, a), _mm256_sub_ps(_mm256_set1_ps(3.0f), _mm256_mul_ps(weight, _mm256_set1_ps(2.0f))));
+		return _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(t, weight), weight), a);
+	}
+
+	// 8 samples per iteration, gradients are gathered from the shared lattice rows
+	__attribute__((target("avx2")))
+	void	NoiseGenerator::_perlin2DRowAVX2(const Perlin2DRow &row) {
+		const size_t	vectorCount = row.count & ~(size_t)7;
+		const __m256	lane     = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+		const __m256	one      = _mm256_set1_ps(1.0f);
+		const __m256	originX  = _mm256_set1_ps(row.originX);
+		const __m256	stepX    = _mm256_set1_ps(row.stepX);
+		const __m256i	latticeX = _mm256_set1_epi32(row.latticeX);
+		const __m256	dy0      = _mm256_set1_ps(row.y - (float)(int)row.y);
+		const __m256	dy1      = _mm256_set1_ps(row.y - (float)(int)(row.y + 1));
+
+		for (size_t i = 0; i < vectorCount; i += 8) {
+			const __m256	x   = _mm256_add_ps(originX, _mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps((float)i), lane), stepX));
+			const __m256i	ix0 = _mm256_cvttps_epi32(x);
+			const __m256i	ix1 = _mm256_cvttps_epi32(_mm256_add_ps(x, one));
+			const __m256	dx0 = _mm256_sub_ps(x, _mm256_cvtepi32_ps(ix0));
+			const __m256	dx1 = _mm256_sub_ps(x, _mm256_cvtepi32_ps(ix1));
+			const __m256i	k0  = _mm256_sub_epi32(ix0, latticeX);
+			const __m256i	k1  = _mm256_sub_epi32(ix1, latticeX);
+
+			const __m256	n00 = _mm256_add_ps(_mm256_mul_ps(dx0, _mm256_i32gather_ps(row.gx0, k0, 4)), _mm256_mul_ps(dy0, _mm256_i32gather_ps(row.gy0, k0, 4)));
+			const __m256	n10 = _mm256_add_ps(_mm256_mul_ps(dx1, _mm256_i32gather_ps(row.gx0, k1, 4)), _mm256_mul_ps(dy0, _mm256_i32gather_ps(row.gy0, k1, 4)));
+			const __m256	n01 = _mm256_add_ps(_mm256_mul_ps(dx0, _mm256_i32gather_ps(row.gx1, k0, 4)), _mm256_mul_ps(dy1, _mm256_i32gather_ps(row.gy1, k0, 4)));
+			const __m256	n11 = _mm256_add_ps(_mm256_mul_ps(dx1, _mm256_i32gather_ps(row.gx1, k1, 4)), _mm256_mul_ps(dy1, _mm256_i32gather_ps(row.gy1, k1, 4)));
+
+			_mm256_storeu_ps(row.out + i, _interpolAVX2(_interpolAVX2(n00, n10, dx0), _interpolAVX2(n01, n11, dx0), dy0));
+		}
+
+		_perlin2DRowScalar(row, vectorCount);
+	}
+
+	# else
+
+	void	NoiseGenerator::_perlin2DRowSSE41(const Perlin2DRow &row)	{ _perlin2DRowScalar(row, 0); }
+	void	NoiseGenerator::_perlin2DRowAVX2(const Perlin2DRow &row)	{ _perlin2DRowScalar(row, 0); }
+
+	# endif
+
+	# pragma endregion
+
+	# pragma region Simplex Noise
+
+	/// @brief 2D Simplex noise
+	/// @return A value in about [-1, 1]
+	float	NoiseGenerator::simplex2D(const glm::vec2 &v) const {
+		const float	F2 = 0.36602540378f;	// (sqrt(3) - 1) / 2
+		const float	G2 = 0.21132486540f;	// (3 - sqrt(3)) / 6
+
+		// Skew to find the simplex cell, then unskew the cell origin
+		const float	s = (v.x + v.y) * F2;
+		const int	i = fastFloor(v.x + s);
+		const int	j = fastFloor(v.y + s);
+		const float	t = (float)(i + j) * G2;
+		const float	x0 = v.x - ((float)i - t);
+		const float	y0 = v.y - ((float)j - t);
+
+		// Middle corner of the triangle
+		const int	i1 = x0 > y0 ? 1 : 0;
+		const int	j1 = 1 - i1;
+
+		const float	x1 = x0 - (float)i1 + G2,		y1 = y0 - (float)j1 + G2;
+		const float	x2 = x0 - 1.0f + 2.0f * G2,		y2 = y0 - 1.0f + 2.0f * G2;
+
+		const uint8_t *	p = _permutation.data();
+		const int	ii = i & 255, jj = j & 255;
+		const float	*g0 = gradients3D[p[ii + p[jj]] & 15];
+		const float	*g1 = gradients3D[p[ii + i1 + p[jj + j1]] & 15];
+		const float	*g2 = gradients3D[p[ii + 1 + p[jj + 1]] & 15];
+
+		const auto	corner = [](const float *g, float x, float y) {
+			float	t = 0.5f - x * x - y * y;
+			if (t < 0)
+				return 0.0f;
+			t *= t;
+			return t * t * (g[0] * x + g[1] * y);
+		};
+
+		return 70.0f * (corner(g0, x0, y0) + corner(g1, x1, y1) + corner(g2, x2, y2));
+	}
+
+	/// @brief 3D Simplex noise
+	/// @return A value in about [-1, 1]
+	float	NoiseGenerator::simplex3D(const glm::vec3 &v) const {
+		const float	F3 = 1.0f / 3.0f;
+		const float	G3 = 1.0f / 6.0f;
+
+		const float	s = (v.x + v.y + v.z) * F3;
+		const int	i = fastFloor(v.x + s);
+		const int	j = fastFloor(v.y + s);
+		const int	k = fastFloor(v.z + s);
+		const float	t = (float)(i + j + k) * G3;
+		const float	x0 = v.x - ((float)i - t);
+		const float	y0 = v.y - ((float)j - t);
+		const float	z0 = v.z - ((float)k - t);
+
+		// Second and third corners of the tetrahedron, from the order of the coordinates
+		int	i1, j1, k1, i2, j2, k2;
+		if (x0 >= y0) {
+			if (y0 >= z0)		{ i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+			else if (x0 >= z0)	{ i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 0; k2 = 1; }
+			else				{ i1 = 0; j1 = 0; k1 = 1; i2 = 1; j2 = 0; k2 = 1; }
+		}
+		else {
+			if (y0 < z0)		{ i1 = 0; j1 = 0; k1 = 1; i2 = 0; j2 = 1; k2 = 1; }
+			else if (x0 < z0)	{ i1 = 0; j1 = 1; k1 = 0; i2 = 0; j2 = 1; k2 = 1; }
+			else				{ i1 = 0; j1 = 1; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+		}
+
+		const float	x1 = x0 - (float)i1 + G3,			y1 = y0 - (float)j1 + G3,			z1 = z0 - (float)k1 + G3;
+		const float	x2 = x0 - (float)i2 + 2.0f * G3,	y2 = y0 - (float)j2 + 2.0f * G3,	z2 = z0 - (float)k2 + 2.0f * G3;
+		const float	x3 = x0 - 1.0f + 3.0f * G3,			y3 = y0 - 1.0f + 3.0f * G3,			z3 = z0 - 1.0f + 3.0f * G3;
+
+		const uint8_t *	p = _permutation.data();
+		const int	ii = i & 255, jj = j & 255, kk = k & 255;
+		const float	*g0 = gradients3D[p[ii + p[jj + p[kk]]] & 15];
+		const float	*g1 = gradients3D[p[ii + i1 + p[jj + j1 + p[kk + k1]]] & 15];
+		const float	*g2 = gradients3D[p[ii + i2 + p[jj + j2 + p[kk + k2]]] & 15];
+		const float	*g3 = gradients3D[p[ii + 1 + p[jj + 1 + p[kk + 1]]] & 15];
+
+		const auto	corner = [](const float *g, float x, float y, float z) {
+			float	t = 0.5f - x * x - y * y - z * z;
+			if (t < 0)
+				return 0.0f;
+			t *= t;
+			return t * t * dot3(g, x, y, z);
+		};
+
+		return 76.0f * (corner(g0, x0, y0, z0) + corner(g1, x1, y1, z1) + corner(g2, x2, y2, z2) + corner(g3, x3, y3, z3));
+	}
+
+	/// @brief 4D Simplex noise
+	/// @return A value in about [-1, 1]
+	/// @note Useful for animated 3D fields (w as time) or seamless 2D tiling
+	float	NoiseGenerator::simplex4D(const glm::vec4 &v) const {
+		const float	F4 = 0.30901699437f;	// (sqrt(5) - 1) / 4
+		const float	G4 = 0.13819660113f;	// (5 - sqrt(5)) / 20
+
+		const float	s = (v.x + v.y + v.z + v.w) * F4;
+		const int	i = fastFloor(v.x + s);
+		const int	j = fastFloor(v.y + s);
+		const int	k = fastFloor(v.z + s);
+		const int	l = fastFloor(v.w + s);
+		const float	t = (float)(i + j + k + l) * G4;
+		const float	x0 = v.x - ((float)i - t);
+		const float	y0 = v.y - ((float)j - t);
+		const float	z0 = v.z - ((float)k - t);
+		const float	w0 = v.w - ((float)l - t);
+
+		// Rank the coordinates to find which simplex of the hypercube holds the point
+		int	rankX = 0, rankY = 0, rankZ = 0, rankW = 0;
+		(x0 > y0) ? rankX++ : rankY++;
+		(x0 > z0) ? rankX++ : rankZ++;
+		(x0 > w0) ? rankX++ : rankW++;
+		(y0 > z0) ? rankY++ : rankZ++;
+		(y0 > w0) ? rankY++ : rankW++;
+		(z0 > w0) ? rankZ++ : rankW++;
+
+		const int	i1 = rankX >= 3, j1 = rankY >= 3, k1 = rankZ >= 3, l1 = rankW >= 3;
+		const int	i2 = rankX >= 2, j2 = rankY >= 2, k2 = rankZ >= 2, l2 = rankW >= 2;
+		const int	i3 = rankX >= 1, j3 = rankY >= 1, k3 = rankZ >= 1, l3 = rankW >= 1;
+
+		const float	x1 = x0 - (float)i1 + G4,			y1 = y0 - (float)j1 + G4,			z1 = z0 - (float)k1 + G4,			w1 = w0 - (float)l1 + G4;
+		const float	x2 = x0 - (float)i2 + 2.0f * G4,	y2 = y0 - (float)j2 + 2.0f * G4,	z2 = z0 - (float)k2 + 2.0f * G4,	w2 = w0 - (float)l2 + 2.0f * G4;
+		const float	x3 = x0 - (float)i3 + 3.0f * G4,	y3 = y0 - (float)j3 + 3.0f * G4,	z3 = z0 - (float)k3 + 3.0f * G4,	w3 = w0 - (float)l3 + 3.0f * G4;
+		const float	x4 = x0 - 1.0f + 4.0f * G4,			y4 = y0 - 1.0f + 4.0f * G4,			z4 = z0 - 1.0f + 4.0f * G4,			w4 = w0 - 1.0f + 4.0f * G4;
+
+		const uint8_t *	p = _permutation.data();
+		const int	ii = i & 255, jj = j & 255, kk = k & 255, ll = l & 255;
+		const float	*g0 = gradients4D[p[ii + p[jj + p[kk + p[ll]]]] & 31];
+		const float	*g1 = gradients4D[p[ii + i1 + p[jj + j1 + p[kk + k1 + p[ll + l1]]]] & 31];
+		const float	*g2 = gradients4D[p[ii + i2 + p[jj + j2 + p[kk + k2 + p[ll + l2]]]] & 31];
+		const float	*g3 = gradients4D[p[ii + i3 + p[jj + j3 + p[kk + k3 + p[ll + l3]]]] & 31];
+		const float	*g4 = gradients4D[p[ii + 1 + p[jj + 1 + p[kk + 1 + p[ll + 1]]]] & 31];
+
+		const auto	corner = [](const float *g, float x, float y, float z, float w) {
+			float	t = 0.5f - x * x - y * y - z * z - w * w;
+			if (t < 0)
+				return 0.0f;
+			t *= t;
+			return t * t * dot4(g, x, y, z, w);
+		};
+
+		return 62.0f * (corner(g0, x0, y0, z0, w0) + corner(g1, x1, y1, z1, w1) + corner(g2, x2, y2, z2, w2)
+					  + corner(g3, x3, y3, z3, w3) + corner(g4, x4, y4, z4, w4));
+	}
+
+	# pragma endregion
+
+	# pragma region Analytic derivatives
+
+	/// @brief 2D Perlin noise and its gradient in a single evaluation
+	/// @return x = perlin2D(v), yz = gradient of perlin2D at v
+	glm::vec3	NoiseGenerator::perlin2DDerivative(const glm::vec2 &v) const {
+		const glm::ivec2	topLeft     = { v.x    , v.y     };
+		const glm::ivec2	topRight    = { v.x + 1, v.y     };
+		const glm::ivec2	bottomLeft  = { v.x    , v.y + 1 };
+		const glm::ivec2	bottomRight = { v.x + 1, v.y + 1 };
+		const glm::vec2		w           = { v.x - topLeft.x, v.y - topLeft.y };
+
+		// Each corner is dot(v - corner, gradient), so its own gradient is the corner gradient
+		const glm::vec2	g00 = _perlin2DRandomGradiant(topLeft);
+		const glm::vec2	g10 = _perlin2DRandomGradiant(topRight);
+		const glm::vec2	g01 = _perlin2DRandomGradiant(bottomLeft);
+		const glm::vec2	g11 = _perlin2DRandomGradiant(bottomRight);
+		const auto		cornerDot = [&v](const glm::ivec2 &corner, const glm::vec2 &gradient) {
+			return glm::dot(glm::vec2{v.x - (float)corner.x, v.y - (float)corner.y}, gradient);
+		};
+		const float		n00 = cornerDot(topLeft, g00);
+		const float		n10 = cornerDot(topRight, g10);
+		const float		n01 = cornerDot(bottomLeft, g01);
+		const float		n11 = cornerDot(bottomRight, g11);
+
+		// Cubic interpolant s(w) = 3w^2 - 2w^3 and its derivative
+		const glm::vec2	s  = { w.x * w.x * (3.0f - 2.0f * w.x), w.y * w.y * (3.0f - 2.0f * w.y) };
+		const glm::vec2	ds = { 6.0f * w.x * (1.0f - w.x), 6.0f * w.y * (1.0f - w.y) };
+
+		const float		top    = _perlin2DCubInterpol({n00, n10}, w.x);
+		const float		bottom = _perlin2DCubInterpol({n01, n11}, w.x);
+		const glm::vec2	dTop    = g00 + (g10 - g00) * s.x + glm::vec2{(n10 - n00) * ds.x, 0};
+		const glm::vec2	dBottom = g01 + (g11 - g01) * s.x + glm::vec2{(n11 - n01) * ds.x, 0};
+
+		return {
+			_perlin2DCubInterpol({top, bottom}, w.y),
+			dTop + (dBottom - dTop) * s.y + glm::vec2{0, (bottom - top) * ds.y}
+		};
+	}
+
+	/// @brief 3D Perlin noise and its gradient in a single evaluation
+	/// @return x = perlin3D(v), yzw = gradient of perlin3D at v
+	/// @note Follows the Perlin3DMode of the generator
+	glm::vec4	NoiseGenerator::perlin3DDerivative(const glm::vec3 &v) const {
+		if (_perlin3DMode == Perlin3DMode::LEGACY_COMPOSITE)
+			return _perlin3DCompositeDerivative(v);
+
+		return _perlin3DGradientDerivative(v);
+	}
+
+	/// @brief 2D Simplex noise and its gradient in a single evaluation
+	/// @return x = simplex2D(v), yz = gradient of simplex2D at v
+	glm::vec3	NoiseGenerator::simplex2DDerivative(const glm::vec2 &v) const {
+		const float	F2 = 0.36602540378f;
+		const float	G2 = 0.21132486540f;
+
+		const float	s = (v.x + v.y) * F2;
+		const int	i = fastFloor(v.x + s);
+		const int	j = fastFloor(v.y + s);
+		const float	t = (float)(i + j) * G2;
+		const float	x0 = v.x - ((float)i - t);
+		const float	y0 = v.y - ((float)j - t);
+
+		const int	i1 = x0 > y0 ? 1 : 0;
+		const int	j1 = 1 - i1;
+
+		const float	x1 = x0 - (float)i1 + G2,		y1 = y0 - (float)j1 + G2;
+		const float	x2 = x0 - 1.0f + 2.0f * G2,		y2 = y0 - 1.0f + 2.0f * G2;
+
+		const uint8_t *	p = _permutation.data();
+		const int	ii = i & 255, jj = j & 255;
+
+		// d(t^4 * dot(g, d)) = t^4 * g - 8 * t^3 * dot(g, d) * d, with t = 0.5 - |d|^2
+		glm::vec3	result = {0, 0, 0};
+		const auto	corner = [&result](const float *g, float x, float y) {
+			const float	t = 0.5f - x * x - y * y;
+			if (t < 0)
+				return;
+
+			const float	t2 = t * t, t4 = t2 * t2;
+			const float	gd = g[0] * x + g[1] * y;
+
+			result.x += t4 * gd;
+			result.y += t4 * g[0] - 8.0f * t2 * t * gd * x;
+			result.z += t4 * g[1] - 8.0f * t2 * t * gd * y;
+		};
+
+		corner(gradients3D[p[ii + p[jj]] & 15], x0, y0);
+		corner(gradients3D[p[ii + i1 + p[jj + j1]] & 15], x1, y1);
+		corner(gradients3D[p[ii + 1 + p[jj + 1]] & 15], x2, y2);
+
+		return result * 70.0f;
+	}
+
+	/// @brief 3D Simplex noise and its gradient in a single evaluation
+	/// @return x = simplex3D(v), yzw = gradient of simplex3D at v
+	glm::vec4	NoiseGenerator::simplex3DDerivative(const glm::vec3 &v) const {
+		const float	F3 = 1.0f / 3.0f;
+		const float	G3 = 1.0f / 6.0f;
+
+		const float	s = (v.x + v.y + v.z) * F3;
+		const int	i = fastFloor(v.x + s);
+		const int	j = fastFloor(v.y + s);
+		const int	k = fastFloor(v.z + s);
+		const float	t = (float)(i + j + k) * G3;
+		const float	x0 = v.x - ((float)i - t);
+		const float	y0 = v.y - ((float)j - t);
+		const float	z0 = v.z - ((float)k - t);
+
+		int	i1, j1, k1, i2, j2, k2;
+		if (x0 >= y0) {
+			if (y0 >= z0)		{ i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+			else if (x0 >= z0)	{ i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 0; k2 = 1; }
+			else				{ i1 = 0; j1 = 0; k1 = 1; i2 = 1; j2 = 0; k2 = 1; }
+		}
+		else {
+			if (y0 < z0)		{ i1 = 0; j1 = 0; k1 = 1; i2 = 0; j2 = 1; k2 = 1; }
+			else if (x0 < z0)	{ i1 = 0; j1 = 1; k1 = 0; i2 = 0; j2 = 1; k2 = 1; }
+			else				{ i1 = 0; j1 = 1; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+		}
+
+		const float	x1 = x0 - (float)i1 + G3,			y1 = y0 - (float)j1 + G3,			z1 = z0 - (float)k1 + G3;
+		const float	x2 = x0 - (float)i2 + 2.0f * G3,	y2 = y0 - (float)j2 + 2.0f * G3,	z2 = z0 - (float)k2 + 2.0f * G3;
+		const float	x3 = x0 - 1.0f + 3.0f * G3,			y3 = y0 - 1.0f + 3.0f * G3,			z3 = z0 - 1.0f + 3.0f * G3;
+
+		const uint8_t *	p = _permutation.data();
+		const int	ii = i & 255, jj = j & 255, kk = k & 255;
+
+		// d(t^4 * dot(g, d)) = t^4 * g - 8 * t^3 * dot(g, d) * d, with t = 0.5 - |d|^2
+		glm::vec4	result = {0, 0, 0, 0};
+		const auto	corner = [&result](const float *g, float x, float y, float z) {
+			const float	t = 0.5f - x * x - y * y - z * z;
+			if (t < 0)
+				return;
+
+			const float	t2 = t * t, t4 = t2 * t2;
+			const float	gd = dot3(g, x, y, z);
+
+			result.x += t4 * gd;
+			result.y += t4 * g[0] - 8.0f * t2 * t * gd * x;
+			result.z += t4 * g[1] - 8.0f * t2 * t * gd * y;
+			result.w += t4 * g[2] - 8.0f * t2 * t * gd * z;
+		};
+
+		corner(gradients3D[p[ii + p[jj + p[kk]]] & 15], x0, y0, z0);
+		corner(gradients3D[p[ii + i1 + p[jj + j1 + p[kk + k1]]] & 15], x1, y1, z1);
+		corner(gradients3D[p[ii + i2 + p[jj + j2 + p[kk + k2]]] & 15], x2, y2, z2);
+		corner(gradients3D[p[ii + 1 + p[jj + 1 + p[kk + 1]]] & 15], x3, y3, z3);
+
+		return result * 76.0f;
+	}
+
+	// Derivative of _perlin3DGradient(), every lerp carries (value, gradient)
+	glm::vec4	NoiseGenerator::_perlin3DGradientDerivative(const glm::vec3 &v) const {
+		const int	fx = fastFloor(v.x), fy = fastFloor(v.y), fz = fastFloor(v.z);
+		const int	X = fx & 255, Y = fy & 255, Z = fz & 255;
+		const float	x = v.x - (float)fx, y = v.y - (float)fy, z = v.z - (float)fz;
+
+		const auto	fade  = [](float t) { return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); };
+		const auto	dfade = [](float t) { return 30.0f * t * t * (t * (t - 2.0f) + 1.0f); };
+		const glm::vec3	f  = { fade(x), fade(y), fade(z) };
+		const glm::vec3	df = { dfade(x), dfade(y), dfade(z) };
+
+		// lerp(a, b, f[axis]) on (value, gradient) pairs
+		const auto	lerp = [&f, &df](const glm::vec4 &a, const glm::vec4 &b, int axis) {
+			glm::vec4	r = a + (b - a) * f[axis];
+			r[axis + 1] += (b.x - a.x) * df[axis];
+			return r;
+		};
+		const auto	corner = [](int hash, float x, float y, float z) {
+			const float	*g = gradients3D[hash & 15];
+			return glm::vec4{dot3(g, x, y, z), g[0], g[1], g[2]};
+		};
+
+		const uint8_t *	p = _permutation.data();
+		const int	A  = p[X] + Y,     B  = p[X + 1] + Y;
+		const int	AA = p[A] + Z,     AB = p[A + 1] + Z;
+		const int	BA = p[B] + Z,     BB = p[B + 1] + Z;
+
+		return lerp(
+			lerp(
+				lerp(corner(p[AA], x, y, z),        corner(p[BA], x - 1, y, z), 0),
+				lerp(corner(p[AB], x, y - 1, z),    corner(p[BB], x - 1, y - 1, z), 0),
+			1),
+			lerp(
+				lerp(corner(p[AA + 1], x, y, z - 1),     corner(p[BA + 1], x - 1, y, z - 1), 0),
+				lerp(corner(p[AB + 1], x, y - 1, z - 1), corner(p[BB + 1], x - 1, y - 1, z - 1), 0),
+			1),
+		2);
+	}
+
+	// Derivative of _perlin3DComposite(), each perlin2D() term feeds the two axes it reads
+	glm::vec4	NoiseGenerator::_perlin3DCompositeDerivative(const glm::vec3 &v) const {
+		const glm::vec3	ab = perlin2DDerivative({v.x, v.y});
+		const glm::vec3	bc = perlin2DDerivative({v.y, v.z});
+		const glm::vec3	ac = perlin2DDerivative({v.x, v.z});
+
+		const glm::vec3	ba = perlin2DDerivative({v.y, v.x});
+		const glm::vec3	cb = perlin2DDerivative({v.z, v.y});
+		const glm::vec3	ca = perlin2DDerivative({v.z, v.x});
+
+		const glm::vec4	abc = {
+			ab.x + bc.x + ac.x + ba.x + cb.x + ca.x,
+			ab.y + ac.y + ba.z + ca.z,
+			ab.z + bc.y + ba.y + cb.z,
+			bc.z + ac.z + cb.y + ca.y
+		};
+		return (abc / 6.0f);
+	}
+
 	# pragma endregion
 
 	# pragma endregion
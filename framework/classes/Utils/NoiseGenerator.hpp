@@ -1,7 +1,10 @@
 # pragma once
 
 /// System includes
+# include <array>
+# include <cstdint>
 # include <cstdlib>
+# include <vector>
 
 /// Dependencies
 # include <glm/glm.hpp>
@@ -9,28 +12,114 @@
 namespace GE::Utils {
 	/**
 	 * @brief A simple noise generator for 2D and 3D space.
-	 * 
+	 *
 	 * Currently supports :
 	 * - 2D Perlin noise
-	 * - 3D Perlin noise
+	 * - 3D Perlin noise (gradient noise, or the legacy 6 x 2D composite)
+	 * - 2D, 3D and 4D Simplex noise
+	 * - Batched 2D Perlin noise over a grid (SSE4.1 / AVX2 when available)
+	 * - Analytic derivatives of the 2D and 3D noises, as (value, gradient) vectors
+	 *
+	 * 3D Perlin and Simplex noises hash lattice points through a seeded permutation table
+	 * and pick their gradients from a fixed table, no trigonometry involved.
+	 *
+	 * All the state is derived from the seed and kept in the instance, so the same seed gives
+	 * the same world on any thread and any platform.
+	 *
+	 * @note Noise functions are const and can be called from any number of threads at once.
+	 * setSeed() and setPerlin3DMode() must not run while another thread samples the same instance.
 	 */
 	class	NoiseGenerator {
 		public:
-			explicit NoiseGenerator(const uint64_t &seed = 0) { setSeed(seed); }
+			/// @brief Instruction set used by the batched grid functions.
+			/// @note AUTO picks the widest one supported by the running CPU.
+			enum class SIMDLevel {
+				AUTO,
+				SCALAR,
+				SSE41,
+				AVX2
+			};
+
+			/// @brief Algorithm used by perlin3D().
+			/// @note LEGACY_COMPOSITE averages six perlin2D() calls, keep it to reproduce worlds generated before GRADIENT existed.
+			enum class Perlin3DMode {
+				GRADIENT,
+				LEGACY_COMPOSITE
+			};
+
+			explicit NoiseGenerator(const uint64_t &seed = 0, Perlin3DMode perlin3DMode = Perlin3DMode::GRADIENT)
+				: _perlin3DMode(perlin3DMode) { setSeed(seed); }
 			~NoiseGenerator() = default;
 
 			/// Public methods
 
-			float	perlin2D(const glm::vec2 &v);
-			float	perlin3D(const glm::vec3 &v);
+			float	perlin2D(const glm::vec2 &v) const;
+			float	perlin3D(const glm::vec3 &v) const;
+
+			float	simplex2D(const glm::vec2 &v) const;
+			float	simplex3D(const glm::vec3 &v) const;
+			float	simplex4D(const glm::vec4 &v) const;
+
+			glm::vec3	perlin2DDerivative(const glm::vec2 &v) const;
+			glm::vec4	perlin3DDerivative(const glm::vec3 &v) const;
+			glm::vec3	simplex2DDerivative(const glm::vec2 &v) const;
+			glm::vec4	simplex3DDerivative(const glm::vec3 &v) const;
+
+			void	perlin2DGrid(
+				float *out,
+				const glm::vec2 &origin,
+				const glm::vec2 &step,
+				const glm::uvec2 &count,
+				size_t stride = 0,
+				SIMDLevel level = SIMDLevel::AUTO
+			) const;
 
 			void	setSeed(const uint64_t &seed);
+			void	setPerlin3DMode(Perlin3DMode mode);
+
+			uint64_t		getSeed() const;
+			Perlin3DMode	getPerlin3DMode() const;
+
+			const std::array<uint8_t, 512> &	getPermutation() const;
+			uint32_t							getLatticeSeed() const;
+
+			static SIMDLevel	getSupportedSIMDLevel();
 
 		private:
-			uint64_t	_seed;
+			/// @brief One row of a grid evaluation, with the lattice gradients it reads from.
+			struct	Perlin2DRow {
+				float *			out;
+				size_t			count;
+				float			originX;
+				float			stepX;
+				float			y;
+				int				latticeX;	// Lattice column stored at index 0 of the gradient rows
+				const float *	gx0;		// Gradients of the lattice row (int)y
+				const float *	gy0;
+				const float *	gx1;		// Gradients of the lattice row (int)(y + 1)
+				const float *	gy1;
+			};
+
+			uint64_t					_seed;
+			uint32_t					_latticeSeed;	// Hash key of _perlin2DRandomGradiant, derived from _seed
+			Perlin3DMode				_perlin3DMode;
+			std::array<uint8_t, 512>	_permutation;	// Shuffled [0, 255] stored twice to skip index wrapping
+
+			inline float	_perlin2DDot(const glm::ivec2 &v1, const glm::vec2 &v2) const;
+			inline float	_perlin2DCubInterpol(const glm::vec2 &v, const float &weight) const;
+			glm::vec2		_perlin2DRandomGradiant(const glm::ivec2 &v) const;
+
+			float			_perlin3DGradient(const glm::vec3 &v) const;
+			float			_perlin3DComposite(const glm::vec3 &v) const;
+			glm::vec4		_perlin3DGradientDerivative(const glm::vec3 &v) const;
+			glm::vec4		_perlin3DCompositeDerivative(const glm::vec3 &v) const;
+
+			static uint32_t	_legacyRand(uint32_t seed);
+			static uint64_t	_splitMix64(uint64_t &state);
 
-			inline float	_perlin2DDot(const glm::ivec2 &v1, const glm::vec2 &v2);
-			inline float	_perlin2DCubInterpol(const glm::vec2 &v, const float &weight);
-			glm::vec2		_perlin2DRandomGradiant(const glm::ivec2 &v);
+			void			_perlin2DFillGradients(float *gx, float *gy, int latticeX, size_t span, int latticeY) const;
+			static void		_perlin2DRowScalar(const Perlin2DRow &row, size_t begin);
+			static void		_perlin2DRowSSE41(const Perlin2DRow &row);
+			static void		_perlin2DRowAVX2(const Perlin2DRow &row);
 	};
 } // namespace GE::Utils
\ No newline at end of file
@@ -0,0 +1,259 @@
+#include "TLSFAllocator.hpp"
+
+/// System includes
+# include <algorithm>
+# include <stdexcept>
+# include <string>
+
+namespace GE::Utils {
+
+	static inline int	log2Floor(uint32_t value) {
+		return 31 - __builtin_clz(value);
+	}
+
+	# pragma region Constructors & Destructors
+
+	TLSFAllocator::TLSFAllocator(uint32_t capacity) {
+		reset(capacity);
+	}
+
+	# pragma endregion
+
+	# pragma region Public methods
+
+	/// @brief Allocate a block
+	/// @param size The number of units
+	/// @return The block id, or INVALID if no free block is large enough
+	/// @throw std::invalid_argument if size is 0
+	uint32_t	TLSFAllocator::allocate(uint32_t size) {
+		if (!size)
+			throw std::invalid_argument("TLSFAllocator: Allocation of 0 units");
+
+		// Round up to the next size class, so any block of the class found fits
+		uint64_t	rounded = size;
+		if (size >= SL_COUNT)
+			rounded += ((uint64_t)1 << (log2Floor(size) - SL_LOG2)) - 1;
+
+		uint32_t	block = INVALID;
+		int			fl, sl;
+
+		if (rounded <= UINT32_MAX) {
+			_mapping((uint32_t)rounded, fl, sl);
+
+			uint32_t	slMap = _secondLevel[fl] & (~0u << sl);
+			if (!slMap) {
+				const uint32_t	flMap = (fl + 1 < 32) ? _firstLevel & (~0u << (fl + 1)) : 0;
+
+				fl = flMap ? __builtin_ctz(flMap) : 0;
+				slMap = flMap ? _secondLevel[fl] : 0;
+			}
+			if (slMap)
+				block = _heads[fl][__builtin_ctz(slMap)];
+		}
+
+		// Nothing in the larger classes, a block of the request class may still fit
+		if (block == INVALID) {
+			_mapping(size, fl, sl);
+			for (block = _heads[fl][sl]; block != INVALID && _blocks[block].size < size; block = _blocks[block].nextFree);
+			if (block == INVALID)
+				return INVALID;
+		}
+
+		_removeFree(block);
+
+		// Give the rest back
+		if (_blocks[block].size > size) {
+			const uint32_t	rest = _newBlock();
+			const uint32_t	next = _blocks[block].nextPhysical;
+
+			_blocks[rest] = {_blocks[block].offset + size, _blocks[block].size - size, block, next, INVALID, INVALID, true, true};
+			if (next != INVALID)
+				_blocks[next].prevPhysical = rest;
+			_blocks[block].nextPhysical = rest;
+			_blocks[block].size = size;
+			_insertFree(rest);
+		}
+
+		_blocks[block].free = false;
+		_used += size;
+		_allocations++;
+		return block;
+	}
+
+	/// @brief Free a block, merging it with its free neighbors
+	/// @param block A block id returned by allocate()
+	/// @throw std::invalid_argument if the block is not allocated
+	void	TLSFAllocator::free(uint32_t block) {
+		_checkBlock(block);
+
+		_blocks[block].free = true;
+		_used -= _blocks[block].size;
+		_allocations--;
+
+		const uint32_t	prev = _blocks[block].prevPhysical;
+		if (prev != INVALID && _blocks[prev].free) {
+			_removeFree(prev);
+			_blocks[prev].size += _blocks[block].size;
+			_blocks[prev].nextPhysical = _blocks[block].nextPhysical;
+			if (_blocks[block].nextPhysical != INVALID)
+				_blocks[_blocks[block].nextPhysical].prevPhysical = prev;
+
+			_blocks[block].alive = false;
+			_unusedBlocks.push_back(block);
+			block = prev;
+		}
+
+		const uint32_t	next = _blocks[block].nextPhysical;
+		if (next != INVALID && _blocks[next].free) {
+			_removeFree(next);
+			_blocks[block].size += _blocks[next].size;
+			_blocks[block].nextPhysical = _blocks[next].nextPhysical;
+			if (_blocks[next].nextPhysical != INVALID)
+				_blocks[_blocks[next].nextPhysical].prevPhysical = block;
+
+			_blocks[next].alive = false;
+			_unusedBlocks.push_back(next);
+		}
+
+		_insertFree(block);
+	}
+
+	/// @brief Drop every allocation and change the capacity
+	/// @param capacity The new number of units
+	void	TLSFAllocator::reset(uint32_t capacity) {
+		_capacity = capacity;
+		_used = 0;
+		_allocations = 0;
+		_blocks.clear();
+		_unusedBlocks.clear();
+		_firstLevel = 0;
+		std::fill_n(_secondLevel, FL_COUNT, 0);
+		std::fill_n(&_heads[0][0], FL_COUNT * SL_COUNT, INVALID);
+
+		if (capacity) {
+			const uint32_t	block = _newBlock();
+
+			_blocks[block] = {0, capacity, INVALID, INVALID, INVALID, INVALID, true, true};
+			_insertFree(block);
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Private methods
+
+	uint32_t	TLSFAllocator::_newBlock() {
+		if (!_unusedBlocks.empty()) {
+			const uint32_t	block = _unusedBlocks.back();
+
+			_unusedBlocks.pop_back();
+			return block;
+		}
+
+		_blocks.push_back({});
+		return (uint32_t)_blocks.size() - 1;
+	}
+
+	void	TLSFAllocator::_insertFree(uint32_t block) {
+		int	fl, sl;
+		_mapping(_blocks[block].size, fl, sl);
+
+		const uint32_t	head = _heads[fl][sl];
+
+		_blocks[block].prevFree = INVALID;
+		_blocks[block].nextFree = head;
+		if (head != INVALID)
+			_blocks[head].prevFree = block;
+
+		_heads[fl][sl] = block;
+		_firstLevel |= 1u << fl;
+		_secondLevel[fl] |= 1u << sl;
+	}
+
+	void	TLSFAllocator::_removeFree(uint32_t block) {
+		int	fl, sl;
+		_mapping(_blocks[block].size, fl, sl);
+
+		const uint32_t	prev = _blocks[block].prevFree;
+		const uint32_t	next = _blocks[block].nextFree;
+
+		if (prev != INVALID)
+			_blocks[prev].nextFree = next;
+		else
+			_heads[fl][sl] = next;
+		if (next != INVALID)
+			_blocks[next].prevFree = prev;
+
+		if (_heads[fl][sl] == INVALID) {
+			_secondLevel[fl] &= ~(1u << sl);
+			if (!_secondLevel[fl])
+				_firstLevel &= ~(1u << fl);
+		}
+	}
+
+	void	TLSFAllocator::_checkBlock(uint32_t block) const {
+		if (block >= _blocks.size() || !_blocks[block].alive || _blocks[block].free)
+			throw std::invalid_argument("TLSFAllocator: Invalid block - " + std::to_string(block));
+	}
+
+	// Size class : sizes below SL_COUNT have one list each, then each power of two is split in SL_COUNT lists
+	void	TLSFAllocator::_mapping(uint32_t size, int &fl, int &sl) {
+		if (size < SL_COUNT) {
+			fl = 0;
+			sl = (int)size;
+			return;
+		}
+
+		const int	log2 = log2Floor(size);
+
+		fl = log2 - SL_LOG2 + 1;
+		sl = (int)(size >> (log2 - SL_LOG2)) - SL_COUNT;
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the offset of an allocated block, in units
+	/// @throw std::invalid_argument if the block is not allocated
+	uint32_t	TLSFAllocator::getOffset(uint32_t block) const {
+		_checkBlock(block);
+		return _blocks[block].offset;
+	}
+
+	/// @brief Return the size of an allocated block, in units
+	/// @throw std::invalid_argument if the block is not allocated
+	uint32_t	TLSFAllocator::getSize(uint32_t block) const {
+		_checkBlock(block);
+		return _blocks[block].size;
+	}
+
+	/// @brief Return the number of units managed
+	uint32_t	TLSFAllocator::getCapacity() const {
+		return _capacity;
+	}
+
+	/// @brief Return the occupancy counters
+	/// @note Walks every block, meant for statistics rather than every frame
+	TLSFStats	TLSFAllocator::getStats() const {
+		TLSFStats	stats = {};
+
+		stats.capacity = _capacity;
+		stats.used = _used;
+		stats.allocations = _allocations;
+
+		for (const Block &block : _blocks) {
+			if (block.alive && block.free) {
+				stats.freeBlocks++;
+				stats.largestFree = std::max(stats.largestFree, block.size);
+			}
+		}
+
+		const uint32_t	free = _capacity - _used;
+		stats.fragmentation = free ? 1.0f - (float)stats.largestFree / (float)free : 0.0f;
+		return stats;
+	}
+
+	# pragma endregion
+
+} // namespace GE::Utils
@@ -0,0 +1,86 @@
+# pragma once
+
+/// System includes
+# include <cstdint>
+# include <vector>
+
+namespace GE::Utils {
+
+	/// @brief Occupancy of a TLSFAllocator, in units
+	struct TLSFStats {
+		uint32_t	capacity;
+		uint32_t	used;
+		uint32_t	largestFree;	// Largest allocation that can succeed
+		uint32_t	allocations;
+		uint32_t	freeBlocks;
+		float		fragmentation;	// 1 - largestFree / free space, 0 when the free space is one block
+	};
+
+	/**
+	 * @brief A Two-Level Segregated Fit allocator over an abstract range [0, capacity).
+	 *
+	 * It only does the bookkeeping : units can be bytes, vertices or indices, the memory lives elsewhere (e.g. a GPU buffer).
+	 * Free blocks are kept in lists by size class (power of two, then 16 linear subdivisions), found through two
+	 * bitmaps, so allocate() and free() run in constant time. Freed blocks merge with their free neighbors.
+	 *
+	 * Allocations are identified by a block id, valid until freed.
+	 *
+	 * @note Not thread-safe.
+	 */
+	class TLSFAllocator {
+		public:
+			static constexpr uint32_t	INVALID = UINT32_MAX;
+
+			explicit TLSFAllocator(uint32_t capacity = 0);
+			~TLSFAllocator() = default;
+
+			/// Public methods
+
+			uint32_t	allocate(uint32_t size);
+			void		free(uint32_t block);
+			void		reset(uint32_t capacity);
+
+			/// Getters
+
+			uint32_t	getOffset(uint32_t block) const;
+			uint32_t	getSize(uint32_t block) const;
+			uint32_t	getCapacity() const;
+			TLSFStats	getStats() const;
+
+		private:
+			static constexpr int	SL_LOG2 = 4;				// 16 second level lists per first level
+			static constexpr int	SL_COUNT = 1 << SL_LOG2;
+			static constexpr int	FL_COUNT = 32 - SL_LOG2 + 1;
+
+			struct	Block {
+				uint32_t	offset;
+				uint32_t	size;
+				uint32_t	prevPhysical;	// Neighbors in the range, to merge free blocks
+				uint32_t	nextPhysical;
+				uint32_t	prevFree;		// Neighbors in the free list of the size class
+				uint32_t	nextFree;
+				bool		free;
+				bool		alive;			// Not in the pool of unused blocks
+			};
+
+			uint32_t				_capacity = 0;
+			uint32_t				_used = 0;
+			uint32_t				_allocations = 0;
+
+			std::vector<Block>		_blocks;
+			std::vector<uint32_t>	_unusedBlocks;		// Recycled block ids
+
+			uint32_t				_firstLevel = 0;			// Bit fl set if a list of fl is not empty
+			uint32_t				_secondLevel[FL_COUNT] = {};	// Bit sl set if list (fl, sl) is not empty
+			uint32_t				_heads[FL_COUNT][SL_COUNT];	// First free block of each list
+
+			/// Private methods
+
+			uint32_t	_newBlock();
+			void		_insertFree(uint32_t block);
+			void		_removeFree(uint32_t block);
+			void		_checkBlock(uint32_t block) const;
+
+			static void	_mapping(uint32_t size, int &fl, int &sl);
+	};
+} // namespace GE::Utils
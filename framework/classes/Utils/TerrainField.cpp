@@ -0,0 +1,233 @@
+#include "TerrainField.hpp"
+
+/// Includes
+# include "core/Profiler.hpp"
+
+/// System includes
+# include <chrono>
+# include <stdexcept>
+
+namespace GE::Utils {
+
+	# pragma region Constructors & Destructors
+
+	TerrainField::TerrainField(const TerrainFieldInfo &info) : _info(info), _pool(info.threadCount) {
+		if (!info.tileSize.x || !info.tileSize.y || !info.tileSize.z)
+			throw std::invalid_argument("TerrainField: Tile size must not be 0");
+	}
+
+	// _pool is destroyed first : queued tiles are dropped, running ones are waited for
+	TerrainField::~TerrainField() {}
+
+	# pragma endregion
+
+	# pragma region Public methods
+
+	/// @brief Request the heightmap of a chunk
+	/// @param seed The world seed
+	/// @param chunk The chunk coordinates
+	/// @return A future to the tile, already ready if the tile was cached
+	std::shared_future<TerrainTilePtr>	TerrainField::requestHeightmap(uint64_t seed, const glm::ivec2 &chunk) {
+		return _request({TerrainTileKey::Kind::HEIGHTMAP, seed, {chunk.x, chunk.y, 0}});
+	}
+
+	/// @brief Request the density block of a chunk
+	/// @param seed The world seed
+	/// @param chunk The chunk coordinates
+	/// @return A future to the tile, already ready if the tile was cached
+	std::shared_future<TerrainTilePtr>	TerrainField::requestDensity(uint64_t seed, const glm::ivec3 &chunk) {
+		return _request({TerrainTileKey::Kind::DENSITY, seed, chunk});
+	}
+
+	/// @brief Return a tile if it is cached and generated, without scheduling anything
+	/// @param key The tile to look for
+	/// @return The tile, or nullptr if it is missing, still being generated or failed
+	/// @note A failed tile is dropped from the cache, the next request generates it again
+	TerrainTilePtr	TerrainField::tryGet(const TerrainTileKey &key) {
+		std::lock_guard<std::mutex>	lock(_mutex);
+
+		auto	it = _cache.find(key);
+		if (it == _cache.end() || it->second.tile.wait_for(std::chrono::seconds(0)) != std::future_status::ready || _dropFailed(it))
+			return nullptr;
+
+		_lru.splice(_lru.begin(), _lru, it->second.lruPosition);
+		return it->second.tile.get();
+	}
+
+	/// @brief Drop every cached tile
+	/// @note Tiles being generated still complete for the callers holding their future
+	void	TerrainField::clear() {
+		std::lock_guard<std::mutex>	lock(_mutex);
+
+		_cache.clear();
+		_lru.clear();
+		_memoryUsed = 0;
+	}
+
+	# pragma endregion
+
+	# pragma region Private methods
+
+	std::shared_future<TerrainTilePtr>	TerrainField::_request(const TerrainTileKey &key) {
+		std::lock_guard<std::mutex>	lock(_mutex);
+
+		// A tile whose generation failed is generated again, as if it was never requested
+		auto	it = _cache.find(key);
+		if (it != _cache.end() && !_dropFailed(it)) {
+			_hits++;
+			_lru.splice(_lru.begin(), _lru, it->second.lruPosition);
+			return it->second.tile;
+		}
+
+		_misses++;
+
+		const uint64_t							id = _nextEntryID++;
+		std::shared_ptr<const NoiseGenerator>	noise = _getGenerator(key.seed);
+		std::shared_future<TerrainTilePtr>		tile = _pool.submit([this, key, id, noise]() { return _generate(key, id, noise); }).share();
+
+		const glm::uvec3	size = _info.tileSize + _info.padding;
+		const size_t		samples = (size_t)size.x * size.y * (key.kind == TerrainTileKey::Kind::HEIGHTMAP ? 1 : size.z);
+		const size_t		bytes = samples * sizeof(float) + sizeof(TerrainTile);
+
+		_lru.push_front(key);
+		_cache.emplace(key, CacheEntry{tile, _lru.begin(), bytes, id, false});
+		_memoryUsed += bytes;
+		_evict();
+
+		return tile;
+	}
+
+	// One generator per seed, shared by every worker (sampling is const)
+	// Called with _mutex locked
+	std::shared_ptr<const NoiseGenerator>	TerrainField::_getGenerator(uint64_t seed) {
+		auto	it = _generators.find(seed);
+		if (it != _generators.end())
+			return it->second;
+
+		return _generators[seed] = std::make_shared<const NoiseGenerator>(seed, _info.perlin3DMode);
+	}
+
+	// Runs on a worker thread
+	TerrainTilePtr	TerrainField::_generate(const TerrainTileKey &key, uint64_t id, std::shared_ptr<const NoiseGenerator> noise) {
+		GE_PROFILE_SCOPE("TerrainField::generate");
+
+		const auto	start = std::chrono::steady_clock::now();
+		const bool	heightmap = (key.kind == TerrainTileKey::Kind::HEIGHTMAP);
+		const float	spacing = _info.sampleSpacing;
+
+		std::shared_ptr<TerrainTile>	tile = std::make_shared<TerrainTile>();
+		tile->key = key;
+		tile->size = _info.tileSize + _info.padding;
+		tile->origin = glm::vec3(key.chunk) * glm::vec3(_info.tileSize) * spacing;
+		if (heightmap) {
+			tile->size.z = 1;
+			tile->origin.z = 0;
+		}
+		tile->values.resize((size_t)tile->size.x * tile->size.y * tile->size.z);
+
+		// Once generated (or failed) the tile can be evicted, and the budget may have been exceeded meanwhile
+		const auto	markReady = [this, &key, id]() {
+			std::lock_guard<std::mutex>	lock(_mutex);
+
+			auto	entry = _cache.find(key);
+			if (entry != _cache.end() && entry->second.id == id) {
+				entry->second.ready = true;
+				_evict();
+			}
+		};
+
+		try {
+			const TerrainTileGenerator &	generator = heightmap ? _info.heightmapGenerator : _info.densityGenerator;
+			if (generator)
+				generator(*noise, *tile);
+			else {
+				const FractalNoise	fractal(*noise, _info.fractal, _info.fractalType, _info.fractalBasis);
+
+				if (heightmap)
+					fractal.sample2DGrid(tile->values.data(), {tile->origin.x, tile->origin.y}, {spacing, spacing}, {tile->size.x, tile->size.y});
+				else {
+					float *	out = tile->values.data();
+					for (unsigned z = 0; z < tile->size.z; z++)
+						for (unsigned y = 0; y < tile->size.y; y++)
+							for (unsigned x = 0; x < tile->size.x; x++)
+								*out++ = fractal.sample3D(tile->origin + glm::vec3{(float)x, (float)y, (float)z} * spacing);
+				}
+			}
+		}
+		catch (...) {
+			markReady();
+			throw;
+		}
+
+		_generationTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		_generatedTiles++;
+		markReady();
+
+		return tile;
+	}
+
+	// Erase an entry whose generation threw, a no-op while it is generating or once generated
+	// Called with _mutex locked
+	// Return whether the entry was erased
+	bool	TerrainField::_dropFailed(TileCache::iterator entry) {
+		if (entry->second.tile.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			return false;
+
+		try {
+			entry->second.tile.get();
+			return false;
+		}
+		catch (...) {
+			_memoryUsed -= entry->second.bytes;
+			_lru.erase(entry->second.lruPosition);
+			_cache.erase(entry);
+			return true;
+		}
+	}
+
+	// Drop least recently used tiles until the budget is met, tiles still generating are kept
+	// Called with _mutex locked
+	void	TerrainField::_evict() {
+		auto	it = _lru.end();
+
+		while (_memoryUsed > _info.memoryBudget && it != _lru.begin()) {
+			--it;
+
+			auto	entry = _cache.find(*it);
+			if (!entry->second.ready)
+				continue;
+
+			_memoryUsed -= entry->second.bytes;
+			_cache.erase(entry);
+			it = _lru.erase(it);
+			_evictions++;
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the settings of the field
+	const TerrainFieldInfo &	TerrainField::getInfo() const {
+		return _info;
+	}
+
+	/// @brief Return the cache and generation counters
+	TerrainFieldStats	TerrainField::getStats() {
+		std::lock_guard<std::mutex>	lock(_mutex);
+
+		return {
+			_hits,
+			_misses,
+			_evictions,
+			_generatedTiles.load(),
+			(double)_generationTime.load() / 1e6,
+			_memoryUsed,
+			_cache.size()
+		};
+	}
+
+	# pragma endregion
+
+} // namespace GE::Utils
\ No newline at end of file
@@ -0,0 +1,166 @@
+# pragma once
+
+/// Includes
+# include "NoiseGenerator.hpp"
+# include "FractalNoise.hpp"
+# include "ThreadPool.hpp"
+
+/// System includes
+# include <atomic>
+# include <functional>
+# include <future>
+# include <list>
+# include <memory>
+# include <mutex>
+# include <unordered_map>
+# include <vector>
+
+/// Dependencies
+# include <glm/glm.hpp>
+
+namespace GE::Utils {
+
+	// Identifies a tile : which field, which world, which chunk
+	struct TerrainTileKey {
+		enum class Kind : uint8_t {
+			HEIGHTMAP,	// 2D, chunk.z is ignored
+			DENSITY		// 3D
+		};
+
+		Kind		kind;
+		uint64_t	seed;
+		glm::ivec3	chunk;
+
+		bool	operator==(const TerrainTileKey &other) const {
+			return kind == other.kind && seed == other.seed && chunk == other.chunk;
+		}
+	};
+
+	struct TerrainTileKeyHash {
+		size_t	operator()(const TerrainTileKey &key) const {
+			size_t	hash = key.seed * 0x9E3779B97F4A7C15ull;
+			hash ^= (size_t)(uint32_t)key.chunk.x * 0x85EBCA77u + (hash << 6) + (hash >> 2);
+			hash ^= (size_t)(uint32_t)key.chunk.y * 0xC2B2AE3Du + (hash << 6) + (hash >> 2);
+			hash ^= (size_t)(uint32_t)key.chunk.z * 0x27D4EB2Fu + (hash << 6) + (hash >> 2);
+			return hash ^ (size_t)key.kind;
+		}
+	};
+
+	// A generated tile, values are stored x first, then y, then z
+	struct TerrainTile {
+		TerrainTileKey		key;
+		glm::uvec3			size;		// Number of samples on each axis, size.z is 1 for heightmaps
+		glm::vec3			origin;		// World position of the first sample
+		std::vector<float>	values;
+
+		float	at(unsigned x, unsigned y, unsigned z = 0) const {
+			return values[((size_t)z * size.y + y) * size.x + x];
+		}
+	};
+
+	using TerrainTilePtr = std::shared_ptr<const TerrainTile>;
+
+	// Fills tile.values (already sized) from the generator of tile.key.seed
+	using TerrainTileGenerator = std::function<void(const NoiseGenerator &noise, TerrainTile &tile)>;
+
+	/// @brief Stores the settings of a TerrainField
+	struct TerrainFieldInfo {
+		glm::uvec3		tileSize      = {32, 32, 32};		// Samples per chunk on each axis, heightmaps use x and y
+		glm::uvec3		padding       = {0, 0, 0};			// Extra samples shared with the next chunk (e.g. 1 for meshing)
+		float			sampleSpacing = 1.0f;				// World distance between two samples
+		size_t			memoryBudget  = 256 * 1024 * 1024;	// Bytes of tiles kept in cache
+		size_t			threadCount   = 0;					// Worker threads, 0 means one per hardware thread minus one
+
+		FractalInfo					fractal = {6, 1.0f / 64.0f};	// Frequency is in cycles per world unit
+		FractalNoise::Type			fractalType  = FractalNoise::Type::FBM;
+		FractalNoise::Basis			fractalBasis = FractalNoise::Basis::PERLIN;
+		NoiseGenerator::Perlin3DMode	perlin3DMode = NoiseGenerator::Perlin3DMode::GRADIENT;
+
+		// Optional overrides of the default fractal fields
+		TerrainTileGenerator	heightmapGenerator;
+		TerrainTileGenerator	densityGenerator;
+	};
+
+	/// @brief Cache and generation counters of a TerrainField
+	struct TerrainFieldStats {
+		size_t	hits;
+		size_t	misses;
+		size_t	evictions;
+		size_t	generatedTiles;
+		double	generationTime;	// Milliseconds spent generating, summed over all workers
+		size_t	memoryUsed;		// Bytes of tiles in cache
+		size_t	cachedTiles;
+	};
+
+	/**
+	 * @brief Generates 2D heightmaps and 3D density blocks per chunk on a worker pool, and caches them.
+	 *
+	 * Tiles are keyed by seed and chunk coordinates. Requesting a tile that is cached, or already being
+	 * generated, returns the same shared future, so a chunk is only generated once however many times
+	 * it is requested. A tile whose generation threw is dropped instead, and generated again by the next request.
+	 *
+	 * The cache is LRU with a memory budget, tiles still referenced by callers stay valid after eviction.
+	 *
+	 * By default heightmaps are FractalNoise::sample2DGrid() and densities FractalNoise::sample3D(),
+	 * both overridable through TerrainFieldInfo.
+	 *
+	 * @note All public methods are thread-safe.
+	 */
+	class TerrainField {
+		public:
+			explicit TerrainField(const TerrainFieldInfo &info = {});
+			~TerrainField();
+
+			TerrainField(const TerrainField &) = delete;
+			TerrainField &operator=(const TerrainField &) = delete;
+
+			/// Public methods
+
+			std::shared_future<TerrainTilePtr>	requestHeightmap(uint64_t seed, const glm::ivec2 &chunk);
+			std::shared_future<TerrainTilePtr>	requestDensity(uint64_t seed, const glm::ivec3 &chunk);
+			TerrainTilePtr						tryGet(const TerrainTileKey &key);
+
+			void	clear();
+
+			/// Getters
+
+			const TerrainFieldInfo &	getInfo() const;
+			TerrainFieldStats			getStats();
+
+		private:
+			struct CacheEntry {
+				std::shared_future<TerrainTilePtr>	tile;
+				std::list<TerrainTileKey>::iterator	lruPosition;
+				size_t								bytes;
+				uint64_t							id;		// Tells a re-requested tile from the one it replaced
+				bool								ready;	// Generated, can be evicted
+			};
+
+			using TileCache = std::unordered_map<TerrainTileKey, CacheEntry, TerrainTileKeyHash>;
+
+			TerrainFieldInfo	_info;
+
+			std::mutex			_mutex;
+			TileCache			_cache;
+			std::list<TerrainTileKey>											_lru;	// Most recently used first
+			std::unordered_map<uint64_t, std::shared_ptr<const NoiseGenerator>>	_generators;
+
+			size_t					_memoryUsed = 0;
+			size_t					_hits = 0;
+			size_t					_misses = 0;
+			size_t					_evictions = 0;
+			uint64_t				_nextEntryID = 0;
+			std::atomic<size_t>		_generatedTiles{0};
+			std::atomic<uint64_t>	_generationTime{0};	// Nanoseconds
+
+			ThreadPool			_pool;	// Last member, joined first on destruction
+
+			/// Private methods
+
+			std::shared_future<TerrainTilePtr>		_request(const TerrainTileKey &key);
+			std::shared_ptr<const NoiseGenerator>	_getGenerator(uint64_t seed);
+			TerrainTilePtr							_generate(const TerrainTileKey &key, uint64_t id, std::shared_ptr<const NoiseGenerator> noise);
+			bool									_dropFailed(TileCache::iterator entry);
+			void									_evict();
+	};
+} // namespace GE::Utils
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "ThreadPool.hpp"
+
+namespace GE::Utils {
+
+	# pragma region Constructors & Destructors
+
+	/// @param threadCount The number of workers, 0 means one per hardware thread minus the calling one
+	ThreadPool::ThreadPool(size_t threadCount) {
+		if (!threadCount) {
+			const size_t	hardware = std::thread::hardware_concurrency();
+			threadCount = (hardware > 1) ? hardware - 1 : 1;
+		}
+
+		_workers.reserve(threadCount);
+		for (size_t i = 0; i < threadCount; i++)
+			_workers.emplace_back(&ThreadPool::_workerLoop, this);
+	}
+
+	ThreadPool::~ThreadPool() {
+		{
+			std::lock_guard<std::mutex>	lock(_mutex);
+			_stopping = true;
+			_tasks.clear();
+		}
+		_taskCondition.notify_all();
+
+		for (std::thread &worker : _workers)
+			worker.join();
+	}
+
+	# pragma endregion
+
+	# pragma region Public methods
+
+	/// @brief Block until the queue is empty and every worker is idle
+	void	ThreadPool::wait() {
+		std::unique_lock<std::mutex>	lock(_mutex);
+		_idleCondition.wait(lock, [this]() { return _tasks.empty() && !_activeCount; });
+	}
+
+	# pragma endregion
+
+	# pragma region Private methods
+
+	void	ThreadPool::_workerLoop() {
+		while (true) {
+			std::function<void()>	task;
+			{
+				std::unique_lock<std::mutex>	lock(_mutex);
+				_taskCondition.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+
+				if (_stopping)
+					return;
+
+				task = std::move(_tasks.front());
+				_tasks.pop_front();
+				_activeCount++;
+			}
+
+			task();
+
+			{
+				std::lock_guard<std::mutex>	lock(_mutex);
+				_activeCount--;
+				if (_tasks.empty() && !_activeCount)
+					_idleCondition.notify_all();
+			}
+		}
+	}
+
+	# pragma endregion
+
+	# pragma region Getters
+
+	/// @brief Return the number of worker threads
+	size_t	ThreadPool::getThreadCount() const {
+		return _workers.size();
+	}
+
+	/// @brief Return the number of tasks waiting for a worker
+	size_t	ThreadPool::getPendingCount() {
+		std::lock_guard<std::mutex>	lock(_mutex);
+		return _tasks.size();
+	}
+
+	# pragma endregion
+
+} // namespace GE::Utils
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+/// System includes
+# include <condition_variable>
+# include <deque>
+# include <functional>
+# include <future>
+# include <memory>
+# include <mutex>
+# include <thread>
+# include <type_traits>
+# include <vector>
+
+namespace GE::Utils {
+	/**
+	 * @brief A fixed-size pool of worker threads consuming a FIFO task queue.
+	 *
+	 * Tasks are submitted as any callable and return a std::future to their result.
+	 *
+	 * @note Tasks still queued when the pool is destroyed are dropped, their futures report std::future_error (broken promise).
+	 * Tasks already running are waited for.
+	 */
+	class ThreadPool {
+		public:
+			explicit ThreadPool(size_t threadCount = 0);
+			~ThreadPool();
+
+			ThreadPool(const ThreadPool &) = delete;
+			ThreadPool &operator=(const ThreadPool &) = delete;
+
+			/// Public methods
+
+			/// @brief Queue a task to run on a worker thread
+			/// @param task The callable to run, taking no argument
+			/// @return A future holding the result (or the exception) of the task
+			template <typename F>
+			std::future<std::invoke_result_t<std::decay_t<F>>>	submit(F &&task) {
+				using Result = std::invoke_result_t<std::decay_t<F>>;
+
+				auto	packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+				std::future<Result>	future = packaged->get_future();
+				{
+					std::lock_guard<std::mutex>	lock(_mutex);
+					_tasks.emplace_back([packaged]() { (*packaged)(); });
+				}
+				_taskCondition.notify_one();
+
+				return future;
+			}
+
+			void	wait();
+
+			/// Getters
+
+			size_t	getThreadCount() const;
+			size_t	getPendingCount();
+
+		private:
+			std::vector<std::thread>			_workers;
+			std::deque<std::function<void()>>	_tasks;
+			std::mutex							_mutex;
+			std::condition_variable				_taskCondition;
+			std::condition_variable				_idleCondition;
+			size_t								_activeCount = 0;
+			bool								_stopping = false;
+
+			/// Private methods
+
+			void	_workerLoop();
+	};
+} // namespace GE::Utils
\ No newline at end of file
@@ -0,0 +1,329 @@
+#include <Profiler.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace GE::Core {
+
+	// Write a JSON string, escaped
+	static void	writeString(std::ostream &out, const std::string &str) {
+		out << '"';
+		for (const char c : str) {
+			if (c == '"' || c == '\\')
+				out << '\\' << c;
+			else if ((unsigned char)c < 0x20)
+				out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c << std::dec << std::setfill(' ');
+			else
+				out << c;
+		}
+		out << '"';
+	}
+
+	// Append the zones of a node and its children, indented by depth
+	static void	formatNodes(std::ostringstream &out, const std::vector<ProfileNode> &nodes, size_t depth) {
+		for (const ProfileNode &node : nodes) {
+			out << std::string(depth * 2, ' ') << node.name << " : " << node.time << " ms";
+			if (node.calls > 1)
+				out << " (x" << node.calls << ")";
+			out << '\n';
+			formatNodes(out, node.children, depth + 1);
+		}
+	}
+
+	// Sum the time of the top-level zones
+	static double	sumTime(const std::vector<ProfileNode> &zones) {
+		double time = 0;
+
+		for (const ProfileNode &zone : zones)
+			time += zone.time;
+		return time;
+	}
+
+	Profiler::Profiler() : frameStart(now()), startTicks(now()), startTime(std::chrono::steady_clock::now()) {}
+
+	#pragma region Public Methods
+
+	/// @brief Close the current frame of the calling thread and build its breakdown, see getLastFrame()
+	/// @note Zones still open are not part of it, call it from the outermost scope of the loop.
+	/// @note Outside of a capture, the zones read are discarded, and so are the zones of the other threads.
+	void Profiler::frame() {
+		ThreadBuffer		&buffer = threadBuffer();
+		std::vector<Event>	events;
+		const uint64_t		end = now();
+		const bool			keep = capturing;
+
+		std::lock_guard<std::mutex> frameLock(frameMutex);
+		{
+			std::lock_guard<std::mutex> lock(buffer.mutex);
+
+			events.assign(buffer.events.begin() + std::min(buffer.frameCursor, buffer.events.size()), buffer.events.end());
+			if (!keep)
+				buffer.events.clear();
+			if (buffer.events.size() < BUFFER_CAPACITY)
+				buffer.events.push_back({"Frame", frameStart, end, buffer.depth});
+			buffer.frameCursor = buffer.events.size();
+		}
+
+		const double	toMilliseconds = 1.0 / (ticksPerMicrosecond() * 1000.0);
+		FrameProfile	profile = {};
+
+		profile.index = frameIndex++;
+		profile.time = (end - frameStart) * toMilliseconds;
+		buildTree(events, buffer.depth, toMilliseconds, profile.zones);
+		profile.cpuTime = sumTime(profile.zones);
+
+		// The GPU timings read since the last frame, a node per track
+		{
+			std::lock_guard<std::mutex> lock(buffersMutex);
+
+			for (const std::shared_ptr<ThreadBuffer> &track : buffers) {
+				if (!track->gpu) {
+					// The zones of the worker threads are only read by the trace
+					if (!keep && track.get() != &buffer) {
+						std::lock_guard<std::mutex> trackLock(track->mutex);
+						track->events.clear();
+					}
+					continue;
+				}
+
+				std::lock_guard<std::mutex> trackLock(track->mutex);
+				ProfileNode node = {track->name.c_str(), 0, 0, {}};
+
+				events.assign(track->events.begin() + std::min(track->frameCursor, track->events.size()), track->events.end());
+				if (!keep)
+					track->events.clear();
+				track->frameCursor = track->events.size();
+				if (events.empty())
+					continue;
+
+				buildTree(events, 0, toMilliseconds, node.children);
+				node.time = sumTime(node.children);
+				node.calls = 1;
+				profile.gpuTime += node.time;
+				profile.gpu.push_back(std::move(node));
+			}
+		}
+		profile.gpuBound = profile.gpuTime > profile.cpuTime;
+
+		lastFrame = std::move(profile);
+		frameStart = end;
+	}
+
+	/// @brief Forget the zones of every thread, e.g. after an export
+	void Profiler::clear() {
+		std::lock_guard<std::mutex> lock(buffersMutex);
+
+		for (const std::shared_ptr<ThreadBuffer> &buffer : buffers) {
+			std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+
+			buffer->events.clear();
+			buffer->frameCursor = 0;
+			buffer->dropped = 0;
+		}
+	}
+
+	/// @brief Keep every zone from now on, for exportChromeTrace()
+	/// @note Each thread keeps up to BUFFER_CAPACITY zones, see getDroppedCount()
+	void Profiler::startCapture() {
+		capturing = true;
+	}
+
+	/// @brief Stop keeping the zones, the next frame() discards the captured ones
+	/// @note Export the capture before the next frame()
+	void Profiler::stopCapture() {
+		capturing = false;
+	}
+
+	/// @brief Write the zones of every thread as a Chrome trace, opened by chrome://tracing or https://ui.perfetto.dev
+	/// @param filename The file to write, replaced if it exists
+	/// @note Holds the zones since startCapture(), or since the last frame() outside of a capture
+	/// @throw std::runtime_error if the file cannot be written
+	void Profiler::exportChromeTrace(const std::string& filename) {
+		std::ofstream file(filename, std::ios::trunc);
+
+		if (!file.is_open())
+			throw std::runtime_error("Profiler: Failed to open file " + filename);
+
+		const double	toMicroseconds = 1.0 / ticksPerMicrosecond();
+		bool			first = true;
+
+		file << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		std::lock_guard<std::mutex> lock(buffersMutex);
+		for (const std::shared_ptr<ThreadBuffer> &buffer : buffers) {
+			std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+
+			file << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id << ",\"args\":{\"name\":";
+			writeString(file, buffer->name);
+			file << "}}";
+			first = false;
+
+			for (const Event &event : buffer->events) {
+				file << ",\n{\"name\":";
+				writeString(file, event.name);
+				file << ",\"cat\":\"GE\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id
+					<< ",\"ts\":" << (event.start - startTicks) * toMicroseconds
+					<< ",\"dur\":" << (event.end - event.start) * toMicroseconds << "}";
+			}
+		}
+		file << "\n]}\n";
+
+		if (!file)
+			throw std::runtime_error("Profiler: Failed to write file " + filename);
+	}
+
+	/// @brief Format the breakdown of the last frame, one zone per line indented by depth
+	std::string Profiler::formatLastFrame() {
+		std::lock_guard<std::mutex> lock(frameMutex);
+		std::ostringstream out;
+
+		out << std::fixed << std::setprecision(3) << "Frame " << lastFrame.index << " : " << lastFrame.time << " ms, CPU "
+			<< lastFrame.cpuTime << " ms, GPU " << lastFrame.gpuTime << " ms" << (lastFrame.gpuBound ? " (GPU-bound)\n" : " (CPU-bound)\n");
+		formatNodes(out, lastFrame.zones, 1);
+		formatNodes(out, lastFrame.gpu, 1);
+		return out.str();
+	}
+
+	/// @brief Add a GPU timing to a track, shown as a thread of the trace and as a node of the frame breakdown
+	/// @param track The track, e.g. "OpenGL" or "OpenCL", created on first use
+	/// @param name The zone name, a string literal or __func__
+	/// @param issued When the work was submitted, from now()
+	/// @param time The GPU time in milliseconds
+	/// @param depth The nesting depth of the zone in its track
+	/// @param delay Milliseconds from the submission to the start of the work on the GPU, if known
+	/// @note Called by the GPU timers, the timings are part of the frame during which they are recorded.
+	void Profiler::recordGPU(const std::string& track, const char *name, uint64_t issued, double time, uint32_t depth, double delay) {
+		const double	ticks = ticksPerMicrosecond() * 1000.0;
+		const uint64_t	start = issued + (uint64_t)(delay * ticks);
+		ThreadBuffer	*buffer = nullptr;
+
+		{
+			std::lock_guard<std::mutex> lock(buffersMutex);
+
+			for (const std::shared_ptr<ThreadBuffer> &candidate : buffers)
+				if (candidate->gpu && candidate->name == track)
+					buffer = candidate.get();
+			if (!buffer)
+				buffer = &registerBuffer(track, true);
+		}
+
+		std::lock_guard<std::mutex> lock(buffer->mutex);
+		if (buffer->events.size() < BUFFER_CAPACITY)
+			buffer->events.push_back({name, start, start + (uint64_t)(time * ticks), depth});
+		else
+			buffer->dropped++;
+	}
+
+	/// @brief Name the calling thread in the trace, "Thread <id>" by default
+	void Profiler::setThreadName(const std::string& name) {
+		ThreadBuffer &buffer = threadBuffer();
+		std::lock_guard<std::mutex> lock(buffer.mutex);
+
+		buffer.name = name;
+	}
+
+	#pragma endregion
+
+	#pragma region Getters
+
+	/// @brief Return the breakdown of the last frame closed by frame()
+	FrameProfile Profiler::getLastFrame() {
+		std::lock_guard<std::mutex> lock(frameMutex);
+
+		return lastFrame;
+	}
+
+	/// @brief Return whether the zones are kept for a trace, see startCapture()
+	bool Profiler::isCapturing() const {
+		return capturing;
+	}
+
+	/// @brief Return the number of zones dropped by full buffers since the last clear()
+	size_t Profiler::getDroppedCount() {
+		std::lock_guard<std::mutex> lock(buffersMutex);
+		size_t dropped = 0;
+
+		for (const std::shared_ptr<ThreadBuffer> &buffer : buffers) {
+			std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+			dropped += buffer->dropped;
+		}
+		return dropped;
+	}
+
+	#pragma endregion
+
+	#pragma region Private Methods
+
+	// The buffer of the calling thread, registered on its first zone and kept after the thread exits for the export
+	Profiler::ThreadBuffer &Profiler::threadBuffer() {
+		thread_local ThreadBuffer *local = nullptr;
+
+		if (!local) {
+			std::lock_guard<std::mutex> lock(buffersMutex);
+
+			local = &registerBuffer("Thread " + std::to_string(buffers.size()), false);
+		}
+		return *local;
+	}
+
+	// Add a buffer to the export, buffersMutex must be held
+	Profiler::ThreadBuffer &Profiler::registerBuffer(const std::string& name, bool gpu) {
+		std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+
+		buffer->id = buffers.size();
+		buffer->name = name;
+		buffer->gpu = gpu;
+		buffer->events.reserve(4096);
+		buffers.push_back(buffer);
+		return *buffer;
+	}
+
+	// Merge zones into a tree, by name under the same parent
+	void Profiler::buildTree(std::vector<Event> &events, uint32_t base, double toMilliseconds, std::vector<ProfileNode> &zones) {
+		std::vector<ProfileNode *>	parents;
+
+		// Events are recorded when they end : sorted by start, each one follows its parent
+		std::sort(events.begin(), events.end(), [](const Event &a, const Event &b) {
+			return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+		});
+
+		for (const Event &event : events) {
+			const size_t				depth = std::min<size_t>(event.depth - std::min(event.depth, base), parents.size());
+			std::vector<ProfileNode>	&siblings = depth ? parents[depth - 1]->children : zones;
+
+			auto node = std::find_if(siblings.begin(), siblings.end(), [&](const ProfileNode &sibling) {
+				return !std::strcmp(sibling.name, event.name);
+			});
+			if (node == siblings.end())
+				node = siblings.insert(siblings.end(), {event.name, 0, 0, {}});
+
+			node->time += (event.end - event.start) * toMilliseconds;
+			node->calls++;
+
+			parents.resize(depth);
+			parents.push_back(&*node);
+		}
+	}
+
+	// Ticks per microsecond : the TSC rate measured against steady_clock since the start, at least over 10 ms
+	double Profiler::ticksPerMicrosecond() {
+		#ifdef GE_PROFILE_RDTSC
+			using namespace std::chrono;
+
+			while (steady_clock::now() - startTime < milliseconds(10))
+				std::this_thread::yield();
+
+			const double elapsed = duration<double, std::micro>(steady_clock::now() - startTime).count();
+			return (now() - startTicks) / elapsed;
+		#else
+			return 1000.0;
+		#endif
+	}
+
+	#pragma endregion
+
+} // namespace GE::Core
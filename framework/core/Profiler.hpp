@@ -0,0 +1,192 @@
+#pragma once
+
+// Includes
+# include "Singleton.hpp"
+
+// System includes
+# include <atomic>
+# include <chrono>
+# include <cstdint>
+# include <memory>
+# include <mutex>
+# include <string>
+# include <vector>
+
+# if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+#  define GE_PROFILE_RDTSC
+# endif
+
+// Profiling macros, expanding to nothing unless GE_ENABLE_PROFILING is defined (CMake option of the same name)
+// Names must outlive the profiler : string literals or __func__
+
+# define GE_PROFILE_CONCAT_(a, b) a##b
+# define GE_PROFILE_CONCAT(a, b) GE_PROFILE_CONCAT_(a, b)
+
+# ifdef GE_ENABLE_PROFILING
+#  define GE_PROFILE_SCOPE(name)	::GE::Core::ProfileZone GE_PROFILE_CONCAT(geProfileZone, __LINE__)(name)
+#  define GE_PROFILE_FUNCTION()		GE_PROFILE_SCOPE(__func__)
+#  define GE_PROFILE_FRAME()		::GE::Core::Profiler::getInstance().frame()
+#  define GE_PROFILE_THREAD(name)	::GE::Core::Profiler::getInstance().setThreadName(name)
+# else
+#  define GE_PROFILE_SCOPE(name)	((void)0)
+#  define GE_PROFILE_FUNCTION()		((void)0)
+#  define GE_PROFILE_FRAME()		((void)0)
+#  define GE_PROFILE_THREAD(name)	((void)0)
+# endif
+
+namespace GE::Core {
+	/**
+	 * @brief A zone of the frame breakdown, with the zones opened inside it.
+	 *
+	 * Zones of the same name under the same parent are merged, calls counts them.
+	 */
+	struct ProfileNode {
+		const char *				name;
+		double						time;	// Milliseconds, children comprised
+		uint32_t					calls;
+		std::vector<ProfileNode>	children;
+	};
+
+	/**
+	 * @brief The hierarchical breakdown of a frame, on the thread calling Profiler::frame(), and the GPU timings read during it.
+	 *
+	 * GPU timings are read back a few frames after they were issued : in a steady state, they still compare to the CPU ones.
+	 */
+	struct FrameProfile {
+		uint64_t					index;
+		double						time;		// Milliseconds, waits comprised
+		double						cpuTime;	// Milliseconds in the top-level zones, the waits outside of them are not counted
+		double						gpuTime;	// Milliseconds in the top-level zones of the GPU tracks
+		bool						gpuBound;	// gpuTime > cpuTime : the GPU limits the frame rate
+		std::vector<ProfileNode>	zones;
+		std::vector<ProfileNode>	gpu;		// One node per track, see Profiler::recordGPU()
+	};
+
+	/**
+	 * @brief The Profiler class records scoped CPU zones from any thread, for a per-frame breakdown and a trace export.
+	 *
+	 * Zones are opened with GE_PROFILE_SCOPE("name") or GE_PROFILE_FUNCTION() and closed at the end of the scope.
+	 * Each thread appends them to its own buffer, the only lock taken is the uncontended one of this buffer.
+	 * Timestamps are read from the TSC on x86 (rdtsc, converted with the ratio measured against steady_clock
+	 * since the start), from steady_clock elsewhere.
+	 *
+	 * GE_PROFILE_FRAME() closes a frame : its zones on the calling thread become getLastFrame().
+	 * exportChromeTrace() writes every zone of every thread kept since startCapture() for chrome://tracing or https://ui.perfetto.dev.
+	 *
+	 * GPU timers (OpenGL::TimerQueryGL, OpenCL::KernelTimerCL) add their results with recordGPU(), to a track per API.
+	 * They are part of the frame during which they were read, and of the trace, placed when they were issued.
+	 *
+	 * @note Without GE_ENABLE_PROFILING the macros are empty, the instrumented code has no overhead at all.
+	 * @note Outside of a capture, frame() discards the zones it read and those of the other threads, the buffers hold about a frame.
+	 * During a capture, each thread keeps up to BUFFER_CAPACITY zones, the next ones are dropped until stopCapture() or clear().
+	 */
+	class Profiler : public Singleton<Profiler> {
+		friend class Singleton<Profiler>;
+		friend class ProfileZone;
+
+		public:
+			static constexpr size_t	BUFFER_CAPACITY = 1 << 20;
+
+			void			frame();
+			void			clear();
+			void			startCapture();
+			void			stopCapture();
+			void			exportChromeTrace(const std::string& filename);
+			std::string		formatLastFrame();
+
+			void			recordGPU(const std::string& track, const char *name, uint64_t issued, double time, uint32_t depth = 0, double delay = 0);
+
+			void			setThreadName(const std::string& name);
+
+			FrameProfile	getLastFrame();
+			size_t			getDroppedCount();
+			bool			isCapturing() const;
+
+			static uint64_t	now();
+
+		private:
+			// A closed zone, recorded when it ends : children come before their parent
+			struct Event {
+				const char *	name;
+				uint64_t		start;
+				uint64_t		end;
+				uint32_t		depth;
+			};
+
+			// The zones of one thread, read by the exports under its mutex
+			struct ThreadBuffer {
+				std::mutex			mutex;
+				std::vector<Event>	events;
+				std::string			name;
+				uint32_t			id;
+				uint32_t			depth = 0;
+				size_t				frameCursor = 0;	// First event of the current frame
+				size_t				dropped = 0;
+				bool				gpu = false;		// A GPU track, filled by recordGPU()
+			};
+
+			std::mutex									buffersMutex;
+			std::vector<std::shared_ptr<ThreadBuffer>>	buffers;
+			std::atomic<bool>							capturing{false};	// Keep the zones read by frame(), for the trace
+
+			std::mutex		frameMutex;
+			FrameProfile	lastFrame = {};
+			uint64_t		frameStart;
+			uint64_t		frameIndex = 0;
+
+			// Timebase reference, to convert ticks to microseconds
+			uint64_t								startTicks;
+			std::chrono::steady_clock::time_point	startTime;
+
+			Profiler();
+			~Profiler() = default;
+
+			ThreadBuffer	&threadBuffer();
+			ThreadBuffer	&registerBuffer(const std::string& name, bool gpu);
+			double			ticksPerMicrosecond();
+
+			static void		buildTree(std::vector<Event> &events, uint32_t base, double toMilliseconds, std::vector<ProfileNode> &zones);
+	};
+
+	/**
+	 * @brief A zone opened until the end of the scope, see GE_PROFILE_SCOPE().
+	 */
+	class ProfileZone {
+		public:
+			explicit ProfileZone(const char *name);
+			~ProfileZone();
+
+			ProfileZone(const ProfileZone&) = delete;
+			ProfileZone& operator=(const ProfileZone&) = delete;
+
+		private:
+			Profiler::ThreadBuffer	&buffer;
+			const char *			name;
+			uint64_t				start;
+	};
+
+	/// Read the timebase, in ticks
+	inline uint64_t Profiler::now() {
+		#ifdef GE_PROFILE_RDTSC
+			return __rdtsc();
+		#else
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		#endif
+	}
+
+	inline ProfileZone::ProfileZone(const char *name) : buffer(Profiler::getInstance().threadBuffer()), name(name), start(Profiler::now()) {
+		buffer.depth++;
+	}
+
+	inline ProfileZone::~ProfileZone() {
+		const uint64_t	end = Profiler::now();
+		std::lock_guard<std::mutex> lock(buffer.mutex);
+
+		buffer.depth--;
+		if (buffer.events.size() < Profiler::BUFFER_CAPACITY)
+			buffer.events.push_back({name, start, end, buffer.depth});
+		else
+			buffer.dropped++;
+	}
+} // namespace GE::Core
@@ -0,0 +1,64 @@
+#include "FakeGL.hpp"
+
+/// Includes
+# include "OpenGL/StateCacheGL.hpp"
+
+/// System includes
+# include <cstdint>
+# include <unordered_map>
+# include <vector>
+
+namespace GE::Tests::FakeGL {
+
+	bool	signalFences = true;
+	bool	queriesAvailable = true;
+
+	static std::unordered_map<GLuint, std::vector<uint8_t>>	buffers;
+	static std::unordered_map<GLenum, GLuint>				bound;
+	static GLuint											nextBuffer = 1;
+	static uintptr_t										nextFence = 1;
+	static GLuint											nextQuery = 1;
+
+	void	install() {
+		glad_glGenBuffers = [](GLsizei count, GLuint *ids) {
+			for (GLsizei i = 0; i < count; i++)
+				buffers[ids[i] = nextBuffer++];
+		};
+		glad_glDeleteBuffers = [](GLsizei count, const GLuint *ids) {
+			for (GLsizei i = 0; i < count; i++)
+				buffers.erase(ids[i]);
+		};
+		glad_glBindBuffer = [](GLenum target, GLuint id) { bound[target] = id; };
+		glad_glBindBufferBase = [](GLenum, GLuint, GLuint) {};
+		glad_glBindBufferRange = [](GLenum, GLuint, GLuint, GLintptr, GLsizeiptr) {};
+		glad_glBufferStorage = [](GLenum target, GLsizeiptr size, const void *, GLbitfield) {
+			buffers[bound[target]].assign(size, 0);
+		};
+		glad_glMapBufferRange = [](GLenum target, GLintptr offset, GLsizeiptr, GLbitfield) -> void * {
+			return buffers[bound[target]].data() + offset;
+		};
+		glad_glUnmapBuffer = [](GLenum) -> GLboolean { return GL_TRUE; };
+		glad_glGetIntegerv = [](GLenum, GLint *value) { *value = 0; };
+
+		glad_glFenceSync = [](GLenum, GLbitfield) { return (GLsync)nextFence++; };
+		glad_glDeleteSync = [](GLsync) {};
+		glad_glClientWaitSync = [](GLsync, GLbitfield, GLuint64) -> GLenum {
+			return signalFences ? GL_ALREADY_SIGNALED : GL_TIMEOUT_EXPIRED;
+		};
+
+		glad_glGenQueries = [](GLsizei count, GLuint *ids) {
+			for (GLsizei i = 0; i < count; i++)
+				ids[i] = nextQuery++;
+		};
+		glad_glDeleteQueries = [](GLsizei, const GLuint *) {};
+		glad_glBeginQuery = [](GLenum, GLuint) {};
+		glad_glEndQuery = [](GLenum) {};
+		glad_glGetQueryObjectuiv = [](GLuint, GLenum, GLuint *value) { *value = queriesAvailable ? GL_TRUE : GL_FALSE; };
+		glad_glGetQueryObjectui64v = [](GLuint, GLenum, GLuint64 *value) { *value = QUERY_NANOSECONDS; };
+
+		signalFences = true;
+		queriesAvailable = true;
+		OpenGL::StateCacheGL::getInstance().invalidate();
+	}
+
+} // namespace GE::Tests::FakeGL
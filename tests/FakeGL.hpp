@@ -0,0 +1,19 @@
+#pragma once
+
+/// Dependencies
+# include <glad/glad.h>
+
+namespace GE::Tests::FakeGL {
+
+	/// @brief Points the glad entry points used by the buffer and timer classes to a fake driver, so they run without a context.
+	/// Buffers are plain memory, mapping returns it, and fences are signaled as told by signalFences.
+	/// Timer queries measure QUERY_NANOSECONDS each, available as told by queriesAvailable.
+	/// @note Also invalidates the StateCacheGL, which may hold the ids of a previous test
+	void	install();
+
+	extern bool	signalFences;		// glClientWaitSync() reports GL_ALREADY_SIGNALED if true, GL_TIMEOUT_EXPIRED otherwise
+	extern bool	queriesAvailable;	// GL_QUERY_RESULT_AVAILABLE of every query
+
+	constexpr GLuint64	QUERY_NANOSECONDS = 1000000;
+
+} // namespace GE::Tests::FakeGL
@@ -0,0 +1,124 @@
+#include "Tests.hpp"
+
+/// Includes
+# include "Utils/FractalNoise.hpp"
+# include "Utils/NoiseGenerator.hpp"
+# include "Utils/ThreadPool.hpp"
+
+/// System includes
+# include <cmath>
+# include <cstdlib>
+# include <cstring>
+# include <future>
+# include <vector>
+
+using GE::Utils::FractalInfo;
+using GE::Utils::FractalNoise;
+using GE::Utils::NoiseGenerator;
+using GE::Utils::ThreadPool;
+
+// Fill a buffer with every kind of sample, for the determinism checks
+static std::vector<float>	sampleAll(const NoiseGenerator &noise) {
+	const FractalNoise	ridged(noise, FractalInfo{5, 1.0f / 64.0f}, FractalNoise::Type::RIDGED, FractalNoise::Basis::SIMPLEX);
+	const FractalNoise	terrain(noise, FractalInfo{6, 1.0f / 256.0f});
+	const size_t		side = 64;
+
+	std::vector<float>	out(side * side * 3);
+	float *				grid = out.data();
+	float *				points = grid + side * side;
+	float *				fractal = points + side * side;
+
+	noise.perlin2DGrid(grid, {-40.5f, 12.25f}, {0.37f, 0.37f}, glm::uvec2(side));
+	for (size_t y = 0; y < side; y++)
+		for (size_t x = 0; x < side; x++) {
+			const glm::vec3	v(x * 0.31f, y * 0.27f, (x + y) * 0.11f);
+
+			points[y * side + x] = noise.perlin3D(v) + noise.simplex2D({v.x, v.y}) + noise.simplex3D(v) + noise.simplex4D(glm::vec4(v, 1.5f));
+			fractal[y * side + x] = ridged.warped3D(v * 8.0f);
+		}
+	terrain.sample2DGrid(fractal, {1024.0f, -512.0f}, {1.0f, 1.0f}, glm::uvec2(side / 2), side);
+	return out;
+}
+
+// Worlds generated before the seeding moved into the instance : srand(seed) then 1 + rand() keyed the 2D lattice
+GE_TEST(noiseLegacySeeds) {
+	const struct {
+		uint64_t	seed;
+		glm::vec2	v;
+		float		value;
+	}	samples2D[] = {
+		{0x0ull, {0.5f, 0.5f}, -0.127401441f},
+		{0x1ull, {3.25f, 17.75f}, -0.284662902f},
+		{0x2aull, {12.25f, 7.75f}, 0.263507128f},
+		{0x2aull, {137.300003f, 53.5999985f}, 0.045080632f},
+		{0x539ull, {1000.09998f, 2000.69995f}, -0.114370406f},
+		{0x1deadbeefull, {3.5999999f, 9.19999981f}, -0.0431454256f}
+	};
+	const struct {
+		uint64_t	seed;
+		glm::vec3	v;
+		float		value;
+	}	samples3D[] = {
+		{0x2aull, {1.29999995f, 2.70000005f, 3.0999999f}, 0.00976144243f},
+		{0x7ull, {100.5f, 64.25f, 12.75f}, 0.178505778f}
+	};
+
+	for (const auto &sample : samples2D)
+		GE_CHECK(std::abs(NoiseGenerator(sample.seed).perlin2D(sample.v) - sample.value) < 1e-6f);
+	for (const auto &sample : samples3D) {
+		const NoiseGenerator	noise(sample.seed, NoiseGenerator::Perlin3DMode::LEGACY_COMPOSITE);
+		GE_CHECK(std::abs(noise.perlin3D(sample.v) - sample.value) < 1e-6f);
+	}
+}
+
+// Seeding must not consume nor reset the libc rand() sequence
+GE_TEST(noiseSeedLeavesRandUntouched) {
+	std::srand(1234);
+	const int	expected[2] = {std::rand(), std::rand()};
+
+	std::srand(1234);
+	NoiseGenerator	noise(42);
+	noise.setSeed(7);
+	GE_CHECK(std::rand() == expected[0]);
+	GE_CHECK(std::rand() == expected[1]);
+}
+
+// One generator per seed, each on its own thread, against the same seeds run one after the other
+GE_TEST(noiseDeterministicPerThread) {
+	const size_t	seedCount = 8;
+
+	std::vector<std::vector<float>>	reference;
+	for (size_t seed = 0; seed < seedCount; seed++)
+		reference.push_back(sampleAll(NoiseGenerator(seed * 7919)));
+
+	ThreadPool	pool(seedCount);
+	std::vector<std::future<std::vector<float>>>	results;
+	for (size_t seed = 0; seed < seedCount; seed++)
+		results.push_back(pool.submit([seed]() { return sampleAll(NoiseGenerator(seed * 7919)); }));
+
+	for (size_t seed = 0; seed < seedCount; seed++) {
+		const std::vector<float>	result = results[seed].get();
+
+		GE_CHECK(result.size() == reference[seed].size());
+		GE_CHECK(!std::memcmp(result.data(), reference[seed].data(), result.size() * sizeof(float)));
+	}
+}
+
+// A single generator sampled from several threads at once
+GE_TEST(noiseDeterministicShared) {
+	const NoiseGenerator		noise(0xC0FFEEull);
+	const std::vector<float>	reference = sampleAll(noise);
+	const size_t				threadCount = 8;
+
+	ThreadPool	pool(threadCount);
+	std::vector<std::future<std::vector<float>>>	results;
+	for (size_t i = 0; i < threadCount; i++)
+		results.push_back(pool.submit([&noise]() { return sampleAll(noise); }));
+
+	for (std::future<std::vector<float>> &result : results) {
+		const std::vector<float>	samples = result.get();
+
+		GE_CHECK(samples.size() == reference.size());
+		GE_CHECK(!std::memcmp(samples.data(), reference.data(), samples.size() * sizeof(float)));
+	}
+}
@@ -0,0 +1,86 @@
+#include "Tests.hpp"
+
+/// Includes
+# include "Profiler.hpp"
+# include "Utils/ThreadPool.hpp"
+
+/// System includes
+# include <cstdio>
+# include <fstream>
+# include <sstream>
+# include <string>
+# include <thread>
+
+using GE::Core::FrameProfile;
+using GE::Core::ProfileZone;
+using GE::Core::Profiler;
+using GE::Utils::ThreadPool;
+
+// Number of zones of that name in a Chrome trace written by exportChromeTrace()
+static size_t	traceCount(const std::string &filename, const std::string &name) {
+	std::ifstream		file(filename);
+	std::stringstream	content;
+	const std::string	key = "{\"name\":\"" + name + "\"";
+	size_t				count = 0;
+
+	content << file.rdbuf();
+	const std::string	trace = content.str();
+	for (size_t at = trace.find(key); at != std::string::npos; at = trace.find(key, at + 1))
+		count++;
+	return count;
+}
+
+// More zones than a buffer holds, here and on a worker, over many frames : frame() discards them and the last frame keeps its breakdown
+GE_TEST(profilerBoundedHistory) {
+	Profiler	&profiler = Profiler::getInstance();
+	ThreadPool	worker(1);
+	const int	zonesPerFrame = 1 << 12;
+	const int	frames = (int)(Profiler::BUFFER_CAPACITY / zonesPerFrame) + 16;
+
+	profiler.clear();
+	for (int frame = 0; frame < frames; frame++) {
+		worker.submit([]() {
+			for (int i = 0; i < zonesPerFrame; i++)
+				ProfileZone	zone("worker");
+		}).wait();
+		for (int i = 0; i < zonesPerFrame; i++)
+			ProfileZone	zone("zone");
+		profiler.frame();
+	}
+
+	const FrameProfile	last = profiler.getLastFrame();
+	GE_CHECK(profiler.getDroppedCount() == 0);
+	GE_CHECK(last.zones.size() == 1);
+	GE_CHECK(last.zones[0].calls == (uint32_t)zonesPerFrame);
+}
+
+// Zones of every thread are kept from startCapture(), until the first frame() after stopCapture()
+GE_TEST(profilerCapture) {
+	Profiler			&profiler = Profiler::getInstance();
+	const std::string	filename = "ProfilerTests.json";
+
+	profiler.clear();
+	{ ProfileZone zone("before"); }
+	profiler.frame();
+
+	profiler.startCapture();
+	GE_CHECK(profiler.isCapturing());
+	for (int frame = 0; frame < 3; frame++) {
+		std::thread([]() { ProfileZone zone("captured worker"); }).join();
+		{ ProfileZone zone("captured"); }
+		profiler.frame();
+	}
+	profiler.exportChromeTrace(filename);
+	GE_CHECK(traceCount(filename, "before") == 0);
+	GE_CHECK(traceCount(filename, "captured") == 3);
+	GE_CHECK(traceCount(filename, "captured worker") == 3);
+	GE_CHECK(traceCount(filename, "Frame") == 4);	// With the marker of the frame before the capture
+
+	profiler.stopCapture();
+	GE_CHECK(!profiler.isCapturing());
+	profiler.frame();
+	profiler.exportChromeTrace(filename);
+	GE_CHECK(traceCount(filename, "captured") == 0);
+	GE_CHECK(traceCount(filename, "captured worker") == 0);
+	std::remove(filename.c_str());
+}
@@ -0,0 +1,52 @@
+#include "Tests.hpp"
+
+/// Includes
+# include "FakeGL.hpp"
+# include "OpenGL/StreamBufferGL.hpp"
+
+/// System includes
+# include <stdexcept>
+
+using GE::OpenGL::StreamBufferGL;
+using GE::OpenGL::StreamRange;
+namespace FakeGL = GE::Tests::FakeGL;
+
+// Once the GPU released every frame, the ring restarts at 0 : an allocation larger than the space left after the
+// last head, but not than the ring, must succeed
+GE_TEST(streamEmptyRingRestarts) {
+	FakeGL::install();
+	StreamBufferGL	stream(GL_ARRAY_BUFFER, 256, 4);
+
+	GE_CHECK(stream.getCapacity() == 1024);
+
+	// Released by endFrame() itself
+	stream.allocate(600);
+	stream.endFrame();
+	GE_CHECK(stream.getStats().framesInFlight == 0);
+
+	StreamRange	range = stream.allocate(1000);
+	GE_CHECK(range.offset == 0);
+	GE_CHECK(range.data == stream.getBuffer().getData());
+	stream.endFrame();
+
+	// Released while allocate() waits for the fence
+	FakeGL::signalFences = false;
+	stream.allocate(600);
+	stream.endFrame();
+	GE_CHECK(stream.getStats().framesInFlight == 1);
+
+	FakeGL::signalFences = true;
+	range = stream.allocate(1024);
+	GE_CHECK(range.offset == 0);
+	GE_CHECK(stream.getStats().framesInFlight == 0);
+}
+
+// Frames still in flight keep their bytes : the current frame alone cannot exceed the ring
+GE_TEST(streamFrameOverflow) {
+	FakeGL::install();
+	StreamBufferGL	stream(GL_ARRAY_BUFFER, 256, 4);
+
+	stream.allocate(600);
+	GE_CHECK_THROWS(stream.allocate(600), std::runtime_error);
+	GE_CHECK_THROWS(stream.allocate(1025), std::out_of_range);
+}
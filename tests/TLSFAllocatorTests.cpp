@@ -0,0 +1,170 @@
+#include "Tests.hpp"
+
+/// Includes
+# include "Utils/TLSFAllocator.hpp"
+
+/// System includes
+# include <random>
+# include <stdexcept>
+# include <unordered_map>
+# include <vector>
+
+using GE::Utils::TLSFAllocator;
+using GE::Utils::TLSFStats;
+
+// Random allocations and frees, checking every block against a map of the units in use
+GE_TEST(tlsfRandom) {
+	const uint32_t	capacity = 1 << 20;
+	TLSFAllocator	allocator(capacity);
+	std::mt19937	random(1234);
+
+	std::vector<uint8_t>					used(capacity, 0);
+	std::unordered_map<uint32_t, uint32_t>	blocks;	// Block id -> size
+	uint32_t								usedUnits = 0;
+
+	for (int i = 0; i < 20000; i++) {
+		if (blocks.empty() || random() % 100 < 55) {
+			// Mostly small blocks, a few large ones
+			const uint32_t	size = (random() % 8) ? 1 + random() % 256 : 1 + random() % 65536;
+			const uint32_t	block = allocator.allocate(size);
+
+			if (block == TLSFAllocator::INVALID) {
+				GE_CHECK(size > allocator.getStats().largestFree);
+				continue;
+			}
+
+			const uint32_t	offset = allocator.getOffset(block);
+			GE_CHECK(allocator.getSize(block) == size);
+			GE_CHECK(offset + size <= capacity);
+			GE_CHECK(!blocks.count(block));
+			for (uint32_t unit = offset; unit < offset + size; unit++) {
+				GE_CHECK(!used[unit]);
+				used[unit] = 1;
+			}
+			blocks[block] = size;
+			usedUnits += size;
+		}
+		else {
+			auto	it = blocks.begin();
+			std::advance(it, random() % blocks.size());
+
+			const uint32_t	offset = allocator.getOffset(it->first);
+			for (uint32_t unit = offset; unit < offset + it->second; unit++)
+				used[unit] = 0;
+			usedUnits -= it->second;
+			allocator.free(it->first);
+			blocks.erase(it);
+		}
+
+		if (i % 1000 == 0) {
+			const TLSFStats	stats = allocator.getStats();
+
+			GE_CHECK(stats.used == usedUnits);
+			GE_CHECK(stats.allocations == blocks.size());
+			GE_CHECK(stats.largestFree <= capacity - usedUnits);
+		}
+	}
+
+	for (const auto &[block, size] : blocks)
+		allocator.free(block);
+
+	const TLSFStats	stats = allocator.getStats();
+	GE_CHECK(stats.used == 0);
+	GE_CHECK(stats.freeBlocks == 1);
+	GE_CHECK(stats.largestFree == capacity);
+}
+
+// A free block of exactly the requested size is found, even when rounding up to the next size class misses it
+GE_TEST(tlsfExactFit) {
+	TLSFAllocator	whole(1000003);
+	const uint32_t	all = whole.allocate(1000003);
+
+	GE_CHECK(all != TLSFAllocator::INVALID);
+	GE_CHECK(whole.getOffset(all) == 0);
+	GE_CHECK(whole.allocate(1) == TLSFAllocator::INVALID);
+
+	TLSFAllocator	allocator(1000);
+	const uint32_t	a = allocator.allocate(300);
+	const uint32_t	b = allocator.allocate(133);
+	const uint32_t	c = allocator.allocate(567);
+
+	GE_CHECK(a != TLSFAllocator::INVALID && b != TLSFAllocator::INVALID && c != TLSFAllocator::INVALID);
+	GE_CHECK(allocator.getStats().used == 1000);
+
+	allocator.free(b);
+	GE_CHECK(allocator.allocate(134) == TLSFAllocator::INVALID);
+
+	const uint32_t	fit = allocator.allocate(133);
+	GE_CHECK(fit != TLSFAllocator::INVALID);
+	GE_CHECK(allocator.getOffset(fit) == 300);
+	GE_CHECK(allocator.getStats().freeBlocks == 0);
+}
+
+// Freed neighbors merge, in any order, back into the single block of the whole range
+GE_TEST(tlsfCoalescing) {
+	TLSFAllocator	allocator(400);
+	uint32_t		blocks[4];
+
+	for (uint32_t &block : blocks)
+		block = allocator.allocate(100);
+	GE_CHECK(allocator.getStats().freeBlocks == 0);
+
+	for (int i : {1, 3, 0, 2})
+		allocator.free(blocks[i]);
+
+	const TLSFStats	stats = allocator.getStats();
+	GE_CHECK(stats.freeBlocks == 1);
+	GE_CHECK(stats.largestFree == 400);
+	GE_CHECK(stats.used == 0);
+	GE_CHECK(stats.allocations == 0);
+
+	const uint32_t	whole = allocator.allocate(400);
+	GE_CHECK(whole != TLSFAllocator::INVALID);
+	GE_CHECK(allocator.getOffset(whole) == 0);
+}
+
+// Ids never returned by allocate(), or already freed, are rejected
+GE_TEST(tlsfInvalidFree) {
+	TLSFAllocator	allocator(1024);
+	const uint32_t	a = allocator.allocate(64);
+	const uint32_t	b = allocator.allocate(64);
+
+	GE_CHECK_THROWS(allocator.free(TLSFAllocator::INVALID), std::invalid_argument);
+	GE_CHECK_THROWS(allocator.free(12345), std::invalid_argument);
+	GE_CHECK_THROWS(allocator.allocate(0), std::invalid_argument);
+
+	allocator.free(a);
+	GE_CHECK_THROWS(allocator.free(a), std::invalid_argument);
+	GE_CHECK_THROWS(allocator.getOffset(a), std::invalid_argument);
+
+	// b merges into the free space around it, its id goes back to the unused pool
+	allocator.free(b);
+	GE_CHECK_THROWS(allocator.free(b), std::invalid_argument);
+	GE_CHECK(allocator.getStats().freeBlocks == 1);
+}
+
+// fragmentation = 1 - largestFree / free space
+GE_TEST(tlsfFragmentation) {
+	TLSFAllocator	allocator(400);
+	uint32_t		blocks[4];
+
+	GE_CHECK(allocator.getStats().fragmentation == 0.0f);
+
+	for (uint32_t &block : blocks)
+		block = allocator.allocate(100);
+	GE_CHECK(allocator.getStats().fragmentation == 0.0f);	// No free space at all
+
+	allocator.free(blocks[0]);
+	allocator.free(blocks[2]);
+
+	TLSFStats	stats = allocator.getStats();
+	GE_CHECK(stats.freeBlocks == 2);
+	GE_CHECK(stats.largestFree == 100);
+	GE_CHECK(stats.fragmentation == 0.5f);
+
+	allocator.free(blocks[1]);
+	stats = allocator.getStats();
+	GE_CHECK(stats.freeBlocks == 1);
+	GE_CHECK(stats.largestFree == 300);
+	GE_CHECK(stats.fragmentation == 0.0f);
+}
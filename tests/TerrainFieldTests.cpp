@@ -0,0 +1,67 @@
+#include "Tests.hpp"
+
+/// Includes
+# include "Utils/TerrainField.hpp"
+
+/// System includes
+# include <atomic>
+# include <stdexcept>
+
+using GE::Utils::NoiseGenerator;
+using GE::Utils::TerrainField;
+using GE::Utils::TerrainFieldInfo;
+using GE::Utils::TerrainTile;
+using GE::Utils::TerrainTileKey;
+
+// A generator that throws on its first call only
+static TerrainFieldInfo	failingOnce(std::atomic<int> &calls) {
+	TerrainFieldInfo	info;
+
+	info.tileSize = {8, 8, 8};
+	info.threadCount = 1;
+	info.heightmapGenerator = [&calls](const NoiseGenerator &, TerrainTile &tile) {
+		if (calls++ == 0)
+			throw std::runtime_error("first generation fails");
+		tile.values.assign(tile.values.size(), 1.0f);
+	};
+	return info;
+}
+
+// A request after a failed generation generates the tile again, instead of returning the failed future
+GE_TEST(terrainFailedTileRequestedAgain) {
+	std::atomic<int>	calls{0};
+	TerrainField		field(failingOnce(calls));
+
+	GE_CHECK_THROWS(field.requestHeightmap(1, {2, 3}).get(), std::runtime_error);
+
+	const auto	tile = field.requestHeightmap(1, {2, 3}).get();
+	GE_CHECK(tile != nullptr);
+	GE_CHECK(tile->values.size() == 8 * 8 && tile->values[0] == 1.0f);
+	GE_CHECK(calls == 2);
+
+	const auto	stats = field.getStats();
+	GE_CHECK(stats.misses == 2);
+	GE_CHECK(stats.hits == 0);
+	GE_CHECK(stats.cachedTiles == 1);
+	GE_CHECK(stats.memoryUsed == 8 * 8 * sizeof(float) + sizeof(TerrainTile));
+
+	// Once generated, the tile is a hit
+	GE_CHECK(field.requestHeightmap(1, {2, 3}).get() == tile);
+	GE_CHECK(calls == 2);
+}
+
+// tryGet() drops a failed tile, the next request generates it again
+GE_TEST(terrainFailedTileTryGet) {
+	std::atomic<int>		calls{0};
+	TerrainField			field(failingOnce(calls));
+	const TerrainTileKey	key = {TerrainTileKey::Kind::HEIGHTMAP, 1, {2, 3, 0}};
+
+	field.requestHeightmap(1, {2, 3}).wait();
+	GE_CHECK(field.tryGet(key) == nullptr);
+	GE_CHECK(field.getStats().cachedTiles == 0);
+	GE_CHECK(field.getStats().memoryUsed == 0);
+
+	field.requestHeightmap(1, {2, 3}).wait();
+	GE_CHECK(field.tryGet(key) != nullptr);
+	GE_CHECK(calls == 2);
+}
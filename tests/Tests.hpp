@@ -0,0 +1,43 @@
+#pragma once
+
+/// System includes
+# include <string>
+# include <vector>
+
+/// Declare a test case, run by GameEngineTests in the order of declaration within a file
+# define GE_TEST(name) \
+	static void	name(); \
+	static const ::GE::Tests::Registrar	name##Registrar(#name, name); \
+	static void	name()
+
+/// Fail the test case if the condition is false
+# define GE_CHECK(condition) \
+	::GE::Tests::check((condition), #condition, __FILE__, __LINE__)
+
+/// Fail the test case unless the statement throws the exception type
+# define GE_CHECK_THROWS(statement, exception) \
+	do { \
+		bool	thrown = false; \
+		try { statement; } \
+		catch (const exception &) { thrown = true; } \
+		::GE::Tests::check(thrown, #statement " throws " #exception, __FILE__, __LINE__); \
+	} while (0)
+
+namespace GE::Tests {
+
+	/// @brief A test case, see GE_TEST()
+	struct Case {
+		const char *	name;
+		void			(*run)();
+	};
+
+	/// @brief Adds a case to cases() during static initialization
+	struct Registrar {
+		Registrar(const char *name, void (*run)());
+	};
+
+	std::vector<Case> &	cases();
+
+	void	check(bool passed, const char *expression, const char *file, int line);
+
+} // namespace GE::Tests
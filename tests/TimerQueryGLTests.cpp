@@ -0,0 +1,40 @@
+#include "Tests.hpp"
+
+/// Includes
+# include "FakeGL.hpp"
+# include "OpenGL/TimerQueryGL.hpp"
+
+using GE::OpenGL::TimerQueryGL;
+namespace FakeGL = GE::Tests::FakeGL;
+
+// A frame whose results are not available yet is skipped : it reports no timings, not those of the frame read before
+GE_TEST(timerSkippedFrameClearsTimings) {
+	FakeGL::install();
+	TimerQueryGL	&timer = TimerQueryGL::getInstance();
+	const size_t	skipped = timer.getSkippedCount();
+
+	timer.release();
+	for (size_t frame = 0; frame <= TimerQueryGL::LATENCY; frame++) {
+		timer.begin("frame");
+		timer.begin("nested");
+		timer.end();
+		timer.end();
+		timer.endFrame();
+	}
+
+	// Read back LATENCY frames after the first one : the outer region is its two segments and the nested region
+	GE_CHECK(timer.getTimings().size() == 2);
+	GE_CHECK(timer.getTimings()[1].depth == 1);
+	GE_CHECK(timer.getTotal() == 3 * FakeGL::QUERY_NANOSECONDS / 1e6);
+	GE_CHECK(timer.getSkippedCount() == skipped);
+
+	FakeGL::queriesAvailable = false;
+	timer.begin("frame");
+	timer.end();
+	timer.endFrame();
+
+	GE_CHECK(timer.getSkippedCount() == skipped + 1);
+	GE_CHECK(timer.getTimings().empty());
+	GE_CHECK(timer.getTotal() == 0);
+	timer.release();
+}
@@ -0,0 +1,53 @@
+#include "Tests.hpp"
+
+/// System includes
+# include <cstdio>
+# include <cstring>
+# include <stdexcept>
+
+namespace GE::Tests {
+
+	Registrar::Registrar(const char *name, void (*run)()) {
+		cases().push_back({name, run});
+	}
+
+	/// @brief Return the registered cases
+	std::vector<Case> &	cases() {
+		static std::vector<Case>	registered;
+		return registered;
+	}
+
+	/// @brief Stop the case if a check failed, see GE_CHECK()
+	/// @throw std::runtime_error with the expression and its location
+	void	check(bool passed, const char *expression, const char *file, int line) {
+		if (!passed)
+			throw std::runtime_error(std::string(file) + ":" + std::to_string(line) + " : " + expression);
+	}
+
+} // namespace GE::Tests
+
+/// Usage : GameEngineTests [case...], runs the cases whose name contains one of the arguments, all of them by default
+int	main(int argc, char **argv) {
+	int	failed = 0;
+	int	run = 0;
+
+	for (const GE::Tests::Case &test : GE::Tests::cases()) {
+		bool	selected = argc < 2;
+		for (int i = 1; i < argc; i++)
+			selected |= std::strstr(test.name, argv[i]) != nullptr;
+		if (!selected)
+			continue;
+
+		run++;
+		try {
+			test.run();
+			std::printf("  ok      %s\n", test.name);
+		}
+		catch (const std::exception &e) {
+			std::printf("  FAILED  %s : %s\n", test.name, e.what());
+			failed++;
+		}
+	}
+	std::printf("%d / %d passed\n", run - failed, run);
+	return failed ? 1 : 0;
+}